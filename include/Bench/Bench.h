@@ -0,0 +1,61 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Benchmarks and self-checks, built into the game executable when DUCKFISHING_BENCH is defined
+// (C/C++ > Preprocessor > Preprocessor Definitions). That build starts in Bench's main instead of the game:
+//
+//   duckfishing.exe                 every suite
+//   duckfishing.exe grid-churn      only the suites named
+//
+// A suite first checks that what it measures gives the right answer, then times it.
+// The exit code is the number of failed checks. Numbers we measured are kept in BENCHMARKS.md.
+namespace Bench {
+    using Clock = std::chrono::steady_clock;
+
+    inline double SecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // seconds f takes, the best of repeats runs
+    template <typename F>
+    double Time(F&& f, int repeats = 3) {
+        double best = 0;
+        for (int i = 0; i < repeats; i++) {
+            Clock::time_point start = Clock::now();
+            f();
+            double seconds = SecondsSince(start);
+            if (i == 0 || seconds < best) {
+                best = seconds;
+            }
+        }
+        return best;
+    }
+
+    // one line of results: "suite  what  value unit"
+    void Report(const std::string& what, double value, const std::string& unit);
+
+    // counted, the run fails if any of them does
+    bool Check(bool isOk, const char* what, const char* file, int line);
+
+    // resident set size of the process, 0 where we can't tell
+    size_t GetResidentBytes();
+
+    // keeps the optimizer from dropping a result nobody reads
+    void Consume(uint64_t value);
+
+    // the suites, one per file in src/Bench
+    void RunEventBus();
+    void RunUpdate();
+    void RunSpawn();
+    void RunParallelUpdate();
+    void RunCubeNet();
+    void RunGridChurn();
+    void RunMove();
+    void RunRaycast();
+    void RunNetCompiler();
+}
+
+#define BENCH_CHECK(condition) Bench::Check((condition), #condition, __FILE__, __LINE__)
@@ -0,0 +1,327 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../Utils/BitOps.h"
+
+// A height x width grid of T that only stores the parts that aren't empty.
+//
+// Cells are addressed by a 32 bit index (y * width + x), like everywhere else.
+// Storage is split into chunks of CHUNK_CELLS consecutive cells. A chunk is allocated by the first write of a non empty value
+// and released again when its last non empty cell is cleared. What stays is one pointer per chunk,
+// so a world of millions of cells costs about its occupied chunks, whatever its size.
+// Chunks follow the cell index rather than square tiles, so that a lookup is a shift and a mask, no division by the width.
+//
+// Reads of an unallocated chunk return the empty value. Out of bounds reads do too, writes are dropped.
+//
+// Every chunk also keeps a bit per cell, set while the cell is not empty. Occupancy questions
+// (is it taken, where is the next free cell, how many are taken in a range) read those 64 cells at a time
+// and skip missing chunks (all empty) and full ones (by their count) without looking inside.
+template <typename T>
+class ChunkedGrid {
+public:
+    static constexpr uint32_t CHUNK_SHIFT = 8;
+    static constexpr uint32_t CHUNK_CELLS = 1u << CHUNK_SHIFT;
+    static constexpr uint32_t CHUNK_MASK = CHUNK_CELLS - 1;
+    static constexpr uint32_t CHUNK_WORDS = CHUNK_CELLS / 64;
+
+    // FindFirstEmpty when there is none
+    static constexpr uint32_t NO_CELL = UINT32_MAX;
+
+    ChunkedGrid() = default;
+
+    ChunkedGrid(uint32_t height, uint32_t width, T empty = T()) {
+        Reset(height, width, empty);
+    }
+
+    ChunkedGrid(const ChunkedGrid& other) {
+        *this = other;
+    }
+
+    ChunkedGrid& operator=(const ChunkedGrid& other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        height_ = other.height_;
+        width_ = other.width_;
+        cellCount_ = other.cellCount_;
+        empty_ = other.empty_;
+        occupied_ = other.occupied_;
+        allocated_ = other.allocated_;
+
+        chunks_.clear();
+        chunks_.resize(other.chunks_.size());
+        for (size_t i = 0; i < chunks_.size(); i++) {
+            if (other.chunks_[i]) {
+                chunks_[i] = std::make_unique<Chunk>(*other.chunks_[i]);
+            }
+        }
+        return *this;
+    }
+
+    ChunkedGrid(ChunkedGrid&&) noexcept = default;
+    ChunkedGrid& operator=(ChunkedGrid&&) noexcept = default;
+
+    // every cell empty, every chunk released
+    void Reset(uint32_t height, uint32_t width, T empty = T()) {
+        height_ = height;
+        width_ = width;
+        cellCount_ = static_cast<size_t>(height) * width;
+        empty_ = empty;
+        occupied_ = 0;
+        allocated_ = 0;
+
+        chunks_.clear();
+        chunks_.resize((cellCount_ + CHUNK_MASK) >> CHUNK_SHIFT);
+    }
+
+    void Clear() {
+        Reset(height_, width_, empty_);
+    }
+
+    T Get(uint32_t cell) const {
+        if (cell >= cellCount_) {
+            return empty_;
+        }
+
+        const Chunk* chunk = chunks_[cell >> CHUNK_SHIFT].get();
+        return chunk != nullptr ? chunk->cells[cell & CHUNK_MASK] : empty_;
+    }
+
+    T Get(uint32_t y, uint32_t x) const {
+        if (y >= height_ || x >= width_) {
+            return empty_;
+        }
+        return Get(y * width_ + x);
+    }
+
+    void Set(uint32_t y, uint32_t x, T value) {
+        if (y >= height_ || x >= width_) {
+            return;
+        }
+        Set(y * width_ + x, value);
+    }
+
+    void Set(uint32_t cell, T value) {
+        if (cell >= cellCount_) {
+            return;
+        }
+
+        std::unique_ptr<Chunk>& chunk = chunks_[cell >> CHUNK_SHIFT];
+
+        if (chunk == nullptr) {
+            if (value == empty_) {
+                return;
+            }
+
+            chunk = std::make_unique<Chunk>();
+            chunk->cells.fill(empty_);
+            chunk->bits.fill(0);
+            chunk->occupied = 0;
+            allocated_++;
+        }
+
+        uint32_t local = cell & CHUNK_MASK;
+        uint64_t bit = 1ull << (local & 63);
+
+        T& slot = chunk->cells[local];
+        bool wasEmpty = slot == empty_;
+        bool isEmpty = value == empty_;
+        slot = value;
+
+        if (wasEmpty && !isEmpty) {
+            chunk->bits[local >> 6] |= bit;
+            chunk->occupied++;
+            occupied_++;
+        }
+        else if (!wasEmpty && isEmpty) {
+            chunk->bits[local >> 6] &= ~bit;
+            chunk->occupied--;
+            occupied_--;
+
+            if (chunk->occupied == 0) {
+                chunk.reset();
+                allocated_--;
+            }
+        }
+    }
+
+    // f(uint32_t cell, const T& value) for every non empty cell, in cell order
+    template <typename F>
+    void ForEach(F&& f) const {
+        for (size_t i = 0; i < chunks_.size(); i++) {
+            const Chunk* chunk = chunks_[i].get();
+            if (chunk == nullptr) {
+                continue;
+            }
+
+            uint32_t base = static_cast<uint32_t>(i << CHUNK_SHIFT);
+
+            // only the set bits, lowest first
+            for (uint32_t w = 0; w < CHUNK_WORDS; w++) {
+                for (uint64_t word = chunk->bits[w]; word != 0; word &= word - 1) {
+                    uint32_t local = w * 64 + BitOps::CountTrailingZeros(word);
+                    f(base + local, chunk->cells[local]);
+                }
+            }
+        }
+    }
+
+    // not empty. false out of bounds
+    bool IsOccupied(uint32_t cell) const {
+        if (cell >= cellCount_) {
+            return false;
+        }
+
+        const Chunk* chunk = chunks_[cell >> CHUNK_SHIFT].get();
+        uint32_t local = cell & CHUNK_MASK;
+        return chunk != nullptr && (chunk->bits[local >> 6] >> (local & 63)) & 1;
+    }
+
+    // the first empty cell at or after from, NO_CELL if every one of them is taken
+    uint32_t FindFirstEmpty(uint32_t from = 0) const {
+        if (from >= cellCount_) {
+            return NO_CELL;
+        }
+
+        for (size_t i = from >> CHUNK_SHIFT; i < chunks_.size(); i++) {
+            uint32_t base = static_cast<uint32_t>(i << CHUNK_SHIFT);
+            uint32_t start = from > base ? from - base : 0;
+            uint32_t end = ChunkEnd(i);
+
+            const Chunk* chunk = chunks_[i].get();
+            if (chunk == nullptr) {
+                return base + start;
+            }
+            if (chunk->occupied == end) {
+                continue;
+            }
+
+            for (uint32_t w = start >> 6; w < CHUNK_WORDS; w++) {
+                uint64_t freeBits = ~chunk->bits[w] & BitOps::RangeMask(w == (start >> 6) ? start & 63 : 0, 64);
+                if (freeBits == 0) {
+                    continue;
+                }
+
+                // the bits past the end of the last chunk are never set, they look free
+                uint32_t local = w * 64 + BitOps::CountTrailingZeros(freeBits);
+                if (local >= end) {
+                    break;
+                }
+                return base + local;
+            }
+        }
+        return NO_CELL;
+    }
+
+    // cells in [begin, end) that are not empty
+    size_t CountOccupied(uint32_t begin, uint32_t end) const {
+        if (end > cellCount_) {
+            end = static_cast<uint32_t>(cellCount_);
+        }
+        if (begin >= end) {
+            return 0;
+        }
+
+        size_t count = 0;
+
+        for (size_t i = begin >> CHUNK_SHIFT; i <= ((end - 1) >> CHUNK_SHIFT); i++) {
+            const Chunk* chunk = chunks_[i].get();
+            if (chunk == nullptr) {
+                continue;
+            }
+
+            uint32_t base = static_cast<uint32_t>(i << CHUNK_SHIFT);
+            uint32_t localBegin = begin > base ? begin - base : 0;
+            uint32_t localEnd = end - base < CHUNK_CELLS ? end - base : CHUNK_CELLS;
+
+            if (localBegin == 0 && localEnd >= ChunkEnd(i)) {
+                count += chunk->occupied;
+                continue;
+            }
+
+            for (uint32_t w = localBegin >> 6; w * 64 < localEnd; w++) {
+                uint32_t wordBegin = w * 64;
+                uint32_t maskBegin = localBegin > wordBegin ? localBegin - wordBegin : 0;
+                uint32_t maskEnd = localEnd - wordBegin < 64 ? localEnd - wordBegin : 64;
+                count += BitOps::PopCount(chunk->bits[w] & BitOps::RangeMask(maskBegin, maskEnd));
+            }
+        }
+        return count;
+    }
+
+    // cells of the height x width rectangle at (y, x) that are not empty. clipped to the grid, no wrapping
+    size_t CountOccupied(uint32_t y, uint32_t x, uint32_t height, uint32_t width) const {
+        if (y >= height_ || x >= width_) {
+            return 0;
+        }
+
+        uint32_t lastRow = height_ - y < height ? height_ : y + height;
+        uint32_t rowLength = width_ - x < width ? width_ - x : width;
+
+        size_t count = 0;
+        for (uint32_t row = y; row < lastRow; row++) {
+            uint32_t begin = row * width_ + x;
+            count += CountOccupied(begin, begin + rowLength);
+        }
+        return count;
+    }
+
+    uint32_t GetHeight() const {
+        return height_;
+    }
+
+    uint32_t GetWidth() const {
+        return width_;
+    }
+
+    size_t GetCellCount() const {
+        return cellCount_;
+    }
+
+    // cells that are not empty
+    size_t GetOccupiedCount() const {
+        return occupied_;
+    }
+
+    // chunks in memory
+    size_t GetChunkCount() const {
+        return allocated_;
+    }
+
+    size_t GetMemoryUsage() const {
+        return chunks_.size() * sizeof(std::unique_ptr<Chunk>) + allocated_ * sizeof(Chunk);
+    }
+
+    const T& GetEmpty() const {
+        return empty_;
+    }
+
+private:
+    struct Chunk {
+        std::array<T, CHUNK_CELLS> cells;
+        // bit (local & 63) of word (local >> 6): cells[local] is not empty
+        std::array<uint64_t, CHUNK_WORDS> bits;
+        uint32_t occupied;
+    };
+
+    // cells in chunk i, less than CHUNK_CELLS for the last one
+    uint32_t ChunkEnd(size_t i) const {
+        size_t base = i << CHUNK_SHIFT;
+        return cellCount_ - base < CHUNK_CELLS ? static_cast<uint32_t>(cellCount_ - base) : CHUNK_CELLS;
+    }
+
+    uint32_t height_ = 0;
+    uint32_t width_ = 0;
+    size_t cellCount_ = 0;
+    T empty_ = T();
+
+    size_t occupied_ = 0;
+    size_t allocated_ = 0;
+
+    std::vector<std::unique_ptr<Chunk>> chunks_;
+};
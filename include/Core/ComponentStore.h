@@ -0,0 +1,135 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <limits>
+
+#include <glm/glm.hpp>
+
+#include "Transform.h"
+#include "SlotMap.h"
+#include "../Utils/LOG.h"
+
+class GameObject;
+class ChangeJournal;
+
+// Structure of arrays storage for the data every game object has.
+//
+// GameState still owns the GameObjects (they are polymorphic, RidableObject has its grid and managers),
+// but what is touched every tick lives here in dense columns, one row per registered object:
+//   transforms, cached local matrices, mesh & texture ids, parent ids and grid membership.
+//
+// Row i of every column belongs to the same object. Rows are packed, removing an object moves the last row into the hole.
+// So the index of an object may change, the objectID doesn't. 
+// IndexOf(objectID) is an array lookup on the handle's slot index, plus a check that the row still belongs to that generation.
+//
+// A GameObject bound to the store keeps using ptrNodeTransform_ as before, it simply points into the transforms column.
+// The transform is built in that column by Add, a new object doesn't come with one of its own.
+// The store re-points it whenever the column moves (growth or removal).
+class ComponentStore {
+public:
+    std::string GetName() const;
+
+private:
+    void log(LogLevel level, std::string text);
+
+public:
+    using Index = uint32_t;
+    static constexpr Index INVALID_INDEX = std::numeric_limits<Index>::max();
+    static constexpr uint32_t NO_CELL = std::numeric_limits<uint32_t>::max();
+
+    ComponentStore() = default;
+
+    ComponentStore(const ComponentStore&) = delete;
+    ComponentStore& operator=(const ComponentStore&) = delete;
+
+    // Takes over the object's transform, mesh/texture and parent ids.
+    // The owner is not owned, ~GameObject Erases it before the object is gone.
+    Index Add(uint32_t objectID, GameObject* owner);
+
+    // The owner gets a heap transform back, so it stays usable after leaving the store.
+    void Remove(uint32_t objectID);
+
+    // Remove for an owner that is being destroyed: no copy back, its ptrNodeTransform_ is left nullptr.
+    void Erase(uint32_t objectID);
+
+    Index IndexOf(uint32_t objectID) const {
+        uint32_t slot = ObjectHandle::IndexOf(objectID);
+
+        if (slot >= sparse_.size() || sparse_[slot] == INVALID_INDEX || objectIDs[sparse_[slot]] != objectID) {
+            return INVALID_INDEX;
+        }
+        return sparse_[slot];
+    }
+
+    bool Contains(uint32_t objectID) const {
+        return IndexOf(objectID) != INVALID_INDEX;
+    }
+
+    size_t Size() const {
+        return objectIDs.size();
+    }
+
+    void Reserve(size_t capacity);
+
+    // write through from GameObject / RidableObject
+    void SetMeshID(uint32_t objectID, uint32_t meshID);
+    void SetTextureID(uint32_t objectID, uint32_t textureID);
+    void SetParentID(uint32_t objectID, uint32_t parentID);
+
+    // objectID stands on the grid of gridOwnerID at cell
+    void SetGridCell(uint32_t objectID, uint32_t gridOwnerID, uint32_t cell);
+    // only clears when objectID is still registered on that grid
+    void ClearGridCell(uint32_t objectID, uint32_t gridOwnerID);
+
+    // Systems. Each one is a single pass over the columns it needs.
+
+    // GameState's journal. Parent, grid and transform changes that pass through here are recorded in it
+    void SetJournal(ChangeJournal* journal) {
+        journal_ = journal;
+    }
+
+    ChangeJournal* GetJournal() {
+        return journal_;
+    }
+
+    // the transform of objectID was replaced, not just animated
+    void MarkTransformChanged(uint32_t objectID);
+
+    // Systems also come in a [begin, end) row range version, so that the job system can hand out chunks of rows.
+    // Rows of different chunks share nothing, chunks can run on different threads at the same time.
+
+    // the default idle animation, every object spins around axis
+    void Spin(float deltaTime, const glm::vec3& axis);
+    void Spin(const glm::quat& additionalRotation, size_t begin, size_t end);
+
+    // refresh localMatrices from the transforms that changed
+    void UpdateLocalMatrices();
+    void UpdateLocalMatrices(size_t begin, size_t end);
+
+public:
+    // Columns. Read freely, write through the methods above so that the rows stay together.
+    std::vector<uint32_t> objectIDs;
+    std::vector<GameObject*> owners;
+
+    std::vector<Transform> transforms;
+    std::vector<glm::mat4> localMatrices;
+
+    std::vector<uint32_t> meshIDs;
+    std::vector<uint32_t> textureIDs;
+
+    std::vector<uint32_t> parentIDs;
+
+    // grid membership: which grid the object stands on and where (NO_CELL if nowhere)
+    std::vector<uint32_t> gridOwnerIDs;
+    std::vector<uint32_t> gridCells;
+
+private:
+    // slot index of the objectID -> dense index
+    std::vector<Index> sparse_;
+
+    ChangeJournal* journal_ = nullptr;
+
+    void RebindTransform(Index index);
+    void RebindAllTransforms();
+};
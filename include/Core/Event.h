@@ -1,113 +1,181 @@
-#pragma once
-
-#include <functional>
-#include <string> 
-#include <vector>
-#include <SDL.h> 
-#include <iostream>
-#include <unordered_map>
-#include <mutex>
-#include "../Utils/LOG.h"
-#include "InteractionInfo.h"
-#include <map>
-
-class Item;
-class GameObject;
-
-// below Code is defining a proxy named (left) for the (right), 
-// sort of like assigning variables but with classnames I guess  
-using Listener = std::function<void(const std::vector<uint8_t>)>;
-using ItemListener = std::function<void(InteractionInfo*)>; // args are (who, what, where1, where2)
-
-
-enum class Tag {
-    UDP,
-    TCP,
-    USER_INPUT,
-};
-
-class EventDispatcher {
-public:
-    // Public method to get the singleton instance
-    static EventDispatcher& GetInstance();
-
-    void Subscribe(Listener* ptrListener);
-
-    void Subscribe(ItemListener* ptrItemListener);
-
-    void Subscribe(const Tag tag, Listener* ptrListener);
-
-    void Publish(const std::vector<uint8_t> message);
-
-    void Publish(const Tag tag, const std::vector<uint8_t> message);
-
-    void Publish(InteractionInfo* interactionInfo);
-
-    void Unsubscribe(Listener* ptrListener);
-
-    void Unsubscribe(const Tag tag, Listener* ptrListener);
-
-    void Unsubscribe(ItemListener* ptrItemListener);
-
-private:
-    // Private constructor to prevent direct instantiation
-    EventDispatcher() = default;
-
-    // Delete copy constructor and assignment operator
-    EventDispatcher(const EventDispatcher&) = delete;
-    EventDispatcher& operator=(const EventDispatcher&) = delete;
-
-    std::vector<Listener*> listeners;
-    std::map<Tag, std::vector<Listener*>> tag2Listener;
-
-
-    std::vector<ItemListener*> itemListeners;
-    // std::map<std::string, std::vector<ItemListener*>> tag2ItemListeners; // itemListeners are by iteself specific
-    std::mutex mutex;
-};
-
-
-class GameEngine; 
-
-class InputHandler {
-public:
-    Tag tag = Tag::USER_INPUT; 
-
-    GameEngine* gameEngine;
-
-    InputHandler();
-
-    ~InputHandler();
-
-    void pollEvents();
-
-    bool isQuit() const;
-    bool isWPressed() const;
-    bool isAPressed() const;
-    bool isSPressed() const;
-    bool isDPressed() const;
-    bool isSpacePressed() const;
-
-    void Subscribe(Listener* ptrListener);
-
-    void Publish(Direction direction);  
-
-    void Publish(const std::vector<uint8_t> msg);
-
-
-private:
-    bool quit;
-    bool wPressed, aPressed, sPressed, dPressed, spacePressed;
-
-
-
-    void handleKeyDown(SDL_Keycode key);
-
-    void handleKeyUp(SDL_Keycode key);
-};
-
-
-
-
-
-
+#pragma once
+
+#include <functional>
+#include <string> 
+#include <vector>
+#include <SDL.h> 
+#include <iostream>
+#include <unordered_map>
+#include <mutex>
+#include "../Utils/LOG.h"
+#include "InteractionInfo.h"
+#include "EventQueue.h"
+#include "EventBus.h"
+#include "../Utils/ListenerProfiler.h"
+#include <map>
+
+class Item;
+class GameObject;
+
+// below Code is defining a proxy named (left) for the (right), 
+// sort of like assigning variables but with classnames I guess  
+// Raw data listeners are only for bytes that really come as bytes (network). 
+// Typed events go through EventBus<T> instead.
+using Listener = std::function<void(const std::vector<uint8_t>&)>;
+
+
+enum class Tag {
+    UDP,
+    TCP,
+    USER_INPUT,
+    // a client's tcp connection to the server closed. the bytes are its client_id and session_id
+    DISCONNECT,
+};
+
+// Who sent a queued event, as opaque bytes the enqueuer knows how to read back (the server keeps a sockaddr in here).
+// Empty for events that didn't come from the network.
+struct EventSource {
+    static constexpr size_t CAPACITY = 32;
+
+    uint8_t size = 0;
+    uint8_t bytes[CAPACITY] = {};
+
+    bool IsEmpty() const {
+        return size == 0;
+    }
+};
+
+class EventDispatcher {
+public:
+    // Public method to get the singleton instance
+    static EventDispatcher& GetInstance();
+
+    // name shows up in ListenerProfiler::Dump / ExportTrace, ex) "GameServer::handle_data"
+    void Subscribe(Listener* ptrListener, const std::string& name = "");
+
+    void Subscribe(const Tag tag, Listener* ptrListener, const std::string& name = "");
+
+    void Publish(const std::vector<uint8_t>& message);
+
+    void Publish(const Tag tag, const std::vector<uint8_t>& message);
+
+    // forwarded to EventBus<InteractionInfo>
+    void Publish(InteractionInfo* interactionInfo);
+
+    // Thread safe. Called from the IO thread instead of Publish.
+    // The event is only stored, listeners run later on the game thread inside DispatchQueued.
+    // Returns false when the queue is full and the event has been dropped.
+    bool Enqueue(std::vector<uint8_t> message);
+
+    bool Enqueue(const Tag tag, std::vector<uint8_t> message);
+
+    // source travels with the event, so listeners know who sent it after the IO thread has moved on
+    bool Enqueue(const Tag tag, std::vector<uint8_t> message, const EventSource& source);
+
+    // Game thread only. Runs the listeners of every queued event in one batch.
+    // Events enqueued while draining are left for the next call, so a flood can't stall a frame forever.
+    size_t DispatchQueued();
+
+    // Game thread only. The source of the queued event whose listeners are running right now,
+    // empty outside of DispatchQueued and for events published directly
+    const EventSource& GetDispatchingSource() const {
+        return *dispatchingSource;
+    }
+
+    EventQueueStats GetQueueStats() const;
+
+    void Unsubscribe(Listener* ptrListener);
+
+    void Unsubscribe(const Tag tag, Listener* ptrListener);
+
+private:
+    // Private constructor to prevent direct instantiation
+    EventDispatcher();
+
+    // Delete copy constructor and assignment operator
+    EventDispatcher(const EventDispatcher&) = delete;
+    EventDispatcher& operator=(const EventDispatcher&) = delete;
+
+    // every listener carries its own latency stats
+    struct ListenerEntry {
+        Listener* listener = nullptr;
+        ListenerStats* stats = nullptr;
+    };
+
+    std::vector<ListenerEntry> listeners;
+    std::map<Tag, std::vector<ListenerEntry>> tag2Listener;
+
+    static std::string TagToString(const Tag tag);
+
+    std::mutex mutex;
+
+    // IO thread -> game thread
+    struct QueuedEvent {
+        bool hasTag = false;
+        Tag tag = Tag::UDP;
+        std::vector<uint8_t> message;
+        EventSource source;
+    };
+
+    static constexpr size_t EVENT_QUEUE_CAPACITY = 4096;
+
+    MPSCQueue<QueuedEvent> eventQueue;
+
+    std::atomic<uint64_t> nEnqueued{ 0 };
+    std::atomic<uint64_t> nDropped{ 0 };
+    std::atomic<uint64_t> nDispatched{ 0 };
+    std::atomic<size_t> maxQueueDepth{ 0 };
+    std::atomic<size_t> lastBatchSize{ 0 };
+
+    bool TryEnqueue(QueuedEvent&& queuedEvent);
+
+    static const EventSource NO_SOURCE;
+    const EventSource* dispatchingSource = &NO_SOURCE;
+};
+
+
+class GameEngine; 
+
+class InputHandler {
+public:
+    Tag tag = Tag::USER_INPUT; 
+
+    GameEngine* gameEngine;
+
+    InputHandler();
+
+    ~InputHandler();
+
+    void pollEvents();
+
+    bool isQuit() const;
+    bool isWPressed() const;
+    bool isAPressed() const;
+    bool isSPressed() const;
+    bool isDPressed() const;
+    bool isSpacePressed() const;
+
+    void Subscribe(Listener* ptrListener);
+
+    // published as a typed PlayerInputMessage on EventBus<PlayerInputMessage>
+    void Publish(Direction direction);  
+
+    void Publish(const std::vector<uint8_t>& msg);
+
+
+private:
+    bool quit;
+    bool wPressed, aPressed, sPressed, dPressed, spacePressed;
+
+
+
+    void handleKeyDown(SDL_Keycode key);
+
+    void handleKeyUp(SDL_Keycode key);
+};
+
+
+
+
+
+
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <typeinfo>
+
+#include "../Utils/ListenerProfiler.h"
+
+// Typed publish / subscribe.
+// Every event type is its own topic: EventBus<PlayerInputMessage>, EventBus<InteractionInfo>, ...
+// so the compiler picks the channel and nobody has to encode an event into bytes just to decode it again.
+//
+// Subscribers are kept in a flat array of (function pointer, context) pairs.
+// Publishing walks that array and hands the same const reference to everyone.
+// No std::function, no copy of the event, no allocation.
+//
+// Every subscription can be given a name, its call count and latency then show up in ListenerProfiler.
+//
+// Like the EventDispatcher's Listener*, the subscriber owns whatever the context points at
+// and has to unsubscribe before it goes away.
+// Publish is meant for the game thread. Events from the IO thread go through EventDispatcher::Enqueue.
+template <typename Event>
+class EventBus {
+public:
+    using Handler = void(*)(void* context, const Event& event);
+
+    struct Subscription {
+        Handler handler = nullptr;
+        void* context = nullptr;
+        ListenerStats* stats = nullptr;
+
+        bool operator==(const Subscription& other) const {
+            return handler == other.handler && context == other.context;
+        }
+    };
+
+    static EventBus& GetInstance() {
+        static EventBus instance;
+        return instance;
+    }
+
+    void Subscribe(Handler handler, void* context, const std::string& name = "") {
+        Subscription subscription{ handler, context };
+
+        if (std::find(subscriptions_.begin(), subscriptions_.end(), subscription) == subscriptions_.end()) {
+            // typeid names are mangled on some compilers, still good enough to tell the buses apart
+            std::string statsName = std::string("EventBus<") + typeid(Event).name() + ">/" + (name.empty() ? "unnamed" : name);
+            subscription.stats = ListenerProfiler::GetInstance().Register(statsName);
+
+            subscriptions_.push_back(subscription);
+        }
+    }
+
+    // member function bound at compile time
+    // ex) EventBus<PlayerInputMessage>::GetInstance().Subscribe<&GameServer::OnInput>(this, "GameServer::OnInput");
+    template <auto Method, typename Owner>
+    void Subscribe(Owner* owner, const std::string& name = "") {
+        Subscribe(&InvokeMethod<Method, Owner>, owner, name);
+    }
+
+    // any callable that lives somewhere else (ex. a lambda kept as a member)
+    template <typename Callable>
+    void Subscribe(Callable* callable, const std::string& name = "") {
+        Subscribe(&InvokeCallable<Callable>, callable, name);
+    }
+
+    void Unsubscribe(Handler handler, void* context) {
+        Subscription subscription{ handler, context };
+
+        subscriptions_.erase(
+            std::remove(subscriptions_.begin(), subscriptions_.end(), subscription),
+            subscriptions_.end());
+    }
+
+    template <auto Method, typename Owner>
+    void Unsubscribe(Owner* owner) {
+        Unsubscribe(&InvokeMethod<Method, Owner>, owner);
+    }
+
+    template <typename Callable>
+    void Unsubscribe(Callable* callable) {
+        Unsubscribe(&InvokeCallable<Callable>, callable);
+    }
+
+    // Don't (un)subscribe from inside a handler, the array may move under our feet.
+    void Publish(const Event& event) const {
+        for (const Subscription& subscription : subscriptions_) {
+            try {
+                ScopedListenerTimer timer(subscription.stats);
+                subscription.handler(subscription.context, event);
+            }
+            catch (const std::exception& e) {
+                std::cerr << "EventBus handler exception: " << e.what() << std::endl;
+            }
+        }
+    }
+
+    size_t GetSubscriberCount() const {
+        return subscriptions_.size();
+    }
+
+private:
+    EventBus() = default;
+
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    template <auto Method, typename Owner>
+    static void InvokeMethod(void* context, const Event& event) {
+        (static_cast<Owner*>(context)->*Method)(event);
+    }
+
+    template <typename Callable>
+    static void InvokeCallable(void* context, const Event& event) {
+        (*static_cast<Callable*>(context))(event);
+    }
+
+    std::vector<Subscription> subscriptions_;
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+// Bounded multi-producer / single-consumer queue.
+//
+// Any thread (mostly the asio IO thread) may push, only the game thread pops.
+// Every cell carries a sequence number, which tells both sides whose turn it is to touch the cell.
+// A producer claims a slot with a single CAS on the tail and never waits on the consumer.
+// When the ring is full the push fails instead of blocking, the caller decides what to do (we count it as dropped).
+//
+// The ring is allocated once in the constructor. Pushing and popping never allocates by itself,
+// although moving a payload that owns memory (e.g. std::vector) still moves its buffer around.
+template <typename T>
+class MPSCQueue {
+public:
+    explicit MPSCQueue(size_t capacity) {
+        // round up to a power of two so that wrapping is a mask instead of a modulo
+        size_t cap = 2;
+        while (cap < capacity) {
+            cap <<= 1;
+        }
+        mask_ = cap - 1;
+
+        cells_ = std::vector<Cell>(cap);
+        for (size_t i = 0; i < cap; i++) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    // producers
+    bool TryPush(T&& item) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+            if (diff == 0) {
+                // the cell is free for this lap, try to claim it
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.data = std::move(item);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                // somebody else won the race, pos has been reloaded by the CAS
+            }
+            else if (diff < 0) {
+                // the consumer hasn't freed this cell yet. full.
+                return false;
+            }
+            else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // consumer (single thread only)
+    bool TryPop(T& out) {
+        Cell& cell = cells_[head_ & mask_];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(head_ + 1) < 0) {
+            // nothing published here yet
+            return false;
+        }
+
+        out = std::move(cell.data);
+        // hand the cell back to producers for the next lap
+        cell.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+        head_++;
+
+        return true;
+    }
+
+    // Only a snapshot, producers may be pushing while we read it.
+    size_t ApproxSize() const {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t head = headSnapshot_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    size_t Capacity() const {
+        return mask_ + 1;
+    }
+
+    // consumer publishes how far it got, so that other threads can read ApproxSize
+    void PublishHead() {
+        headSnapshot_.store(head_, std::memory_order_relaxed);
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{ 0 };
+        T data;
+    };
+
+    std::vector<Cell> cells_;
+    size_t mask_ = 0;
+
+    // producers and consumer hammer different ends, keep them on separate cache lines
+    alignas(64) std::atomic<size_t> tail_{ 0 };
+    alignas(64) size_t head_ = 0;
+    std::atomic<size_t> headSnapshot_{ 0 };
+};
+
+// Counters of the dispatcher's queue.
+// dropped > 0 means producers are faster than the game thread drains (backpressure).
+struct EventQueueStats {
+    uint64_t enqueued = 0;
+    uint64_t dropped = 0;
+    uint64_t dispatched = 0;
+
+    size_t depth = 0;           // events waiting right now (approximate)
+    size_t maxDepth = 0;        // highest depth seen at the start of a drain
+    size_t lastBatchSize = 0;   // how many events the last drain handled
+    size_t capacity = 0;
+};
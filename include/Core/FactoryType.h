@@ -1,12 +1,12 @@
-#pragma once
-enum FactoryType {
-    Farm,
-    Bakery
-};
-
-enum FactoryComponentType {
-    INPUTPORT,
-    OUTPUTPORT,
-    DEFAULT, 
-    EMPTY
+#pragma once
+enum FactoryType {
+    Farm,
+    Bakery
+};
+
+enum FactoryComponentType {
+    INPUTPORT,
+    OUTPUTPORT,
+    DEFAULT, 
+    EMPTY
 };
\ No newline at end of file
@@ -1,216 +1,355 @@
-#pragma once
-#include <map> 
-#include "PlayerDirection.h"
-#include <functional>
-#include <vector>
-#include <iostream>
-#include "Core/Transform.h"
-#include "Utils/LOG.h"
-
-using Coord2d = std::pair<int, int>;
-
-using Coord2dWithDirection = std::pair<Coord2d, Direction>;
-
-using Action2Coord2d = std::map<Direction, Coord2d>;  // when given action, get where that action leads the player 
-
-using RotationsOnInt = std::function<int(int)>;
-using Int2RotationOnInt = std::map<int, RotationsOnInt>;
-
-struct NavigationInfo {
-	Coord2d pos = { 0,0 }; 
-	Direction direction = Direction::RIGHT; 
-	int changeOfOrientation = 0; 
-};
-
-int PositiveModulo(int x, int mod);
-
-class ParallelTransporter {
-public:
-	static int Direction2Int(Direction xDir);
-
-	static Direction Int2Direction(int x);
-
-	static int TurnLeft(int x);
-	static int TurnRight(int x);
-	static int Turn180(int x);
-	static int StayStraight(int x);
-	static Int2RotationOnInt int2Rotation;
-
-	/*
-		This could be thought of as a map f: Direction x Direction -> Direction
-		Mathematically, a parallel tranport is a way of pushing tangent vectors on a manifold.
-		First argument corresponds to 'what TangentVector we are pushing'.
-		Second argument corresponds to 'in what direction we are pushing the first argument'.
-		Third the result corresponds to how the first argument changes as it is pushed in the direction of the second argument.
-
-		However, in our case, since the world is discrete and there are only four directions,
-		the third argument, the result is not the change of the first argument,
-		but rather the resulting tangent vector of pushing first arg through the direction of second arg
-		One could think of this as a trivial version of the christophel symbol
-
-		This Transporter exists at every point of the grid.
-		Each one of the instance acts as a piece of information of how the space is connected
-
-
-		for efficient expressions of the relations between the directions,
-		we use a number to compactly represent the change that is applied to the tangent vector.
-
-		0: right
-		1: up
-		2: left
-		3: down
-
-		a +1 would
-
-		+1(0) = 1 ~ 90 degree rotation: right |-> up
-		+1(1) = 2 ~ 90 degree rotation: up |-> left
-		...
-
-		As we can see, each number corresponds to a rotation.
-		In the optimal cases, where the manifold is metric-compatible,
-		all possible alternations between the tangent vectors coresspond to each number.
-
-		Direction -> Direction
-
-		Z / 4 -> Z / 4
-
-		for that reason, this class don't directly work with the Directions,
-		but work with numbers as a proxy to it.
-
-		The default maps each direction to 0 where all transports have 0 curvature respect to the current coordinate system.
-		0 -> +0
-		1 -> +0
-		2 -> +0
-		3 -> +0
-	*/
-	bool isDefault = true;
-
-	Int2RotationOnInt directionInt2RotationInt; 
-	std::map<int, int> int2Int;
-
-
-	ParallelTransporter();
-
-	ParallelTransporter(Int2RotationOnInt x);
-
-	void SetDirectionInt2RotationInt(int directionInt, int rotationInt);
-
-	Direction CalculateDireciton(Direction facingWhere, Direction goingWhere);
-};
-
-
-// server & client
-class MovementManager {
-public:
-	std::string GetName() const {
-		return "MovementManager";
-	};
-
-private:
-	void log(LogLevel level, std::string text) { LOG(level, GetName() + "::" + text); }
-
-	/*
-		Our objects live on a Non Euclidean Space
-		There Exist Curvature.
-		This class Helps the playes and other objects to move through the Geodisics of space
-	*/
-	uint8_t gridHeight_; 
-	uint8_t gridWidth_;  
-public:
-	std::vector<std::vector<Action2Coord2d*>> grid2Transporter;
-	std::vector<std::vector<ParallelTransporter*>> grid2ParallelTransporter;
-	// std::vector<std::vector<Transform*>> grid2Transform; 
-
-	MovementManager() : gridHeight_(0), gridWidth_(0)  {
-		this->InitializeTori(); 
-
-		log(LOG_INFO, "zero");
-	}
-
-	MovementManager(uint8_t cubeEdgeLength) : gridHeight_(cubeEdgeLength), gridWidth_(cubeEdgeLength*6) {
-		this->InitializeTori(); 
-
-		this->InitPlanarFigure(0, 0, cubeEdgeLength); 
-
-		log(LOG_INFO, "Init to cube of size: " + std::to_string(cubeEdgeLength));
-	}
-
-	MovementManager(uint8_t gridHeight, uint8_t gridWidth) :gridHeight_(gridHeight), gridWidth_(gridWidth) {
-		this->InitializeTori();  
-
-		log(LOG_INFO, "Init Tori of size H x W: " + std::to_string(gridHeight_) + " x " + std::to_string(gridWidth_));
-	}
-
-	void InitializeTori() {
-		grid2Transporter.resize(gridHeight_, std::vector<Action2Coord2d*>(gridWidth_, nullptr));
-		grid2ParallelTransporter.resize(gridHeight_, std::vector<ParallelTransporter*>(gridWidth_, nullptr));
-
-		for (int y = 0; y < gridHeight_; ++y) {
-			for (int x = 0; x < gridWidth_; ++x) {
-				// Create a new Action2Coord2d map for the current cell
-				grid2Transporter[y][x] = new Action2Coord2d({
-					{Direction::RIGHT, {y, (x + 1) % gridWidth_}},                        // Wrap horizontally to the left
-					{Direction::UP, {(y - 1 + gridHeight_) % gridHeight_, x}},              // Wrap vertically to the bottom
-					{Direction::LEFT, {y, (x - 1 + gridWidth_) % gridWidth_}},           // Wrap horizontally to the right
-					{Direction::DOWN, {(y + 1) % gridHeight_, x}}                        // Wrap vertically to the top
-					});
-
-				// Initialize the ParallelTransporter for the current cell
-				grid2ParallelTransporter[y][x] = new ParallelTransporter();
-			}
-		}
-	}
-
-	void InitPlanarFigure(int startY, int startX, int size);
-	void InitTransporters(int startY, int startX, int size);  
-	// void InitTransforms(int startY, int startX, int size); 
-
-	NavigationInfo Move(Coord2d position, Direction movingDirection, Direction facingDirection); 
-};
-
-// client 
-class GridTransformManager {
-public:
-	std::string GetName() const {
-		return "GridTransformManager";
-	};
-
-private:
-	void log(LogLevel level, std::string text) { LOG(level, GetName() + "::" + text); }
-	
-	uint8_t gridHeight_;
-	uint8_t gridWidth_;
-
-	float BLOCK_SIZE = 0.2f;
-	float BLOCK_OFFSET = 1.0f; 
-	float GROUND_OFFSET = 1.0f; 
-public:
-	std::vector<std::vector<Transform*>> grid2Transform;
-
-	GridTransformManager() : gridHeight_(0), gridWidth_(0) {
-		Initialize();
-	}
-
-	GridTransformManager(uint8_t cubeEdgeLength) : gridHeight_(cubeEdgeLength), gridWidth_(cubeEdgeLength * 6) {
-		Initialize();
-
-		this->InitTransforms(0, 0, cubeEdgeLength);
-		log(LOG_INFO, "Initialize to Cube");
-	}
-
-	GridTransformManager(uint8_t gridHeight, uint8_t gridWidth) :gridHeight_(gridHeight), gridWidth_(gridWidth) {
-		Initialize();
-	}
-
-	void Initialize() {
-		grid2Transform.resize(gridHeight_, std::vector<Transform*>(gridWidth_, nullptr));
-
-		for (int y = 0; y < gridHeight_; ++y) {
-			for (int x = 0; x < gridWidth_; ++x) {
-				grid2Transform[y][x] = new Transform();
-			}
-		}
-	}
-
-	void InitTransforms(int startY, int startX, int size);
-};
\ No newline at end of file
+#pragma once
+#include "PlayerDirection.h"
+#include <vector>
+#include <iostream>
+#include <unordered_map>
+#include <memory>
+#include <utility>
+#include "Core/Transform.h"
+#include <glm/gtc/type_ptr.hpp>
+#include "Core/GridTopology.h"
+#include "Core/ChunkedGrid.h"
+#include "Core/NetCompiler.h"
+#include "Utils/LOG.h"
+
+using Coord2d = std::pair<int, int>;
+
+using Coord2dWithDirection = std::pair<Coord2d, Direction>;
+
+struct NavigationInfo {
+	Coord2d pos = { 0,0 }; 
+	Direction direction = Direction::RIGHT; 
+	int changeOfOrientation = 0; 
+	// the ridable whose grid pos is on, when the step went through a portal. 0: the grid Move was called on
+	uint32_t gridID = 0;
+};
+
+// Where stepping onto a portal cell takes you: a cell on the grid of another ridable (or another cell of the same one).
+// The facing turns by rotation on the way, like across a seam.
+// y and x are cell split by the width of the other grid, so that Move doesn't need to know it.
+struct PortalLink {
+	uint32_t gridID;
+	uint32_t cell;
+	uint16_t y;
+	uint16_t x;
+	uint8_t rotation;
+};
+
+int PositiveModulo(int x, int mod);
+
+// Many walkers on one grid, moved at once. One entry per walker in every array (structure of arrays).
+// Directions are Direction as uint8_t, IDLE (4) stays.
+struct MovementBatch {
+	// in
+	std::vector<uint32_t> cells;
+	std::vector<uint8_t> moving;
+	std::vector<uint8_t> facing;
+
+	// out of MovementManager::MoveBatch, then ResolveConflicts
+	std::vector<uint32_t> targets;
+	std::vector<uint8_t> newFacing;
+	std::vector<uint8_t> orientationChanges;
+	// 1: the step was refused by ResolveConflicts, the walker stays where it is
+	std::vector<uint8_t> blocked;
+
+	// scratch of ResolveConflicts, kept for its capacity. (cell, walker) sorted by cell, as big as the batch and not the grid
+	std::vector<std::pair<uint32_t, uint32_t>> claims;
+	std::vector<std::pair<uint32_t, uint32_t>> standing;
+	std::vector<uint32_t> refused;
+
+	size_t Size() const {
+		return cells.size();
+	}
+
+	void Clear() {
+		cells.clear();
+		moving.clear();
+		facing.clear();
+	}
+
+	void Add(uint32_t cell, Direction movingDirection, Direction facingDirection) {
+		cells.push_back(cell);
+		moving.push_back(static_cast<uint8_t>(movingDirection));
+		facing.push_back(static_cast<uint8_t>(facingDirection));
+	}
+};
+
+// A straight walk along the grid from fromCell, turning with the seams like a walker would.
+// Stops in front of the first occupied cell, at a portal, after maxDistance steps, or when it comes back to where it started.
+struct Ray {
+	static constexpr uint32_t NO_HIT = UINT32_MAX;
+
+	// in
+	uint32_t fromCell = 0;
+	Direction direction = Direction::IDLE;
+	uint16_t maxDistance = 0;
+
+	// out of MovementManager::CastRay
+	// the last free cell, fromCell if the first step is already blocked
+	uint32_t lastCell = 0;
+	// the occupied cell that stopped the ray and who is there. NO_HIT and 0 if nothing did
+	uint32_t hitCell = NO_HIT;
+	uint32_t hitObjectID = 0;
+	// hitCell is a portal, the way ahead leaves the grid there. hitObjectID is 0, the ray doesn't look through
+	bool isPortal = false;
+	// steps to hitCell, to lastCell if nothing was hit
+	uint16_t distance = 0;
+	// where the ray was going at the end, in the frame of the grid
+	Direction heading = Direction::IDLE;
+};
+
+// server & client
+class MovementManager {
+public:
+	std::string GetName() const {
+		return "MovementManager";
+	};
+
+private:
+	void log(LogLevel level, std::string text) { LOG(level, GetName() + "::" + text); }
+
+	/*
+		Our objects live on a Non Euclidean Space
+		There Exist Curvature.
+		This class Helps the playes and other objects to move through the Geodisics of space
+	*/
+	uint16_t gridHeight_; 
+	uint16_t gridWidth_;  
+
+	// f: cell index -> how it is connected. the seams patched by InitPlanarFigure.
+	// empty while cells_ points at a shared CubeNet table or net, or while the grid is a big plain torus
+	std::vector<CellLink> links_;
+
+	// the compiled net cells_ points into, kept alive as long as this grid reads it
+	std::shared_ptr<const CompiledNet> net_;
+
+	// what Move reads. the CubeNet table of this size, the links of net_, links_.data(), 
+	// or nullptr: a plain torus past MAX_STORED_TORUS_CELLS, the links are worked out from the index and nothing is stored per cell
+	const CellLink* cells_ = nullptr;
+
+	uint32_t CellIndex(int y, int x) const {
+		return static_cast<uint32_t>(y * gridWidth_ + x);
+	}
+
+	// before the links are changed: a shared table or the torus is written out into links_ first
+	void Detach();
+
+	// f: cell index -> where stepping onto it leads. a handful per grid, kept next to the links instead of in every CellLink
+	std::unordered_map<uint32_t, PortalLink> portals_;
+
+public:
+	MovementManager() : gridHeight_(0), gridWidth_(0)  {
+		this->InitializeTori(); 
+
+		log(LOG_INFO, "zero");
+	}
+
+	MovementManager(uint8_t cubeEdgeLength) : gridHeight_(cubeEdgeLength), gridWidth_(cubeEdgeLength*6) {
+		cells_ = CubeNet::GetLinks(cubeEdgeLength);
+
+		// not precomputed, fold it here
+		if (cells_ == nullptr) {
+			this->InitializeTori();
+
+			this->InitPlanarFigure(0, 0, cubeEdgeLength);
+		}
+
+		log(LOG_INFO, "Init to cube of size: " + std::to_string(cubeEdgeLength));
+	}
+
+	MovementManager(uint16_t gridHeight, uint16_t gridWidth) :gridHeight_(gridHeight), gridWidth_(gridWidth) {
+		this->InitializeTori();  
+
+		log(LOG_INFO, "Init Tori of size H x W: " + std::to_string(gridHeight_) + " x " + std::to_string(gridWidth_));
+	}
+
+	// folded like net, reading its links in place. every grid of the same net shares them
+	MovementManager(std::shared_ptr<const CompiledNet> net) : gridHeight_(net->gridHeight), gridWidth_(net->gridWidth), net_(std::move(net)) {
+		cells_ = net_->links.data();
+
+		log(LOG_INFO, "Init to net of size H x W: " + std::to_string(gridHeight_) + " x " + std::to_string(gridWidth_));
+	}
+
+	// cells_ can point into links_, a copy would read the links of the original. grids are held by their RidableObject
+	MovementManager(const MovementManager&) = delete;
+	MovementManager& operator=(const MovementManager&) = delete;
+
+	// a torus bigger than this keeps no links, they are worked out from the cell index (slower, but nothing per cell)
+	static constexpr size_t MAX_STORED_TORUS_CELLS = 1 << 16;
+
+	// every cell linked to its 4 neighbours, wrapping around at the borders, no curvature
+	void InitializeTori();
+
+	void InitPlanarFigure(int startY, int startX, int size);
+	void InitTransporters(int startY, int startX, int size);  
+	// void InitTransforms(int startY, int startX, int size); 
+
+	// one step. stepping onto a portal cell lands on the other end of the portal, see NavigationInfo::gridID
+	NavigationInfo Move(Coord2d position, Direction movingDirection, Direction facingDirection); 
+
+	// stepping onto cell leads to link from now on. replaces the portal that was there
+	void SetPortal(uint32_t cell, const PortalLink& link);
+	void RemovePortal(uint32_t cell);
+
+	// nullptr if cell is not a portal
+	const PortalLink* GetPortal(uint32_t cell) const {
+		if (portals_.empty()) {
+			return nullptr;
+		}
+		auto it = portals_.find(cell);
+		return it != portals_.end() ? &it->second : nullptr;
+	}
+
+	size_t GetPortalCount() const {
+		return portals_.size();
+	}
+
+	// Move for every walker of the batch, ignoring who stands where. 
+	// no branches, the loop is a gather over the links the compiler can vectorize.
+	// portals are not crossed, a target with GetPortal is for the caller to send through
+	void MoveBatch(MovementBatch& batch) const;
+
+	// Second pass. occupancy: the grid, f: cell -> objectID, 0 empty.
+	// A step is refused when
+	// - somebody not in the batch stands on the target (walking into them is an interaction, not a move)
+	// - a walker with a lower index in the batch wants the same cell
+	// - two walkers would swap cells
+	// - the walker standing on the target doesn't get away
+	// Refused walkers stay with their facing unchanged. Same batch, same result: walkers are settled in index order
+	void ResolveConflicts(MovementBatch& batch, const ChunkedGrid<uint32_t>& occupancy) const;
+
+	// occupancy: the grid, f: cell -> objectID, 0 empty. the start cell is not looked at, that's whoever casts the ray.
+	// one link read per step, and a portal lookup if the grid has portals. no Move, no logging. const, so rays can be cast from any number of threads
+	void CastRay(Ray& ray, const ChunkedGrid<uint32_t>& occupancy) const;
+
+	void CastRays(Ray* rays, size_t count, const ChunkedGrid<uint32_t>& occupancy) const;
+
+	// gridHeight * gridWidth of them, y * gridWidth + x. nullptr for a big plain torus, see GetLink
+	const CellLink* GetLinks() const {
+		return cells_;
+	}
+
+	// the links of one cell, also of a plain torus. cell < GetCellCount()
+	CellLink GetLink(uint32_t cell) const {
+		if (cells_ != nullptr) {
+			return cells_[cell];
+		}
+
+		uint32_t y = cell / gridWidth_;
+		uint32_t x = cell % gridWidth_;
+
+		CellLink link = {};
+		link.neighbours[static_cast<int>(Direction::RIGHT)] = y * gridWidth_ + (x + 1 == gridWidth_ ? 0 : x + 1);
+		link.neighbours[static_cast<int>(Direction::UP)] = (y == 0 ? gridHeight_ - 1 : y - 1) * gridWidth_ + x;
+		link.neighbours[static_cast<int>(Direction::LEFT)] = y * gridWidth_ + (x == 0 ? gridWidth_ - 1 : x - 1);
+		link.neighbours[static_cast<int>(Direction::DOWN)] = (y + 1 == gridHeight_ ? 0 : y + 1) * gridWidth_ + x;
+		return link;
+	}
+
+	size_t GetCellCount() const {
+		return static_cast<size_t>(gridHeight_) * gridWidth_;
+	}
+
+	// read only, shared with every other cube of this size or grid of the same net
+	bool IsShared() const {
+		return cells_ != nullptr && cells_ != links_.data();
+	}
+
+	uint16_t GetGridHeight() const {
+		return gridHeight_;
+	}
+
+	uint16_t GetGridWidth() const {
+		return gridWidth_;
+	}
+};
+
+// client 
+// The local matrix of every cell of a grid, one contiguous array in cell order (y * gridWidth + x).
+// Worked out once when the grid is folded, read as is afterwards. The array is laid out like an instance buffer,
+// 16 floats per cell, column major, and can be uploaded without touching a cell.
+class GridTransformManager {
+public:
+	std::string GetName() const {
+		return "GridTransformManager";
+	};
+
+private:
+	void log(LogLevel level, std::string text) { LOG(level, GetName() + "::" + text); }
+	
+	uint16_t gridHeight_;
+	uint16_t gridWidth_;
+
+	// the matrices of a grid folded here, empty while matrices_ points at a shared CubeNet table or net, or the grid is flat
+	std::vector<CellMatrix> ownMatrices_;
+
+	// the compiled net matrices_ points into, kept alive as long as this grid reads it
+	std::shared_ptr<const CompiledNet> net_;
+
+	// what GetCellMatrix reads. the CubeNet matrices of this size, the matrices of net_, ownMatrices_.data(),
+	// or nullptr: flat, every cell has the identity
+	const CellMatrix* matrices_ = nullptr;
+
+	// bumped whenever the matrices change, whoever uploaded them knows when to do it again
+	uint32_t version_ = 0;
+
+	// before the matrices are changed: a shared table or the identities are written out into ownMatrices_ first
+	void Detach();
+public:
+	GridTransformManager() : gridHeight_(0), gridWidth_(0) {
+	}
+
+	GridTransformManager(uint8_t cubeEdgeLength) : gridHeight_(cubeEdgeLength), gridWidth_(cubeEdgeLength * 6) {
+		matrices_ = CubeNet::GetMatrices(cubeEdgeLength);
+
+		// not precomputed, fold it here
+		if (matrices_ == nullptr) {
+			this->InitTransforms(0, 0, cubeEdgeLength);
+		}
+		log(LOG_INFO, "Initialize to Cube");
+	}
+
+	GridTransformManager(uint16_t gridHeight, uint16_t gridWidth) :gridHeight_(gridHeight), gridWidth_(gridWidth) {
+	}
+
+	// folded like net, reading its matrices in place. every grid of the same net shares them
+	GridTransformManager(std::shared_ptr<const CompiledNet> net) : gridHeight_(net->gridHeight), gridWidth_(net->gridWidth), net_(std::move(net)) {
+		matrices_ = net_->matrices.data();
+	}
+
+	// matrices_ can point into ownMatrices_, a copy would read the matrices of the original
+	GridTransformManager(const GridTransformManager&) = delete;
+	GridTransformManager& operator=(const GridTransformManager&) = delete;
+
+	void InitTransforms(int startY, int startX, int size);
+
+	// local matrix of the cell at (y, x)
+	glm::mat4 GetCellMatrix(int y, int x) const {
+		return GetCellMatrix(static_cast<uint32_t>(y * gridWidth_ + x));
+	}
+
+	glm::mat4 GetCellMatrix(uint32_t cell) const {
+		if (matrices_ == nullptr) {
+			return glm::mat4(1);
+		}
+		return glm::make_mat4(matrices_[cell].m);
+	}
+
+	// gridHeight * gridWidth of them, in cell order. nullptr for a flat grid, every cell has the identity
+	const CellMatrix* GetMatrices() const {
+		return matrices_;
+	}
+
+	size_t GetCellCount() const {
+		return static_cast<size_t>(gridHeight_) * gridWidth_;
+	}
+
+	uint32_t GetVersion() const {
+		return version_;
+	}
+
+	// read only, shared with every other cube of this size or grid of the same net
+	bool IsShared() const {
+		return matrices_ != nullptr && matrices_ != ownMatrices_.data();
+	}
+};
@@ -0,0 +1,342 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "PlayerDirection.h"
+
+/*
+	How one cell of a grid is connected to its neighbours. One of these per cell, in one flat array.
+
+	neighbours[d] is the cell index (y * width + x) reached by stepping in direction d.
+
+	rotations packs a map f: Direction -> Z / 4, 2 bits per direction, direction d at bits [2d, 2d + 1].
+	Mathematically, a parallel transport is a way of pushing tangent vectors on a manifold.
+	f(d) is how a tangent vector (where we are facing) turns as it is pushed across the edge in direction d.
+	One could think of this as a trivial version of the christoffel symbol.
+
+	Since the world is discrete and there are only four directions, every change is a rotation,
+	and a rotation is a number:
+
+		0: right
+		1: up
+		2: left
+		3: down
+
+		+1(0) = 1 ~ 90 degree rotation: right |-> up
+		+1(1) = 2 ~ 90 degree rotation: up |-> left
+		...
+
+	so the facing after the step is (facing + f(d)) mod 4.
+	On a flat grid (a torus) every rotation is 0, only the seams of a folded figure (the cube) carry curvature.
+*/
+struct CellLink {
+	uint32_t neighbours[4];
+	uint8_t rotations;
+
+	constexpr uint8_t RotationOf(int directionInt) const {
+		return (rotations >> (2 * directionInt)) & 3;
+	}
+
+	constexpr void SetRotation(int directionInt, int rotationInt) {
+		rotations = static_cast<uint8_t>((rotations & ~(3 << (2 * directionInt))) | ((rotationInt & 3) << (2 * directionInt)));
+	}
+};
+
+// the local transform of a cell, column major like glm::mat4. glm::make_mat4(m) reads it
+struct CellMatrix {
+	float m[16];
+};
+
+// Building the tables. Everything is constexpr, so the same code fills the precomputed cube nets (see CubeNet)
+// at compile time and every other grid at runtime.
+namespace GridTopology {
+	// size of a cell and the gaps between the faces of a cube
+	constexpr float BLOCK_SIZE = 0.2f;
+	constexpr float BLOCK_OFFSET = 1.0f;
+	constexpr float GROUND_OFFSET = 1.0f;
+
+	constexpr int PositiveModulo(int x, int mod) {
+		return ((x) % mod + mod) % mod;
+	}
+
+	constexpr uint32_t CellIndex(int width, int y, int x) {
+		return static_cast<uint32_t>(y * width + x);
+	}
+
+	// the step from (y, x) in direction leads to (toY, toX) and turns the facing by rotationInt
+	constexpr void Link(CellLink* links, int width, int y, int x, Direction direction, int toY, int toX, int rotationInt) {
+		CellLink& link = links[CellIndex(width, y, x)];
+
+		link.neighbours[static_cast<int>(direction)] = CellIndex(width, toY, toX);
+		link.SetRotation(static_cast<int>(direction), rotationInt);
+	}
+
+	// every cell linked to its 4 neighbours, wrapping around at the borders, no curvature
+	constexpr void LinkTorus(CellLink* links, int height, int width) {
+		for (int y = 0; y < height; ++y) {
+			for (int x = 0; x < width; ++x) {
+				CellLink& link = links[CellIndex(width, y, x)];
+
+				link.neighbours[static_cast<int>(Direction::RIGHT)] = CellIndex(width, y, (x + 1) % width);				// Wrap horizontally to the left
+				link.neighbours[static_cast<int>(Direction::UP)] = CellIndex(width, (y - 1 + height) % height, x);		// Wrap vertically to the bottom
+				link.neighbours[static_cast<int>(Direction::LEFT)] = CellIndex(width, y, (x - 1 + width) % width);		// Wrap horizontally to the right
+				link.neighbours[static_cast<int>(Direction::DOWN)] = CellIndex(width, (y + 1) % height, x);				// Wrap vertically to the top
+
+				link.rotations = 0;
+			}
+		}
+	}
+
+	// Folds the size x (size * 6) block at (startY, startX) of a torus into a cube.
+	// 4 lateral faces side by side, then the upper base, then the bottom base. the caller checks that it fits
+	constexpr void LinkCubeNet(CellLink* links, int width, int startY, int startX, int size) {
+		int curY = 0;
+		int curX = 0;
+		Direction curDirection = Direction::UP;
+		int curCurvatureFromLateralFace2BottomBase = 0;
+		int curCurvatureFromLateralFace2UpperBase = 0;
+
+		int curIndex = 0;
+		for (int i = 0; i < 4; i++) {
+			curCurvatureFromLateralFace2BottomBase = ((-i) % 4 + 4) % 4;
+			curCurvatureFromLateralFace2UpperBase = i % 4;
+			for (int j = 0; j < size; j++) {
+				if (i == 0) {
+					curY = 0;
+					curX = j;
+					curDirection = Direction::UP;
+				}
+				else if (i == 1) {
+					curY = j;
+					curX = size - 1;
+					curDirection = Direction::RIGHT;
+				}
+				else if (i == 2) {
+					curY = size - 1;
+					curX = size - j - 1;
+					curDirection = Direction::DOWN;
+				}
+				else {
+					curY = size - j - 1;
+					curX = 0;
+					curDirection = Direction::LEFT;
+				}
+
+				curY = curY + startY;
+				curX = curX + startX + size * 5; // bottom starts at size * 5
+
+				// remember
+				// right -> 0
+				// up -> 1
+				// left -> 2
+				// down -> 3
+
+				// bottom rim
+				// latteral face 2 base
+				Link(links, width, startY + size - 1, startX + curIndex, Direction::DOWN, curY, curX, curCurvatureFromLateralFace2BottomBase);
+				// base 2 latteral face
+				Link(links, width, curY, curX, curDirection, startY + size - 1, startX + curIndex, PositiveModulo(-curCurvatureFromLateralFace2BottomBase, 4));
+
+				if (i == 0) {
+					curY = size - 1;
+					curX = j;
+					curDirection = Direction::DOWN;
+				}
+				else if (i == 1) {
+					curY = size - j - 1;
+					curX = size - 1;
+					curDirection = Direction::RIGHT;
+				}
+				else if (i == 2) {
+					curY = 0;
+					curX = size - j - 1;
+					curDirection = Direction::UP;
+				}
+				else {
+					curY = j;
+					curX = 0;
+					curDirection = Direction::LEFT;
+				}
+
+				curY = curY + startY;
+				curX = curX + startX + size * 4; // bottom starts at size * 4
+
+				// upper rim
+				Link(links, width, startY + 0, startX + curIndex, Direction::UP, curY, curX, curCurvatureFromLateralFace2UpperBase);
+
+				Link(links, width, curY, curX, curDirection, startY + 0, startX + curIndex, PositiveModulo(-curCurvatureFromLateralFace2UpperBase, 4));
+
+				// end
+				curIndex += 1;
+			}
+		}
+
+		// stitch up the latteral faces
+		for (int i = 0; i < size; i++) {
+			// left to right
+			links[CellIndex(width, startY + i, startX + 0)].neighbours[static_cast<int>(Direction::LEFT)] = CellIndex(width, startY + i, startX + size * 4 - 1);
+
+			// right to left
+			links[CellIndex(width, startY + i, startX + size * 4 - 1)].neighbours[static_cast<int>(Direction::RIGHT)] = CellIndex(width, startY + i, startX + 0);
+		}
+	}
+
+	// where cell (i, j) of a cube net of edge size sits: translation, and a rotation of quarterTurns * 90 degrees
+	struct CubeNetPlacement {
+		float x;
+		float y;
+		float z;
+
+		// 'x' or 'z', 0: no rotation
+		char axis;
+		int quarterTurns;
+	};
+
+	constexpr CubeNetPlacement PlaceCubeNetCell(int size, int i, int j) {
+		CubeNetPlacement placement = { 0, 0, 0, 0, 0 };
+
+		float curZ = 0;
+		float curY = 0;
+		float curX = 0;
+
+		int curFaceIndex = j / size;
+
+		switch (curFaceIndex) {
+		case 0: //
+			curZ = static_cast<float>(i);
+			curY = 0;
+			curX = static_cast<float>(j % size);
+
+			curY += -GROUND_OFFSET;
+			break;
+		case 1:
+			curZ = static_cast<float>(i);
+			curY = static_cast<float>(j % size);
+			curX = static_cast<float>(size - 1);
+
+			curX += GROUND_OFFSET;
+
+			placement.axis = 'z';
+			placement.quarterTurns = -1;
+			break;
+		case 2:
+			curZ = static_cast<float>(i);
+			curY = static_cast<float>(size - 1);
+			curX = static_cast<float>(size - (j % size) - 1);
+
+			curY += GROUND_OFFSET;
+
+			placement.axis = 'z';
+			placement.quarterTurns = -2;
+			break;
+		case 3:
+			curZ = static_cast<float>(i);
+			curY = static_cast<float>(size - (j % size) - 1);
+			curX = 0;
+
+			curX += -GROUND_OFFSET;
+
+			placement.axis = 'z';
+			placement.quarterTurns = -3;
+			break;
+		case 4: // top
+			curZ = 0;
+			curY = static_cast<float>(size - i - 1);
+			curX = static_cast<float>(j % size);
+
+			curZ += -GROUND_OFFSET;
+
+			placement.axis = 'x';
+			placement.quarterTurns = -1;
+			break;
+		case 5: // bottom
+			curZ = static_cast<float>(size - 1);
+			curY = static_cast<float>(i);
+			curX = static_cast<float>(j % size);
+
+			curZ += GROUND_OFFSET;
+
+			placement.axis = 'x';
+			placement.quarterTurns = 1;
+			break;
+		}
+
+		curZ += -0.5f;
+		curY += -0.5f;
+		curX += -0.5f;
+
+		placement.z = curZ * BLOCK_OFFSET;
+		placement.y = curY * -BLOCK_OFFSET;
+		placement.x = curX * BLOCK_OFFSET;
+
+		return placement;
+	}
+
+	// translate * rotate * scale(BLOCK_SIZE) of PlaceCubeNetCell, what Transform::GetTransformMatrix makes of it.
+	// quarter turns have exact sines and cosines, no trigonometry needed
+	constexpr CellMatrix CubeNetCellMatrix(int size, int i, int j) {
+		CubeNetPlacement placement = PlaceCubeNetCell(size, i, j);
+
+		constexpr float COS[4] = { 1, 0, -1, 0 };
+		constexpr float SIN[4] = { 0, 1, 0, -1 };
+		int turns = PositiveModulo(placement.quarterTurns, 4);
+		float c = COS[turns];
+		float s = SIN[turns];
+
+		CellMatrix matrix = { { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1 } };
+
+		if (placement.axis == 'z') {
+			matrix.m[0] = c;  matrix.m[1] = s;
+			matrix.m[4] = -s; matrix.m[5] = c;
+		}
+		else if (placement.axis == 'x') {
+			matrix.m[5] = c;  matrix.m[6] = s;
+			matrix.m[9] = -s; matrix.m[10] = c;
+		}
+
+		for (int k = 0; k < 12; k++) {
+			matrix.m[k] *= BLOCK_SIZE;
+		}
+
+		matrix.m[12] = placement.x;
+		matrix.m[13] = placement.y;
+		matrix.m[14] = placement.z;
+
+		return matrix;
+	}
+}
+
+// Cube nets of the common edge lengths, built at compile time into read only data.
+// Every RidableObject of such a size points at the same table, spawning one computes and allocates no topology.
+// Other sizes are built per object at runtime, from the same GridTopology functions.
+namespace CubeNet {
+	constexpr uint8_t MAX_PRECOMPUTED_EDGE = 16;
+
+	template <uint8_t EDGE>
+	struct Table {
+		static constexpr size_t CELL_COUNT = 6 * EDGE * EDGE;
+
+		CellLink links[CELL_COUNT];
+		CellMatrix matrices[CELL_COUNT];
+	};
+
+	template <uint8_t EDGE>
+	constexpr Table<EDGE> Build() {
+		Table<EDGE> table{};
+
+		GridTopology::LinkTorus(table.links, EDGE, EDGE * 6);
+		GridTopology::LinkCubeNet(table.links, EDGE * 6, 0, 0, EDGE);
+
+		for (int i = 0; i < EDGE; i++) {
+			for (int j = 0; j < EDGE * 6; j++) {
+				table.matrices[i * EDGE * 6 + j] = GridTopology::CubeNetCellMatrix(EDGE, i, j);
+			}
+		}
+
+		return table;
+	}
+
+	// y * (edge * 6) + x. nullptr for edges that are not precomputed
+	const CellLink* GetLinks(uint8_t edge);
+	const CellMatrix* GetMatrices(uint8_t edge);
+}
@@ -1,7 +1,7 @@
-#pragma once
-
-enum class GroundType {
-    WATER,
-    GRASS,
-    LAST // dummy that for iteration
+#pragma once
+
+enum class GroundType {
+    WATER,
+    GRASS,
+    LAST // dummy that for iteration
 };
\ No newline at end of file
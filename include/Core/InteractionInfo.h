@@ -1,14 +1,14 @@
-#pragma once
-#include "PlayerDirection.h"
-
-class GameObject;
-class Item; 
-
-struct InteractionInfo {
-	GameObject* who;
-	Item* item; 
-	int yCoord; 
-	int xCoord;
-
-	Direction goingWhere = Direction::IDLE;
+#pragma once
+#include "PlayerDirection.h"
+
+class GameObject;
+class Item; 
+
+struct InteractionInfo {
+	GameObject* who;
+	Item* item; 
+	int yCoord; 
+	int xCoord;
+
+	Direction goingWhere = Direction::IDLE;
 };
\ No newline at end of file
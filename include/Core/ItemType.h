@@ -1,10 +1,10 @@
-#pragma once
-
-enum class ItemType {
-    WOOD,
-    ROCK,
-    IRON,
-    RUBY,
-    PYTHON,
-    INVALID
+#pragma once
+
+enum class ItemType {
+    WOOD,
+    ROCK,
+    IRON,
+    RUBY,
+    PYTHON,
+    INVALID
 };
\ No newline at end of file
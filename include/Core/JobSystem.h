@@ -0,0 +1,128 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "../Utils/LOG.h"
+
+// Small work stealing thread pool, owned by the GameEngine.
+//
+// Every thread has its own queue. A thread works its own queue from the back (most recently pushed, still warm in cache)
+// and when that is empty steals from the front of somebody else's queue.
+// The thread calling ParallelFor (the game thread) is thread 0 and works along instead of idling until the others are done.
+//
+// Jobs are a function pointer plus a range, no allocation per job.
+// ParallelFor is meant to be called from the game thread only, not from inside a job.
+class JobSystem {
+public:
+    std::string GetName() const;
+
+private:
+    void log(LogLevel level, std::string text);
+
+public:
+    // nWorkers threads are started on top of the calling thread
+    explicit JobSystem(size_t nWorkers);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // workers + the calling thread. threadIndex passed to jobs is in [0, GetThreadCount())
+    size_t GetThreadCount() const {
+        return queues_.size();
+    }
+
+    // Splits [0, count) into chunks of chunkSize and runs f(begin, end, threadIndex) for each, in parallel.
+    // Returns once every chunk is done.
+    template <typename F>
+    void ParallelFor(size_t count, size_t chunkSize, F&& f) {
+        if (count == 0) {
+            return;
+        }
+        if (chunkSize == 0) {
+            chunkSize = 1;
+        }
+
+        size_t nChunks = (count + chunkSize - 1) / chunkSize;
+
+        if (nChunks == 1 || workers_.empty()) {
+            f(size_t(0), count, size_t(0));
+            return;
+        }
+
+        std::atomic<size_t> remaining{ nChunks };
+
+        Job job;
+        job.run = &RunRange<typename std::remove_reference<F>::type>;
+        job.context = &f;
+        job.remaining = &remaining;
+
+        for (size_t chunk = 0; chunk < nChunks; chunk++) {
+            job.begin = chunk * chunkSize;
+            job.end = (job.begin + chunkSize < count) ? job.begin + chunkSize : count;
+
+            // spread the chunks, stealing evens out the rest
+            Push(chunk % queues_.size(), job);
+        }
+
+        {
+            // taking the lock makes sure no worker is between checking its predicate and falling asleep
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+        }
+        wake_.notify_all();
+
+        // help out until everything is done
+        while (remaining.load(std::memory_order_acquire) != 0) {
+            if (!TryRunOne(0)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    struct Job {
+        void (*run)(void* context, size_t begin, size_t end, size_t threadIndex) = nullptr;
+        void* context = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+        std::atomic<size_t>* remaining = nullptr;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    template <typename F>
+    static void RunRange(void* context, size_t begin, size_t end, size_t threadIndex) {
+        (*static_cast<F*>(context))(begin, end, threadIndex);
+    }
+
+    void Push(size_t queueIndex, const Job& job);
+
+    // own queue first, then steal. false when there was nothing to do anywhere
+    bool TryRunOne(size_t threadIndex);
+
+    bool PopOwn(size_t threadIndex, Job& job);
+    bool Steal(size_t thiefIndex, Job& job);
+
+    void WorkerLoop(size_t threadIndex);
+
+    // queues_[0] belongs to the thread calling ParallelFor
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::atomic<size_t> queuedJobs_{ 0 };
+    std::atomic<bool> stopping_{ false };
+
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+};
@@ -0,0 +1,102 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <mutex>
+#include <string>
+
+#include "../Utils/LOG.h"
+
+// Memory for the things we create by the thousands.
+//
+// FixedBlockPool   blocks of one size, carved out of big chunks, recycled through a free list
+// PoolAllocator    one FixedBlockPool per size class. GameObject and Transform route their operator new / delete here
+//
+// Nothing here gives memory back to the system block by block.
+// That happens in bulk, PoolAllocator::ReleaseUnused once a room (GameState) is gone.
+
+class FixedBlockPool {
+public:
+    FixedBlockPool(size_t blockSize, size_t blocksPerChunk);
+    ~FixedBlockPool();
+
+    FixedBlockPool(const FixedBlockPool&) = delete;
+    FixedBlockPool& operator=(const FixedBlockPool&) = delete;
+
+    void* Allocate();
+    void Deallocate(void* block);
+
+    // frees every chunk, only allowed when nothing is alive
+    bool ReleaseIfUnused();
+
+    size_t GetBlockSize() const { return blockSize_; }
+    size_t GetLiveBlocks() const { return liveBlocks_; }
+    size_t GetPeakBlocks() const { return peakBlocks_; }
+    size_t GetReservedBytes() const { return chunks_.size() * blockSize_ * blocksPerChunk_; }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    void AddChunk();
+
+    size_t blockSize_;
+    size_t blocksPerChunk_;
+
+    std::vector<void*> chunks_;
+    FreeBlock* freeList_ = nullptr;
+
+    size_t liveBlocks_ = 0;
+    size_t peakBlocks_ = 0;
+};
+
+// Size classed pools behind class specific operator new / delete.
+// Sizes are rounded up to GRANULARITY, anything above MAX_POOLED_SIZE goes to the global heap.
+class PoolAllocator {
+public:
+    std::string GetName() const;
+
+private:
+    void log(LogLevel level, std::string text);
+
+public:
+    static constexpr size_t GRANULARITY = 16;
+    static constexpr size_t MAX_POOLED_SIZE = 1024;
+    static constexpr size_t N_SIZE_CLASSES = MAX_POOLED_SIZE / GRANULARITY;
+
+    static PoolAllocator& GetInstance();
+
+    void* Allocate(size_t size);
+    void Deallocate(void* ptr, size_t size);
+
+    // Bulk teardown. Gives back the chunks of every pool that has nothing alive anymore.
+    void ReleaseUnused();
+
+    void LogStats();
+
+private:
+    PoolAllocator();
+
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    FixedBlockPool& PoolFor(size_t size);
+
+    static size_t SizeClassOf(size_t size) {
+        return (size + GRANULARITY - 1) / GRANULARITY - 1;
+    }
+
+    // created lazily, most size classes are never used
+    std::array<FixedBlockPool*, N_SIZE_CLASSES> pools_{};
+
+    // objects are still created from network callbacks on the IO thread
+    std::mutex mutex_;
+};
+
+// Drop this into a class to have it (and everything derived from it) allocated from the PoolAllocator.
+// Derived classes have different sizes, the sized delete gets the real one through the virtual destructor.
+#define DECLARE_POOLED_NEW() \
+    static void* operator new(size_t size) { return PoolAllocator::GetInstance().Allocate(size); } \
+    static void operator delete(void* ptr, size_t size) { PoolAllocator::GetInstance().Deallocate(ptr, size); }
@@ -0,0 +1,160 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Core/GridTopology.h"
+#include "Utils/LOG.h"
+
+/*
+	Folding shapes other than the cube out of a grid, from a description instead of code.
+
+	A net is a set of faces, each a rectangle of cells of the grid, and gluings between their edges.
+	Walking off a face across a glued edge comes in on the other face, turned the way the gluing says,
+	like across the seams of the cube net (see GridTopology::LinkCubeNet). Edges that are not glued keep the torus links.
+
+	Edges are named by the direction you walk off the face: RIGHT, UP, LEFT, DOWN.
+	The cells along an edge are counted counterclockwise around their face (as drawn, y down):
+
+		RIGHT  bottom to top
+		UP     right to left
+		LEFT   top to bottom
+		DOWN   left to right
+
+	Two glued edges run against each other, cell t of one edge meets cell (length - 1 - t) of the other.
+	That is what keeps the surface orientable, and for neighbouring faces of a flat net it is simply the cell next door.
+
+	The shape in space is unfolded from faces[0]: every other face is hung on one already placed, along the edge they share,
+	bent by the fold angle of the gluing. 0 degrees: flat, 90: the faces of a cube. Gluings that close the shape only link cells.
+
+	Faces are made of square cells, so are the shapes: cubes, boxes, square prisms, and whatever else folds out of rectangles.
+	Triangles (an octahedron) don't fit a square grid.
+
+	Compiling is done once per shape. The result is two flat arrays, laid out like the CubeNet tables,
+	and can be written to a file and mapped back in later (Save / Load), or kept in memory and shared by every ridable of the shape.
+*/
+
+// a height x width block of cells of the grid, top left at (y, x)
+struct NetFace {
+	uint16_t y;
+	uint16_t x;
+	uint16_t height;
+	uint16_t width;
+};
+
+// Walking off faceA across edgeA comes in on faceB across edgeB, and back the same way.
+// the edges have to be equally long. foldDegrees: how far faceB is bent away from the plane of faceA, towards the back of faceA
+struct NetGluing {
+	uint8_t faceA;
+	Direction edgeA;
+	uint8_t faceB;
+	Direction edgeB;
+	float foldDegrees;
+};
+
+struct NetDescription {
+	uint16_t gridHeight = 0;
+	uint16_t gridWidth = 0;
+
+	std::vector<NetFace> faces;
+	std::vector<NetGluing> gluings;
+
+	// where the centre of cell (0, 0) of faces[0] goes, in cells. faces[0] lies flat, x along x, y along z, its front up (+y)
+	float origin[3] = { 0, 0, 0 };
+
+	// every face pushed this far along its front, in cells. the cube is drawn GROUND_OFFSET - 0.5 outside its surface
+	float inflate = 0;
+};
+
+// What MovementManager and GridTransformManager read, gridHeight * gridWidth of each, y * gridWidth + x.
+// Cells outside of every face keep the torus links and the identity matrix.
+struct CompiledNet {
+	uint16_t gridHeight = 0;
+	uint16_t gridWidth = 0;
+
+	std::vector<CellLink> links;
+	std::vector<CellMatrix> matrices;
+
+	// of the description it was compiled from, a cached file of another description is not used
+	uint64_t descriptionHash = 0;
+
+	// what it was compiled from, so that the shape can be sent and saved and compiled again on the other side.
+	// set by Compile and LoadOrCompile, not kept in the file (Load leaves it empty)
+	NetDescription description;
+
+	size_t GetCellCount() const {
+		return static_cast<size_t>(gridHeight) * gridWidth;
+	}
+};
+
+// Binary form of a CompiledNet (little endian, no pointers):
+//
+//   Header
+//   CellLink[cellCount]
+//   CellMatrix[cellCount]     8 byte aligned
+//
+// A change of layout means a new VERSION. Files of another version are compiled again, not guessed at.
+namespace NetFormat {
+	constexpr char MAGIC[8] = { 'D', 'F', 'N', 'E', 'T', '\0', '\0', '\0' };
+	constexpr uint32_t VERSION = 1;
+
+	struct Header {
+		char magic[8];
+		uint32_t version;
+		uint16_t gridHeight;
+		uint16_t gridWidth;
+		uint64_t descriptionHash;
+		uint32_t linkSize;
+		uint32_t matrixSize;
+		uint64_t linkOffset;
+		uint64_t matrixOffset;
+		uint64_t fileSize;
+	};
+}
+
+namespace NetCompiler {
+	// the biggest grid a description may ask for, about 84 MB of tables. descriptions come over the network and out of files,
+	// a bigger one is refused before anything is allocated for it. a cube of edge 255 has 390150 cells
+	constexpr size_t MAX_CELL_COUNT = size_t(1) << 20;
+
+	// false, and why in the log, if the description doesn't make a shape: grids over MAX_CELL_COUNT, faces off the grid or on top of each other,
+	// gluings of edges that don't match or are glued twice, faces not connected to faces[0]
+	bool Compile(const NetDescription& description, CompiledNet& net);
+
+	// same description, same hash. the fields, not the padding
+	uint64_t Hash(const NetDescription& description);
+
+	std::vector<uint8_t> Serialize(const CompiledNet& net);
+	// false if the file is damaged, links that lead off the grid included
+	bool Deserialize(const uint8_t* data, size_t size, CompiledNet& net);
+
+	// A description as bytes, what goes over the network (AddRidableObjectMessage) and into snapshots:
+	//   uint16 gridHeight, gridWidth, face count, gluing count
+	//   NetFace[faces]             4 x uint16
+	//   gluings                    uint8 faceA, edgeA, faceB, edgeB, float foldDegrees
+	//   float origin[3], inflate
+	std::vector<uint8_t> SerializeDescription(const NetDescription& description);
+	// false for damaged bytes and for grids over MAX_CELL_COUNT
+	bool DeserializeDescription(const uint8_t* data, size_t size, NetDescription& description);
+
+	// field by field, the floats bit for bit. what Hash can't promise
+	bool IsSameDescription(const NetDescription& a, const NetDescription& b);
+
+	bool Save(const CompiledNet& net, const std::string& path);
+	bool Load(const std::string& path, CompiledNet& net);
+
+	// The net of description from the file at cachePath if it was compiled from the same description,
+	// otherwise compiled and written there for next time. nullptr if it doesn't compile.
+	// Hand the result to every ridable of the shape, they share the tables (see RidableObject).
+	std::shared_ptr<const CompiledNet> LoadOrCompile(const NetDescription& description, const std::string& cachePath);
+
+	// The cube of GridTopology::LinkCubeNet as a net, at the same place in space as CubeNetCellMatrix puts it.
+	// Compiles to the CubeNet tables of that edge
+	NetDescription DescribeCube(uint16_t edge);
+
+	// A box of length x width x height cells, unfolded like the cube: the 4 sides in a row, then the top, then the bottom.
+	// length == width makes a square prism, all three the same a cube
+	NetDescription DescribeBox(uint16_t length, uint16_t width, uint16_t height);
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../Utils/LOG.h"
+
+// One way from a cell of one ridable's grid to a cell of another. A two way portal is two of these.
+struct Portal {
+    uint32_t fromGridID;
+    uint32_t fromCell;
+    uint32_t toGridID;
+    uint32_t toCell;
+    // how the facing turns on the way through
+    uint8_t rotation;
+};
+
+// Every portal of the world, for whoever thinks in grids instead of cells: pathfinding across grids,
+// interest management, persistence.
+//
+// Stepping through a portal doesn't come here, that is a lookup in the MovementManager of the grid (see PortalLink).
+// This is the same information turned around: grids are the nodes, portals the edges.
+// One sorted array, the portals out of a grid are next to each other.
+//
+// Game thread only.
+class PortalGraph {
+public:
+    std::string GetName() const;
+
+private:
+    void log(LogLevel level, std::string text);
+
+public:
+    // a run of portals in the array, valid until the next change
+    struct Range {
+        const Portal* first;
+        const Portal* last;
+
+        const Portal* begin() const {
+            return first;
+        }
+
+        const Portal* end() const {
+            return last;
+        }
+
+        size_t size() const {
+            return static_cast<size_t>(last - first);
+        }
+    };
+
+    PortalGraph() = default;
+
+    PortalGraph(const PortalGraph&) = delete;
+    PortalGraph& operator=(const PortalGraph&) = delete;
+
+    // replaces the portal that was at fromGridID, fromCell
+    void Add(const Portal& portal);
+
+    // false if there was none
+    bool Remove(uint32_t fromGridID, uint32_t fromCell);
+
+    // a ridable is gone. drops every portal out of and into its grid, appends them to removed
+    void RemoveGrid(uint32_t gridID, std::vector<Portal>& removed);
+
+    void Clear();
+
+    // the portals out of gridID, by cell
+    Range From(uint32_t gridID) const;
+
+    // nullptr if fromCell of fromGridID is not a portal
+    const Portal* Find(uint32_t fromGridID, uint32_t fromCell) const;
+
+    // The fewest portals from one grid to another, breadth first over the grids.
+    // route: the portal taken out of every grid on the way, in order. empty: the same grid. false: no way there
+    bool FindRoute(uint32_t fromGridID, uint32_t toGridID, std::vector<Portal>& route);
+
+    // all of them, by fromGridID then fromCell
+    const std::vector<Portal>& GetPortals() const {
+        return portals_;
+    }
+
+    size_t GetCount() const {
+        return portals_.size();
+    }
+
+private:
+    // first portal not before (gridID, cell)
+    std::vector<Portal>::const_iterator LowerBound(uint32_t gridID, uint32_t cell) const;
+
+    std::vector<Portal> portals_;
+
+    // scratch of FindRoute, kept for its capacity. f: grid -> the portal it was reached through
+    std::unordered_map<uint32_t, uint32_t> reachedBy_;
+    std::vector<uint32_t> frontier_;
+    std::vector<uint32_t> nextFrontier_;
+};
@@ -1,133 +1,174 @@
-#pragma once
-#include "GameObject.h"
-#include "GridManager.h"
-
-class RidableObject : public GameObject {
-public:
-	std::string GetName() const override;
-
-	virtual uint8_t GetTypeID();
-private:
-	uint8_t gridHeight_;
-	uint8_t gridWidth_;  
-
-	// f: Index -> ObjectID
-	std::vector<uint32_t> grid_;  
-
-	std::unique_ptr<MovementManager> movementManager_;  
-	std::unique_ptr<GridTransformManager> gridTransformManager_;  
-
-	
-
-public: 
-	RidableObject();
-
-	RidableObject(uint32_t objID, uint32_t meshID, uint32_t textureID, uint8_t cubeEdgeLength);
-
-	RidableObject(uint32_t objID, uint32_t meshID, uint32_t textureID, uint8_t gridHeight, uint8_t gridWidth);
-
-	void Initialize();
-
-	uint32_t GetObjectIDAt(Coord2d pos);
-	Coord2d GetPosition(uint32_t objID);
-	MovementManager* GetMovementManager();
-	GridTransformManager* GetGridTransformManager() {
-		return gridTransformManager_.get();
-	}
-	glm::mat4 GetGridTransformAt(uint8_t index) {
-		// interpolate value 
-
-		glm::mat4 resultMat = glm::mat4(1);
-
-		Coord2d coord = this->index_on_vector_to_coord2d(index);
-		Transform* currTransform = gridTransformManager_->grid2Transform[coord.first][coord.second];
-
-		glm::mat4 currTransformMat = currTransform->GetTransformMatrix();
-
-		// Calculate difference between current and previous transformations
-		glm::mat4 diff = currTransformMat - prevGridTransform_;
-
-		// Define a threshold for stopping interpolation
-		float threshold = 0.01f; // Adjust this value as needed
-
-		// Calculate the Frobenius norm of the difference matrix
-		float norm = glm::length(glm::vec4(diff[0]));
-		norm += glm::length(glm::vec4(diff[1]));
-		norm += glm::length(glm::vec4(diff[2]));
-		norm += glm::length(glm::vec4(diff[3]));
-
-		// Adjust interpolation factor based on the difference
-		float interpolationFactor = norm > threshold ? 0.5f : 0.0f;
-
-		resultMat = prevGridTransform_ * (1.0f - interpolationFactor) +
-			currTransformMat * interpolationFactor;
-
-		prevGridTransform_ = resultMat;
-
-		return resultMat;
-	}
-
-	std::vector<uint32_t>& GetGrid() {
-		return this->grid_; 
-	}
-
-	// Return iterator to beginning
-	std::vector<uint32_t>::iterator gridBegin() {
-		return grid_.begin();
-	}
-
-	// Return iterator to end
-	std::vector<uint32_t>::iterator gridEnd() {
-		return grid_.end();
-	}
-
-	// Return const iterator to beginning (for const objects)
-	std::vector<uint32_t>::const_iterator gridBegin() const {
-		return grid_.begin();
-	}
-
-	// Return const iterator to end (for const objects)
-	std::vector<uint32_t>::const_iterator gridEnd() const {
-		return grid_.end();
-	}
-
-	bool IsInBounds(int index);
-	bool IsPositionOccupied(Coord2d pos);
-
-	void SetObjIdAtPos(Coord2d pos, uint32_t objID);
-	void SetObjIdAtPos(uint8_t pos_index, uint32_t objID);
-	bool SetParentObjectAndExit(uint32_t newParentID);
-	
-	void SwapObjOnGrid(Coord2d a, Coord2d b);
-
-	// 2d index <-> 1d index 
-	uint8_t coord2d_to_index_on_vector(Coord2d pos); 
-	Coord2d index_on_vector_to_coord2d(uint8_t pos);
-
-	void AddChildObjectToGridAtPosition(uint32_t childID, Coord2d pos);
-
-	bool RemoveChildAtGrid(uint32_t childID); 
-
-private: 
-	void log_info() {
-		log(
-			LOG_INFO,
-			"\n  meshID: " + std::to_string(meshID_)
-			+ "\n  textureID: " + std::to_string(textureID_)
-			+ "\n  height: " + std::to_string(gridHeight_)
-			+ "\n  width: " + std::to_string(gridWidth_));
-	}
-};
-
-class PlayableObject : public RidableObject {
-public:
-
-	// server & client
-	uint8_t GetTypeID() override;;
-
-	void TakeAction(Direction direction);
-	void DropItem();
-	void RequestWalk();
-	void Walk();
-	void PickUpItem(Item* item);
+#pragma once
+#include <limits>
+#include <unordered_map>
+
+#include "GameObject.h"
+#include "GridManager.h"
+
+class RidableObject : public GameObject {
+public:
+	std::string GetName() const override;
+
+	virtual uint8_t GetTypeID();
+private:
+	uint16_t gridHeight_;
+	uint16_t gridWidth_;  
+	// built with the cubeEdgeLength constructor, the grid is the net of a cube
+	bool isCubeNet_ = false;
+	// built with the net constructor, what it is folded like. nullptr for cubes and tori
+	std::shared_ptr<const CompiledNet> net_;
+
+	// f: Index -> ObjectID, 0 empty
+	// the ids are generational handles (see SlotMap.h). One that outlived its object is stale, GameState::IsValidGameObject tells.
+	// chunked, a big grid with a few objects on it costs the chunks they stand in
+	ChunkedGrid<uint32_t> grid_;  
+
+	// f: ObjectID -> Index. The reverse of grid_, every non empty cell has exactly one entry.
+	// An object stands in at most one cell of a grid, the exit to our parent included.
+	// Written together with grid_ in WriteCell only
+	std::unordered_map<uint32_t, uint32_t> cellOfObject_;
+
+	std::unique_ptr<MovementManager> movementManager_;  
+	std::unique_ptr<GridTransformManager> gridTransformManager_;  
+
+	
+
+public: 
+	RidableObject();
+
+	RidableObject(uint32_t objID, uint32_t meshID, uint32_t textureID, uint8_t cubeEdgeLength);
+
+	RidableObject(uint32_t objID, uint32_t meshID, uint32_t textureID, uint16_t gridHeight, uint16_t gridWidth);
+
+	// folded like a compiled net (see NetCompiler), sharing its tables with every other ridable of the net.
+	// snapshots and the network carry the net's description, the other side compiles it again (GameState::GetNet)
+	RidableObject(uint32_t objID, uint32_t meshID, uint32_t textureID, std::shared_ptr<const CompiledNet> net);
+
+	void Initialize();
+
+	static constexpr uint32_t NO_CELL = std::numeric_limits<uint32_t>::max();
+
+	uint32_t GetObjectIDAt(Coord2d pos);
+	// {-1, -1} if objID is not on this grid
+	Coord2d GetPosition(uint32_t objID);
+
+	// index of the cell objID stands in, NO_CELL if it doesn't
+	uint32_t FindCell(uint32_t objID) const {
+		auto it = cellOfObject_.find(objID);
+		return it != cellOfObject_.end() ? it->second : NO_CELL;
+	}
+
+	// where the exit to our parent is, NO_CELL without a parent
+	uint32_t GetExitCell() const {
+		return parentID_ != 0 ? FindCell(parentID_) : NO_CELL;
+	}
+
+	// grid_ and cellOfObject_ agree. logs the first cell where they don't
+	bool IsGridIndexConsistent();
+	MovementManager* GetMovementManager();
+	GridTransformManager* GetGridTransformManager() {
+		return gridTransformManager_.get();
+	}
+	// the grid transform of a cell, straight out of the matrices of the GridTransformManager
+	glm::mat4 GetCellMatrix(uint32_t index) const {
+		return gridTransformManager_->GetCellMatrix(index);
+	}
+
+	// read only, every write goes through WriteCell. walk the occupied cells with ForEach
+	const ChunkedGrid<uint32_t>& GetGrid() const {
+		return this->grid_; 
+	}
+
+	uint16_t GetGridHeight() const {
+		return gridHeight_;
+	}
+
+	uint16_t GetGridWidth() const {
+		return gridWidth_;
+	}
+
+	size_t GetCellCount() const {
+		return grid_.GetCellCount();
+	}
+
+	bool IsCubeNet() const {
+		return isCubeNet_;
+	}
+
+	const std::shared_ptr<const CompiledNet>& GetNet() const {
+		return net_;
+	}
+
+	// one cell by its index, quiet about it (snapshot load, streaming). out of bounds does nothing
+	void SetObjIdAtCell(uint32_t cell, uint32_t objID);
+
+	// empties every cell, the exit included. a streamed sub world that was released, see SubWorldStreamer
+	void ClearGrid();
+
+	bool IsInBounds(int64_t index);
+	bool IsPositionOccupied(Coord2d pos);
+
+	// bulk occupancy, off the bits of the grid (see ChunkedGrid). the exit to our parent counts as occupied
+
+	// the first free cell at or after from, NO_CELL if the grid is full
+	uint32_t FindFreeCell(uint32_t from = 0) const {
+		return grid_.FindFirstEmpty(from);
+	}
+
+	size_t GetOccupiedCount() const {
+		return grid_.GetOccupiedCount();
+	}
+
+	// taken cells of the height x width rectangle at topLeft, clipped to the grid
+	size_t CountOccupiedIn(Coord2d topLeft, int height, int width) const {
+		if (topLeft.first < 0 || topLeft.second < 0 || height <= 0 || width <= 0) {
+			return 0;
+		}
+		return grid_.CountOccupied(topLeft.first, topLeft.second, height, width);
+	}
+
+	void SetObjIdAtPos(Coord2d pos, uint32_t objID);
+	void SetObjIdAtPos(uint32_t pos_index, uint32_t objID);
+	bool SetParentObjectAndExit(uint32_t newParentID);
+	
+	void SwapObjOnGrid(Coord2d a, Coord2d b);
+
+	// 2d index <-> 1d index 
+	uint32_t coord2d_to_index_on_vector(Coord2d pos); 
+	Coord2d index_on_vector_to_coord2d(uint32_t pos);
+
+	void AddChildObjectToGridAtPosition(uint32_t childID, Coord2d pos);
+
+	bool RemoveChildAtGrid(uint32_t childID); 
+
+private: 
+	// every write to grid_ goes through here. placing an object that already stands elsewhere on this grid moves it
+	void WriteCell(uint32_t cell, uint32_t objID);
+
+	// keeps the grid membership column of the ComponentStore in line with grid_
+	void OnCellChanged(uint32_t cell, uint32_t previousID, uint32_t newID);
+
+	void log_info() {
+		log(
+			LOG_INFO,
+			"\n  meshID: " + std::to_string(meshID_)
+			+ "\n  textureID: " + std::to_string(textureID_)
+			+ "\n  height: " + std::to_string(gridHeight_)
+			+ "\n  width: " + std::to_string(gridWidth_));
+	}
+};
+
+class PlayableObject : public RidableObject {
+public:
+	// what GetTypeID returns for every player object
+	static constexpr uint8_t TYPE_ID = 2;
+
+	// server & client
+	uint8_t GetTypeID() override;;
+
+	void TakeAction(Direction direction);
+	void DropItem();
+	void RequestWalk();
+	void Walk();
+	void PickUpItem(Item* item);
 };
\ No newline at end of file
@@ -0,0 +1,303 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+// Object ids are generational handles packed into 32 bits.
+//
+//   [ generation : 12 | slot index : 20 ]
+//
+// The slot index says where the object lives, the generation says which tenant of that slot it is.
+// A slot that is freed and reused gets the next generation, so an old id lying around
+// (on a grid, in a message, in a command) no longer matches and is detected as stale instead of pointing at a stranger.
+//
+// Slot 0 is never handed out, id 0 keeps meaning "nothing" everywhere (empty grid cell, no parent).
+// A fresh slot starts at generation 0, so the first ids are 1, 2, 3 ... exactly as before.
+namespace ObjectHandle {
+    constexpr uint32_t INDEX_BITS = 20;
+    constexpr uint32_t GENERATION_BITS = 32 - INDEX_BITS;
+
+    constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    constexpr uint32_t MAX_GENERATION = (1u << GENERATION_BITS) - 1;
+
+    constexpr uint32_t NONE = 0;
+
+    constexpr uint32_t Make(uint32_t index, uint32_t generation) {
+        return (generation << INDEX_BITS) | (index & INDEX_MASK);
+    }
+
+    constexpr uint32_t IndexOf(uint32_t handle) {
+        return handle & INDEX_MASK;
+    }
+
+    constexpr uint32_t GenerationOf(uint32_t handle) {
+        return handle >> INDEX_BITS;
+    }
+}
+
+// Slot map keyed by ObjectHandle.
+// Lookup is an array access and a generation compare. Freed slots are kept in a free list and reused.
+// The free list is doubly linked, InsertAt takes a slot out of its middle without walking it.
+//
+// The server allocates handles (Allocate / Insert), the client places what the server told it (InsertAt).
+template <typename T>
+class SlotMap {
+public:
+    SlotMap() {
+        // slot 0 is the "nothing" handle, it is never occupied
+        slots_.emplace_back();
+        slots_[0].retired = true;
+    }
+
+    // reserves a slot and returns its handle, the value can be filled in later with InsertAt
+    uint32_t Allocate() {
+        uint32_t index;
+
+        if (freeHead_ != NO_SLOT) {
+            index = freeHead_;
+            UnlinkFree(index);
+        }
+        else {
+            index = static_cast<uint32_t>(slots_.size());
+
+            if (index > ObjectHandle::INDEX_MASK) {
+                // out of slots
+                return ObjectHandle::NONE;
+            }
+
+            slots_.emplace_back();
+        }
+
+        Slot& slot = slots_[index];
+        slot.occupied = true;
+        size_++;
+
+        return ObjectHandle::Make(index, slot.generation);
+    }
+
+    uint32_t Insert(T value) {
+        uint32_t handle = Allocate();
+
+        if (handle != ObjectHandle::NONE) {
+            slots_[ObjectHandle::IndexOf(handle)].value = std::move(value);
+        }
+        return handle;
+    }
+
+    // Puts value exactly at handle.
+    // Whatever held the slot before (an older generation, or a reservation) is replaced.
+    void InsertAt(uint32_t handle, T value) {
+        uint32_t index = ObjectHandle::IndexOf(handle);
+
+        if (handle == ObjectHandle::NONE || index == 0) {
+            return;
+        }
+
+        if (index >= slots_.size()) {
+            // slots we skipped over are free for local allocation
+            for (uint32_t i = static_cast<uint32_t>(slots_.size()); i < index; i++) {
+                slots_.emplace_back();
+                PushFree(i);
+            }
+            slots_.emplace_back();
+        }
+        else if (!slots_[index].occupied) {
+            UnlinkFree(index);
+        }
+
+        Slot& slot = slots_[index];
+        if (!slot.occupied) {
+            size_++;
+        }
+
+        slot.occupied = true;
+        slot.retired = false;
+        slot.generation = ObjectHandle::GenerationOf(handle);
+        slot.value = std::move(value);
+    }
+
+    bool Contains(uint32_t handle) const {
+        uint32_t index = ObjectHandle::IndexOf(handle);
+
+        return index < slots_.size()
+            && slots_[index].occupied
+            && slots_[index].generation == ObjectHandle::GenerationOf(handle);
+    }
+
+    // nullptr for stale or unknown handles
+    T* Get(uint32_t handle) {
+        return Contains(handle) ? &slots_[ObjectHandle::IndexOf(handle)].value : nullptr;
+    }
+
+    const T* Get(uint32_t handle) const {
+        return Contains(handle) ? &slots_[ObjectHandle::IndexOf(handle)].value : nullptr;
+    }
+
+    // Frees the slot and bumps its generation. Every copy of handle is stale from now on.
+    // The value is moved out, so that the caller decides when it dies.
+    bool Remove(uint32_t handle, T* removedValue = nullptr) {
+        if (!Contains(handle)) {
+            return false;
+        }
+
+        uint32_t index = ObjectHandle::IndexOf(handle);
+        Slot& slot = slots_[index];
+
+        T value = std::move(slot.value);
+        slot.value = T();
+        slot.occupied = false;
+        size_--;
+
+        if (slot.generation == ObjectHandle::MAX_GENERATION) {
+            // all generations used up, never hand this slot out again rather than repeat a handle
+            slot.retired = true;
+        }
+        else {
+            slot.generation++;
+            PushFree(index);
+        }
+
+        if (removedValue != nullptr) {
+            *removedValue = std::move(value);
+        }
+        return true;
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    // handle of whoever occupies the slot at index, NONE if it is free
+    uint32_t HandleAt(uint32_t index) const {
+        if (index == 0 || index >= slots_.size() || !slots_[index].occupied) {
+            return ObjectHandle::NONE;
+        }
+        return ObjectHandle::Make(index, slots_[index].generation);
+    }
+
+    // calls f(handle, value) for every occupied slot, in slot order
+    template <typename F>
+    void ForEach(F&& f) {
+        for (uint32_t i = 1; i < slots_.size(); i++) {
+            if (slots_[i].occupied) {
+                f(ObjectHandle::Make(i, slots_[i].generation), slots_[i].value);
+            }
+        }
+    }
+
+    // Bookkeeping of one slot, what a snapshot needs to hand out the same handles after a restart.
+    struct SlotState {
+        uint32_t generation;
+        uint8_t occupied;
+        uint8_t retired;
+        uint16_t padding;
+    };
+
+    // including the reserved slot 0
+    uint32_t SlotCount() const {
+        return static_cast<uint32_t>(slots_.size());
+    }
+
+    SlotState GetSlotState(uint32_t index) const {
+        const Slot& slot = slots_[index];
+        return { slot.generation, static_cast<uint8_t>(slot.occupied), static_cast<uint8_t>(slot.retired), 0 };
+    }
+
+    // free slots in the order Allocate would hand them out
+    std::vector<uint32_t> GetFreeList() const {
+        std::vector<uint32_t> freeList;
+        for (uint32_t i = freeHead_; i != NO_SLOT; i = slots_[i].nextFree) {
+            freeList.push_back(i);
+        }
+        return freeList;
+    }
+
+    // Replaces everything with the bookkeeping from GetSlotState / GetFreeList.
+    // Occupied slots come back reserved (no value yet), InsertAt fills them without touching the free list.
+    void RestoreSlots(const SlotState* states, uint32_t count, const uint32_t* freeList, uint32_t freeCount) {
+        Clear();
+
+        slots_.resize(count > 0 ? count : 1);
+        slots_[0].retired = true;
+
+        for (uint32_t i = 1; i < count; i++) {
+            slots_[i].generation = states[i].generation;
+            slots_[i].occupied = states[i].occupied != 0;
+            slots_[i].retired = states[i].retired != 0;
+
+            if (slots_[i].occupied) {
+                size_++;
+            }
+        }
+
+        // rebuilt back to front, so that the head ends up first again
+        for (uint32_t i = freeCount; i > 0; i--) {
+            uint32_t index = freeList[i - 1];
+            if (index != 0 && index < slots_.size() && !slots_[index].occupied) {
+                PushFree(index);
+            }
+        }
+    }
+
+    // Destroys the values in slot order, then forgets every handle.
+    void Clear() {
+        for (uint32_t i = 1; i < slots_.size(); i++) {
+            slots_[i].value = T();
+        }
+        slots_.resize(1);
+        freeHead_ = NO_SLOT;
+        size_ = 0;
+    }
+
+private:
+    static constexpr uint32_t NO_SLOT = 0;
+
+    struct Slot {
+        T value{};
+        uint32_t generation = 0;
+        uint32_t nextFree = NO_SLOT;
+        uint32_t prevFree = NO_SLOT;
+        bool occupied = false;
+        bool retired = false;
+    };
+
+    void PushFree(uint32_t index) {
+        Slot& slot = slots_[index];
+        slot.nextFree = freeHead_;
+        slot.prevFree = NO_SLOT;
+
+        if (freeHead_ != NO_SLOT) {
+            slots_[freeHead_].prevFree = index;
+        }
+        freeHead_ = index;
+    }
+
+    // the head for Allocate, anywhere in the list when the server places an object into a slot we had on it
+    void UnlinkFree(uint32_t index) {
+        Slot& slot = slots_[index];
+
+        if (slot.prevFree == NO_SLOT && freeHead_ != index) {
+            // not on the list (retired, or left out of a restored one)
+            return;
+        }
+
+        if (slot.prevFree != NO_SLOT) {
+            slots_[slot.prevFree].nextFree = slot.nextFree;
+        }
+        else {
+            freeHead_ = slot.nextFree;
+        }
+
+        if (slot.nextFree != NO_SLOT) {
+            slots_[slot.nextFree].prevFree = slot.prevFree;
+        }
+
+        slot.nextFree = NO_SLOT;
+        slot.prevFree = NO_SLOT;
+    }
+
+    std::vector<Slot> slots_;
+    uint32_t freeHead_ = NO_SLOT;
+    size_t size_ = 0;
+};
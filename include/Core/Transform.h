@@ -1,35 +1,41 @@
-#pragma once
-#define GLM_ENABLE_EXPERIMENTAL
-#include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtx/quaternion.hpp> // For quaternion support
-
-class Transform {
-public:
-    Transform();
-    Transform(const Transform& other);
-
-    glm::mat4 GetTransformMatrix();
-
-    void SetTranslation(const glm::vec3& t);
-    void SetRotation(float radians, const glm::vec3& axis);
-    void AddRotation(float radians, const glm::vec3& axis); // calls addrotationleft
-    void AddRotationLeft(float radians, const glm::vec3& axis);  
-    void AddRotationRight(float radians, const glm::vec3& axis); 
-    void SetScale(const glm::vec3& s);
-
-    // Optional: Additional setters/getters if you want finer control
-    void SetRotationQuat(const glm::quat& q);
-    glm::vec3 GetTranslation() const;
-    glm::quat GetRotationQuat() const;
-    glm::vec3 GetScale() const;
-
-private:
-    glm::vec3 translation;
-    glm::quat rotation;
-    glm::vec3 scale;
-
-    bool dirty_flag = true; 
-
-    glm::mat4 transformMatrix;
+#pragma once
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtx/quaternion.hpp> // For quaternion support
+
+#include "MemoryPool.h"
+
+class Transform {
+public:
+    // every GameObject used to make its own with new
+    DECLARE_POOLED_NEW()
+
+    Transform();
+    Transform(const Transform& other) = default;
+    Transform& operator=(const Transform& other) = default;
+
+    glm::mat4 GetTransformMatrix();
+
+    void SetTranslation(const glm::vec3& t);
+    void SetRotation(float radians, const glm::vec3& axis);
+    void AddRotation(float radians, const glm::vec3& axis); // calls addrotationleft
+    void AddRotationLeft(float radians, const glm::vec3& axis);  
+    void AddRotationRight(float radians, const glm::vec3& axis); 
+    void SetScale(const glm::vec3& s);
+
+    // Optional: Additional setters/getters if you want finer control
+    void SetRotationQuat(const glm::quat& q);
+    glm::vec3 GetTranslation() const;
+    glm::quat GetRotationQuat() const;
+    glm::vec3 GetScale() const;
+
+private:
+    glm::vec3 translation;
+    glm::quat rotation;
+    glm::vec3 scale;
+
+    bool dirty_flag = true; 
+
+    glm::mat4 transformMatrix;
 };
\ No newline at end of file
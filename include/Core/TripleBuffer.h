@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// One writer, one reader, no locks.
+//
+// Three copies of T. The writer fills its back buffer and Publish() swaps it with the middle one.
+// The reader's AcquireLatest() swaps its front buffer with the middle one, but only if something new was published.
+// Neither side ever waits for the other, and neither ever sees a buffer the other one is working on.
+// The reader may see the same T twice (nothing new yet) or skip some (writer was faster), but never a half written one.
+//
+// The buffers are reused, a T made of vectors keeps its capacity from one round to the next.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // writer side. the buffer still holds whatever was written into it two publishes ago
+    T& GetBackBuffer() {
+        return buffers_[back_];
+    }
+
+    void Publish() {
+        uint8_t previousMiddle = middle_.exchange(static_cast<uint8_t>(back_ | NEW_DATA), std::memory_order_acq_rel);
+        back_ = previousMiddle & INDEX_MASK;
+    }
+
+    // reader side. the latest published buffer, stays valid until the next AcquireLatest
+    const T& AcquireLatest() {
+        if (middle_.load(std::memory_order_acquire) & NEW_DATA) {
+            uint8_t previousMiddle = middle_.exchange(front_, std::memory_order_acq_rel);
+            front_ = previousMiddle & INDEX_MASK;
+        }
+        return buffers_[front_];
+    }
+
+    bool HasNewData() const {
+        return (middle_.load(std::memory_order_acquire) & NEW_DATA) != 0;
+    }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t NEW_DATA = 0x4;
+
+    T buffers_[3];
+
+    // only touched by the writer
+    uint8_t back_ = 0;
+    // shared. buffer index + whether the reader has seen it yet
+    std::atomic<uint8_t> middle_{ 1 };
+    // only touched by the reader
+    uint8_t front_ = 2;
+};
@@ -0,0 +1,140 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../Utils/LOG.h"
+#include "../Utils/ListenerProfiler.h"
+
+// What happened to the GameState during one tick.
+//
+// Every mutation (spawn, remove, reparent, grid slot change, transform change) appends one small record.
+// At the end of the tick Publish() hands the whole journal to the consumers
+// (replication, the renderer's matrix cache, metrics, persistence) and starts the next tick with an empty one.
+// Consumers only look at what changed instead of rescanning or diffing the state.
+//
+// The idle spin of ComponentStore::Spin is not journaled, it changes every object every tick.
+// Consumers that care about it (the renderer) read the store after UpdateGameState anyway.
+
+enum class ChangeType : uint8_t {
+    SPAWN,      // objectID, typeID
+    REMOVE,     // objectID, typeID
+    REPARENT,   // objectID, other = new parentID
+    GRID_SLOT,  // objectID = owner of the grid, cell, other = who stands there now (0: empty)
+    TRANSFORM,  // objectID. at most once per object per tick
+    LAST
+};
+
+struct ChangeRecord {
+    ChangeType type;
+    uint8_t flags;
+    uint8_t typeID;
+    uint8_t padding = 0;
+    uint32_t objectID;
+    uint32_t cell;
+    uint32_t other;
+};
+
+class ChangeJournal {
+public:
+    std::string GetName() const;
+
+private:
+    void log(LogLevel level, std::string text);
+
+public:
+    // the change came from the network (or from a message that is rebroadcast as is), replication skips it
+    static constexpr uint8_t FROM_NETWORK = 1 << 0;
+
+    using Consumer = std::function<void(const ChangeJournal& journal)>;
+
+    ChangeJournal() = default;
+
+    ChangeJournal(const ChangeJournal&) = delete;
+    ChangeJournal& operator=(const ChangeJournal&) = delete;
+
+    void RecordSpawn(uint32_t objectID, uint8_t typeID, bool fromNetwork);
+    void RecordRemove(uint32_t objectID, uint8_t typeID, bool fromNetwork);
+    void RecordReparent(uint32_t objectID, uint32_t parentID);
+    void RecordGridSlot(uint32_t gridOwnerID, uint32_t cell, uint32_t occupantID);
+    void RecordTransform(uint32_t objectID);
+
+    // the records of the tick being published, for consumers
+    const std::vector<ChangeRecord>& GetRecords() const {
+        return published_;
+    }
+
+    // the tick being published
+    uint64_t GetTick() const {
+        return publishedTick_;
+    }
+
+    size_t GetPendingCount() const {
+        return records_.size();
+    }
+
+    // Consumers run in the order they subscribed, on the thread calling Publish (the game thread).
+    // The name shows up in ListenerProfiler as "ChangeJournal/<name>".
+    void Subscribe(const std::string& name, Consumer consumer);
+
+    // Hands this tick's records to every consumer and starts the next tick.
+    // Whatever a consumer changes in the meantime is recorded for the next tick.
+    void Publish();
+
+    // drops the records without publishing them
+    void Clear();
+
+    void LogStats();
+
+    // inside a FromNetworkScope. commands queued for later remember it, see CommandBuffer
+    bool IsFromNetwork() const {
+        return fromNetworkDepth_ > 0;
+    }
+
+    // Everything recorded while one of these is alive is marked FROM_NETWORK.
+    // For commands whose message is forwarded to the clients anyway, ex) GameServer::handle_message_event
+    class FromNetworkScope {
+    public:
+        explicit FromNetworkScope(ChangeJournal& journal)
+            : journal_(journal) {
+            journal_.fromNetworkDepth_++;
+        }
+
+        ~FromNetworkScope() {
+            journal_.fromNetworkDepth_--;
+        }
+
+        FromNetworkScope(const FromNetworkScope&) = delete;
+        FromNetworkScope& operator=(const FromNetworkScope&) = delete;
+
+    private:
+        ChangeJournal& journal_;
+    };
+
+private:
+    void Append(ChangeType type, uint8_t typeID, uint32_t objectID, uint32_t cell, uint32_t other, bool fromNetwork);
+
+    struct ConsumerEntry {
+        Consumer consumer;
+        ListenerStats* stats;
+    };
+
+    // recording into records_, consumers read published_. swapped on Publish, both keep their capacity
+    std::vector<ChangeRecord> records_;
+    std::vector<ChangeRecord> published_;
+    std::vector<ConsumerEntry> consumers_;
+
+    // the tick being recorded
+    uint64_t tick_ = 0;
+    uint64_t publishedTick_ = 0;
+    int fromNetworkDepth_ = 0;
+
+    // slot index of the object -> tick + 1 of its last TRANSFORM record
+    std::vector<uint64_t> transformRecordedAt_;
+
+    // metrics
+    std::array<uint64_t, static_cast<size_t>(ChangeType::LAST)> totals_{};
+    size_t peakRecordsPerTick_ = 0;
+};
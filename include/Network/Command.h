@@ -1,219 +1,372 @@
-#pragma once
-#include <cstdint>
-#include <memory>
-#include "../Core/PlayerDirection.h"
-#include "../Utils/LOG.h"
-#include "../Core/GameObject.h"
-#include "../Core/RidableObject.h"
-#include "GameState.h"
-
-// Forward declarations 
-class GameState;
-
-// Messages <-> Commands 
-// Messages correspond to commands 
-// however Messages only act on our brain. 
-// We make it possible for Messages to act upon States by 
-// Processing Messages to Commands which can directly act on GameStates 
-
-// Abstract base class for all game commands
-// GameState -> GameState
-class IGameCommand { 
-public:
-    std::string GetName() const;
-
-protected:
-    virtual void log(LogLevel level, std::string text); 
-
-public: 
-    virtual ~IGameCommand() = default; 
-    virtual void Execute(GameState& gameState) = 0; 
-}; 
-
-//// Example command for updating player position
-//// GameState -> GameState
-//class UpdatePlayerPositionCommand : public IGameCommand {
-//    float x, y, z;
-//    uint32_t player_id;
-//
-//public:
-//    UpdatePlayerPositionCommand(float x, float y, float z, uint32_t id)
-//        : x(x), y(y), z(z), player_id(id) {}
-//
-//    void Execute(GameState& gameState) override {
-//        // Update player position in game state
-//        // This is where the actual state modification happens
-//        gameState.UpdatePlayerPosition(player_id, x, y, z);
-//    }
-//};
-class UdpVerificationCommand : public IGameCommand {
-    uint32_t session_id;
-
-    // Keeping the 64-bit verification code
-    uint64_t verification_code;
-
-    // Keeping the 64-bit timestamp
-    uint64_t timestamp; 
-
-public: 
-    UdpVerificationCommand(
-        uint32_t session_id, 
-        uint64_t verification_code, 
-        uint64_t timestamp 
-    );
-
-    void Execute(GameState& gameState) override;
-};
-
-class PlayerInputCommand : public IGameCommand {
-    Direction user_input; 
-    uint32_t player_id; 
-
-public: 
-    PlayerInputCommand(Direction userInput, uint32_t playerID);
-
-    void Execute(GameState& gameState) override;
-}; 
-
-class AddGameObjectCommand : public IGameCommand {
-    uint8_t gameobject_type_id; 
-    uint32_t gameobject_id; 
-
-public: 
-    AddGameObjectCommand(uint8_t gameObjectTypeID, uint32_t gameObjectID);
-
-    void Execute(GameState& gameState) override;
-};
-
-class RemoveGameObjectCommand : public IGameCommand {
-    uint32_t gameobject_id; 
-
-public: 
-    RemoveGameObjectCommand(uint32_t gameObjectID);
-
-    void Execute(GameState& gameState) override;
-};
-
-class GameObjectPositionCommand : public IGameCommand {
-    int y_coord; 
-    int x_coord; 
-
-    uint32_t gameobject_id;  
-
-public: 
-    GameObjectPositionCommand(int y, int x, uint32_t gameObjectID);
-
-    void Execute(GameState& gameState) override;
-};
-
-class GameObjectParentCommand : public IGameCommand {
-    uint32_t parent_object_id; 
-    uint32_t gameobject_id; 
-
-public: 
-    GameObjectParentCommand(uint32_t parentObjectID, uint32_t gameObjectID);
-
-    void Execute(GameState& gameState) override;
-}; 
-
-// v1.0 ----------------------------------------------------
-class AddRidableObjectCommand : public IGameCommand {
-    uint32_t objID_;
-    uint32_t meshID_;
-    uint32_t textureID_;
-    uint8_t gridHeight_;
-    uint8_t gridWidth_;
-public:
-    std::string GetName() const {
-        return "AddRidableObjectCommand";
-    }
-public:
-    AddRidableObjectCommand(
-        uint32_t objID,
-        uint32_t meshID,
-        uint32_t textureID,
-        uint8_t gridHeight,
-        uint8_t gridWidth
-    ) :
-        objID_(objID),
-        meshID_(meshID),
-        textureID_(textureID),
-        gridHeight_(gridHeight),
-        gridWidth_(gridWidth)
-    {}
-
-    void Execute(GameState& gameState) override {
-        gameState.AddRidableObject(
-            objID_,
-            meshID_,
-            textureID_,
-            gridHeight_,
-            gridWidth_
-        );
-    }
-};
-
-class WalkOnRidableObjectCommand : public IGameCommand {
-    uint32_t walkerID;
-
-    Direction direction;
-
-
-    // -----------------------------
-    GameState* tempGameState;
-public:
-    std::string GetName() const {
-        return "WalkOnRidableObjectCommand";
-    }
-
-public:
-    WalkOnRidableObjectCommand(uint32_t walkerID, Direction direction)
-        : walkerID(walkerID), direction(direction), tempGameState(nullptr) {}
-
-    void Execute(GameState& gameState) override; 
-    void Interact(RidableObject* who, Direction did_what, GameObject* to_whom);
-    void Walk(RidableObject* who, Direction to_where, Coord2d from_where, RidableObject* walking_on); 
-};
-
-class RideOnRidableObjectCommand : public IGameCommand {
-    uint32_t vehicleID;
-    uint32_t riderID;
-
-    uint8_t rideAt;
-
-public:
-    std::string GetName() const {
-        return "RideOnRidableObjectCommand";
-    }
-public:
-    RideOnRidableObjectCommand(uint32_t vehicleID, uint32_t riderID, uint8_t rideAt)
-        : vehicleID(vehicleID), riderID(riderID), rideAt(rideAt) {
-        // Construct the log message as a single string
-        std::string log_message = "RideOnRidableObjectCommand: vehicleID="
-            + std::to_string(vehicleID)
-            + ", riderID="
-            + std::to_string(riderID)
-            + ", rideAt="
-            + std::to_string(static_cast<int>(rideAt));
-
-        log(LOG_INFO, log_message);
-    }
-
-    void Execute(GameState& gameState) override {
-        log(LOG_INFO, "Executing Command --------------------------------------------------");
-        RidableObject* vehicleObj = dynamic_cast<RidableObject*>(gameState.GetGameObject(vehicleID));  
-        
-        // I am torn between whether I should let Non-ridable objects Ride.
-        // I made up this rule to settle my mind. 
-        // You can only ride, if you let others ride yourself. 
-        RidableObject* riderObj = dynamic_cast<RidableObject*>(gameState.GetGameObject(riderID)); 
-
-        riderObj->SetParentObjectAndExit(vehicleID); 
-
-        vehicleObj->SetObjIdAtPos(rideAt, riderID);
-        log(LOG_INFO, "--------------------------------------------------------------------");
-        return; 
-    }
-    
-};
-
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "../Core/PlayerDirection.h"
+#include "../Utils/LOG.h"
+#include "../Core/GameObject.h"
+#include "../Core/RidableObject.h"
+#include "GameState.h"
+
+// Forward declarations 
+class GameState;
+
+// Messages <-> Commands 
+// Messages correspond to commands 
+// however Messages only act on our brain. 
+// We make it possible for Messages to act upon States by 
+// Processing Messages to Commands which can directly act on GameStates 
+
+// Abstract base class for all game commands
+// GameState -> GameState
+class IGameCommand { 
+public:
+    std::string GetName() const;
+
+protected:
+    virtual void log(LogLevel level, std::string text); 
+
+public: 
+    virtual ~IGameCommand() = default; 
+    virtual void Execute(GameState& gameState) = 0; 
+}; 
+
+//// Example command for updating player position
+//// GameState -> GameState
+//class UpdatePlayerPositionCommand : public IGameCommand {
+//    float x, y, z;
+//    uint32_t player_id;
+//
+//public:
+//    UpdatePlayerPositionCommand(float x, float y, float z, uint32_t id)
+//        : x(x), y(y), z(z), player_id(id) {}
+//
+//    void Execute(GameState& gameState) override {
+//        // Update player position in game state
+//        // This is where the actual state modification happens
+//        gameState.UpdatePlayerPosition(player_id, x, y, z);
+//    }
+//};
+class UdpVerificationCommand : public IGameCommand {
+    uint32_t session_id;
+
+    // Keeping the 64-bit verification code
+    uint64_t verification_code;
+
+    // Keeping the 64-bit timestamp
+    uint64_t timestamp; 
+
+public: 
+    UdpVerificationCommand(
+        uint32_t session_id, 
+        uint64_t verification_code, 
+        uint64_t timestamp 
+    );
+
+    void Execute(GameState& gameState) override;
+};
+
+class PlayerInputCommand : public IGameCommand {
+    Direction user_input; 
+    uint32_t player_id; 
+
+public: 
+    PlayerInputCommand(Direction userInput, uint32_t playerID);
+
+    void Execute(GameState& gameState) override;
+}; 
+
+class AddGameObjectCommand : public IGameCommand {
+    uint8_t gameobject_type_id; 
+    uint32_t gameobject_id; 
+
+public: 
+    AddGameObjectCommand(uint8_t gameObjectTypeID, uint32_t gameObjectID);
+
+    void Execute(GameState& gameState) override;
+};
+
+class RemoveGameObjectCommand : public IGameCommand {
+    uint32_t gameobject_id; 
+
+public: 
+    RemoveGameObjectCommand(uint32_t gameObjectID);
+
+    void Execute(GameState& gameState) override;
+};
+
+class GameObjectPositionCommand : public IGameCommand {
+    int y_coord; 
+    int x_coord; 
+
+    uint32_t gameobject_id;  
+
+public: 
+    GameObjectPositionCommand(int y, int x, uint32_t gameObjectID);
+
+    void Execute(GameState& gameState) override;
+};
+
+class GameObjectParentCommand : public IGameCommand {
+    uint32_t parent_object_id; 
+    uint32_t gameobject_id; 
+
+public: 
+    GameObjectParentCommand(uint32_t parentObjectID, uint32_t gameObjectID);
+
+    void Execute(GameState& gameState) override;
+}; 
+
+// v1.0 ----------------------------------------------------
+class AddRidableObjectCommand : public IGameCommand {
+    uint32_t objID_;
+    uint32_t meshID_;
+    uint32_t textureID_;
+    uint16_t gridHeight_;
+    uint16_t gridWidth_;
+    // the description of its net, see AddRidableObjectMessage::net_. empty for cubes and tori
+    std::vector<uint8_t> net_;
+public:
+    std::string GetName() const {
+        return "AddRidableObjectCommand";
+    }
+public:
+    AddRidableObjectCommand(
+        uint32_t objID,
+        uint32_t meshID,
+        uint32_t textureID,
+        uint16_t gridHeight,
+        uint16_t gridWidth,
+        std::vector<uint8_t> net = {}
+    ) :
+        objID_(objID),
+        meshID_(meshID),
+        textureID_(textureID),
+        gridHeight_(gridHeight),
+        gridWidth_(gridWidth),
+        net_(std::move(net))
+    {}
+
+    void Execute(GameState& gameState) override {
+        if (!net_.empty()) {
+            NetDescription description;
+            if (!NetCompiler::DeserializeDescription(net_.data(), net_.size(), description)) {
+                LOG(LOG_ERROR, GetName() + "::Execute the net of ridable " + std::to_string(objID_) + " is damaged, not added");
+                return;
+            }
+            gameState.AddRidableObject(objID_, meshID_, textureID_, description);
+            return;
+        }
+
+        gameState.AddRidableObject(
+            objID_,
+            meshID_,
+            textureID_,
+            gridHeight_,
+            gridWidth_
+        );
+    }
+};
+
+class WalkOnRidableObjectCommand : public IGameCommand {
+    uint32_t walkerID;
+
+    Direction direction;
+
+
+    // -----------------------------
+    GameState* tempGameState;
+public:
+    std::string GetName() const {
+        return "WalkOnRidableObjectCommand";
+    }
+
+public:
+    WalkOnRidableObjectCommand(uint32_t walkerID, Direction direction)
+        : walkerID(walkerID), direction(direction), tempGameState(nullptr) {}
+
+    void Execute(GameState& gameState) override; 
+    // to_whom stands on the grid of where, the walker's own grid or the far end of a portal
+    void Interact(RidableObject* who, Direction did_what, GameObject* to_whom, RidableObject* where);
+    void Walk(RidableObject* who, Direction to_where, Coord2d from_where, RidableObject* walking_on); 
+};
+
+// lockstep. hand what came in to the GameState's LockstepController, see Network/Lockstep.h
+class LockstepInputCommand : public IGameCommand {
+    uint32_t peerID;
+    uint32_t walkerID;
+    uint64_t newestTick;
+    std::vector<Direction> directions;
+
+public:
+    std::string GetName() const {
+        return "LockstepInputCommand";
+    }
+
+public:
+    LockstepInputCommand(uint32_t peerID, uint32_t walkerID, uint64_t newestTick, std::vector<Direction> directions)
+        : peerID(peerID), walkerID(walkerID), newestTick(newestTick), directions(std::move(directions)) {}
+
+    void Execute(GameState& gameState) override;
+};
+
+class StateHashCommand : public IGameCommand {
+    uint32_t peerID;
+    uint64_t tick;
+    uint64_t hash;
+
+public:
+    std::string GetName() const {
+        return "StateHashCommand";
+    }
+
+public:
+    StateHashCommand(uint32_t peerID, uint64_t tick, uint64_t hash)
+        : peerID(peerID), tick(tick), hash(hash) {}
+
+    void Execute(GameState& gameState) override;
+};
+
+class StateManifestCommand : public IGameCommand {
+    uint32_t peerID;
+    uint64_t tick;
+    uint32_t firstEntry;
+    uint32_t totalEntries;
+    std::vector<uint32_t> objectIDs;
+    std::vector<uint64_t> objectHashes;
+
+public:
+    std::string GetName() const {
+        return "StateManifestCommand";
+    }
+
+public:
+    StateManifestCommand(uint32_t peerID, uint64_t tick, uint32_t firstEntry, uint32_t totalEntries,
+        std::vector<uint32_t> objectIDs, std::vector<uint64_t> objectHashes)
+        : peerID(peerID), tick(tick), firstEntry(firstEntry), totalEntries(totalEntries),
+        objectIDs(std::move(objectIDs)), objectHashes(std::move(objectHashes)) {}
+
+    void Execute(GameState& gameState) override;
+};
+
+// client. the first table starts the match here: the other peers' player objects are created and the controller enabled
+class LockstepPeersCommand : public IGameCommand {
+    std::vector<uint32_t> peerIDs;
+    std::vector<uint32_t> walkerIDs;
+    std::vector<uint64_t> firstTicks;
+
+public:
+    std::string GetName() const {
+        return "LockstepPeersCommand";
+    }
+
+public:
+    LockstepPeersCommand(std::vector<uint32_t> peerIDs, std::vector<uint32_t> walkerIDs, std::vector<uint64_t> firstTicks)
+        : peerIDs(std::move(peerIDs)), walkerIDs(std::move(walkerIDs)), firstTicks(std::move(firstTicks)) {}
+
+    void Execute(GameState& gameState) override;
+};
+
+// sub world streaming, client side. see Network/SubWorldStreamer.h
+class GridSlotCommand : public IGameCommand {
+    uint32_t ownerID;
+    uint32_t cell;
+    uint32_t occupantID;
+
+public:
+    std::string GetName() const {
+        return "GridSlotCommand";
+    }
+
+public:
+    GridSlotCommand(uint32_t ownerID, uint32_t cell, uint32_t occupantID)
+        : ownerID(ownerID), cell(cell), occupantID(occupantID) {}
+
+    void Execute(GameState& gameState) override;
+};
+
+class SubWorldReleaseCommand : public IGameCommand {
+    uint32_t ownerID;
+
+public:
+    std::string GetName() const {
+        return "SubWorldReleaseCommand";
+    }
+
+public:
+    SubWorldReleaseCommand(uint32_t ownerID)
+        : ownerID(ownerID) {}
+
+    void Execute(GameState& gameState) override;
+};
+
+// a two way portal, see GameState::CreatePortalOnGridAt
+class CreatePortalCommand : public IGameCommand {
+    uint32_t ridableID;
+    uint16_t y;
+    uint16_t x;
+    uint32_t toRidableID;
+    uint16_t toY;
+    uint16_t toX;
+    uint8_t rotation;
+
+public:
+    std::string GetName() const {
+        return "CreatePortalCommand";
+    }
+
+public:
+    CreatePortalCommand(uint32_t ridableID, uint16_t y, uint16_t x, uint32_t toRidableID, uint16_t toY, uint16_t toX, uint8_t rotation)
+        : ridableID(ridableID), y(y), x(x), toRidableID(toRidableID), toY(toY), toX(toX), rotation(rotation) {}
+
+    void Execute(GameState& gameState) override;
+};
+
+class RideOnRidableObjectCommand : public IGameCommand {
+    uint32_t vehicleID;
+    uint32_t riderID;
+
+    uint32_t rideAt;
+
+public:
+    std::string GetName() const {
+        return "RideOnRidableObjectCommand";
+    }
+public:
+    RideOnRidableObjectCommand(uint32_t vehicleID, uint32_t riderID, uint32_t rideAt)
+        : vehicleID(vehicleID), riderID(riderID), rideAt(rideAt) {
+        // Construct the log message as a single string
+        std::string log_message = "RideOnRidableObjectCommand: vehicleID="
+            + std::to_string(vehicleID)
+            + ", riderID="
+            + std::to_string(riderID)
+            + ", rideAt="
+            + std::to_string(rideAt);
+
+        log(LOG_INFO, log_message);
+    }
+
+    void Execute(GameState& gameState) override {
+        log(LOG_INFO, "Executing Command --------------------------------------------------");
+        RidableObject* vehicleObj = dynamic_cast<RidableObject*>(gameState.GetGameObject(vehicleID));  
+        
+        // I am torn between whether I should let Non-ridable objects Ride.
+        // I made up this rule to settle my mind. 
+        // You can only ride, if you let others ride yourself. 
+        RidableObject* riderObj = dynamic_cast<RidableObject*>(gameState.GetGameObject(riderID)); 
+
+        if (vehicleObj == nullptr || riderObj == nullptr) {
+            // unknown or stale ids, or not ridable 
+            log(LOG_ERROR, "Vehicle or rider is not a valid RidableObject");
+            return;
+        }
+
+        riderObj->SetParentObjectAndExit(vehicleID); 
+
+        vehicleObj->SetObjIdAtPos(rideAt, riderID);
+        log(LOG_INFO, "--------------------------------------------------------------------");
+        return; 
+    }
+    
+};
+
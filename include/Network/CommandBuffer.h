@@ -0,0 +1,206 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../Core/PlayerDirection.h"
+#include "../Utils/LOG.h"
+
+class GameState;
+
+// Commands as plain data, written back to back into one byte buffer.
+//
+// Every message that changes the state becomes a small record (header + the fields of its command) instead of
+// a heap allocated IGameCommand. A tick's records are executed in the order they were pushed, in one pass,
+// and the buffer is reset for the next tick. It keeps its capacity, so after the first few ticks
+// pushing a command is a memcpy, whatever the allocator is doing.
+//
+// Messages that can't wait for the next tick (handshake, lockstep inputs and hashes) and the ones with
+// variable length still go through GameMessageProcessor::ProcessMessage.
+enum class CommandType : uint8_t {
+    PLAYER_INPUT,
+    ADD_GAMEOBJECT,
+    REMOVE_GAMEOBJECT,
+    GAMEOBJECT_POSITION,
+    GAMEOBJECT_PARENT,
+    ADD_RIDABLE_OBJECT,
+    WALK_ON_RIDABLE_OBJECT,
+    RIDE_ON_RIDABLE_OBJECT,
+    GRID_SLOT,
+    SUBWORLD_RELEASE,
+    CREATE_PORTAL,
+    LAST
+};
+
+struct PlayerInputRecord {
+    static constexpr CommandType TYPE = CommandType::PLAYER_INPUT;
+    uint32_t playerID;
+    Direction direction;
+};
+
+struct AddGameObjectRecord {
+    static constexpr CommandType TYPE = CommandType::ADD_GAMEOBJECT;
+    uint32_t objectID;
+    uint8_t typeID;
+};
+
+struct RemoveGameObjectRecord {
+    static constexpr CommandType TYPE = CommandType::REMOVE_GAMEOBJECT;
+    uint32_t objectID;
+};
+
+struct GameObjectPositionRecord {
+    static constexpr CommandType TYPE = CommandType::GAMEOBJECT_POSITION;
+    uint32_t objectID;
+    int32_t y;
+    int32_t x;
+};
+
+struct GameObjectParentRecord {
+    static constexpr CommandType TYPE = CommandType::GAMEOBJECT_PARENT;
+    uint32_t objectID;
+    uint32_t parentID;
+};
+
+struct AddRidableObjectRecord {
+    static constexpr CommandType TYPE = CommandType::ADD_RIDABLE_OBJECT;
+    uint32_t objectID;
+    uint32_t meshID;
+    uint32_t textureID;
+    uint16_t gridHeight;
+    uint16_t gridWidth;
+};
+
+struct WalkOnRidableObjectRecord {
+    static constexpr CommandType TYPE = CommandType::WALK_ON_RIDABLE_OBJECT;
+    uint32_t walkerID;
+    Direction direction;
+};
+
+struct RideOnRidableObjectRecord {
+    static constexpr CommandType TYPE = CommandType::RIDE_ON_RIDABLE_OBJECT;
+    uint32_t vehicleID;
+    uint32_t riderID;
+    uint32_t rideAt;
+};
+
+struct GridSlotRecord {
+    static constexpr CommandType TYPE = CommandType::GRID_SLOT;
+    uint32_t ownerID;
+    uint32_t cell;
+    uint32_t occupantID;
+};
+
+struct SubWorldReleaseRecord {
+    static constexpr CommandType TYPE = CommandType::SUBWORLD_RELEASE;
+    uint32_t ownerID;
+};
+
+struct CreatePortalRecord {
+    static constexpr CommandType TYPE = CommandType::CREATE_PORTAL;
+    uint32_t ridableID;
+    uint32_t toRidableID;
+    uint16_t y;
+    uint16_t x;
+    uint16_t toY;
+    uint16_t toX;
+    uint8_t rotation;
+};
+
+struct CommandHeader {
+    CommandType type;
+    uint8_t flags;
+    // of the payload, without the header and the padding
+    uint16_t size;
+    // the object that pushed it, see DeferredCommandBuffer. 0 for commands from the network
+    uint32_t issuer;
+};
+
+class CommandBuffer {
+public:
+    std::string GetName() const;
+
+private:
+    void log(LogLevel level, std::string text);
+
+public:
+    // run the command inside a ChangeJournal::FromNetworkScope
+    static constexpr uint8_t FROM_NETWORK = 1 << 0;
+
+    // records start at multiples of this
+    static constexpr size_t ALIGNMENT = 8;
+
+    CommandBuffer() = default;
+
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+    CommandBuffer(CommandBuffer&&) noexcept = default;
+    CommandBuffer& operator=(CommandBuffer&&) noexcept = default;
+
+    // the object being updated, records pushed from now on carry its id
+    void SetIssuer(uint32_t objectID) {
+        issuer_ = objectID;
+    }
+
+    template <typename Record>
+    void Push(const Record& record, uint8_t flags = 0) {
+        static_assert(std::is_trivially_copyable<Record>::value, "command records are copied as bytes");
+        static_assert(sizeof(Record) <= std::numeric_limits<uint16_t>::max(), "command record too large");
+
+        Append(Record::TYPE, flags, &record, sizeof(Record));
+    }
+
+    // runs every record in push order, then resets.
+    // whatever the commands push in the meantime is kept for the next Execute
+    void Execute(GameState& gameState);
+
+    // drops the records, keeps the memory
+    void Reset();
+
+    bool Empty() const {
+        return count_ == 0;
+    }
+
+    // records, not bytes
+    size_t Size() const {
+        return count_;
+    }
+
+    const std::vector<uint8_t>& GetBytes() const {
+        return bytes_;
+    }
+
+    // f(const CommandHeader&, const uint8_t* payload) for every record, in push order
+    template <typename F>
+    void ForEach(F&& f) const {
+        size_t offset = 0;
+        while (offset < bytes_.size()) {
+            CommandHeader header;
+            std::memcpy(&header, bytes_.data() + offset, sizeof(CommandHeader));
+
+            f(header, bytes_.data() + offset + sizeof(CommandHeader));
+            offset += RecordSize(header.size);
+        }
+    }
+
+    static void ExecuteRecord(const CommandHeader& header, const uint8_t* payload, GameState& gameState);
+
+private:
+    static size_t RecordSize(size_t payloadSize) {
+        return (sizeof(CommandHeader) + payloadSize + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+    void Append(CommandType type, uint8_t flags, const void* payload, size_t size);
+
+    std::vector<uint8_t> bytes_;
+    size_t count_ = 0;
+
+    // the records being executed, swapped with bytes_ so both keep their capacity
+    std::vector<uint8_t> executing_;
+
+    uint32_t issuer_ = 0;
+};
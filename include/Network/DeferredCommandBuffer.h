@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "CommandBuffer.h"
+
+class GameState;
+
+// Where a parallel update puts everything that touches another object.
+//
+// While the update pass runs, an object may only write to itself. Anything else (moving a neighbour, spawning, removing)
+// is recorded here as a command record (see CommandBuffer) and executed later on the game thread, at the sync point.
+//
+// Every thread has its own buffer, so recording doesn't need a lock.
+// Which thread ends up running which chunk is up to the job system though, so the commands are not replayed per buffer:
+// Merge sorts them by the objectID that issued them (and by issue order within that object).
+// Same state in, same order out, no matter how many threads there were.
+class DeferredCommandBuffer {
+public:
+    DeferredCommandBuffer() = default;
+
+    DeferredCommandBuffer(DeferredCommandBuffer&&) noexcept = default;
+    DeferredCommandBuffer& operator=(DeferredCommandBuffer&&) noexcept = default;
+
+    // the object being updated, commands pushed from now on are sorted under its id
+    void SetIssuer(uint32_t objectID) {
+        commands_.SetIssuer(objectID);
+    }
+
+    template <typename Record>
+    void Push(const Record& record) {
+        commands_.Push(record);
+    }
+
+    bool Empty() const {
+        return commands_.Empty();
+    }
+
+    size_t Size() const {
+        return commands_.Size();
+    }
+
+    // Runs the commands of all buffers against gameState in deterministic order and empties the buffers.
+    static void Merge(std::vector<DeferredCommandBuffer>& buffers, GameState& gameState);
+
+private:
+    CommandBuffer commands_;
+};
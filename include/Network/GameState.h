@@ -1,233 +1,421 @@
-#pragma once
-#include "../Core/PlayerDirection.h"
-#include "../Core/GridManager.h"
-#include "../Core/GameObject.h"
-
-#include <cstdint>
-#include <vector>
-#include <unordered_map>
-#include <memory>
-
-#include "UDPServer.h"
-#include "UDPClient.h"
-
-#include "Core/RidableObject.h"
-#include "Rendering/Renderer.h"
-#include "Utils/LOG.h"
-#include "Core/RidableObject.h"
-
-class PlayableObject;
-class GameObject;
-
-class MovementManager;
-class GridTransformManager;
-class Renderer;
-
-class GameObjectFactory { 
-public:  
-    virtual ~GameObjectFactory() = default;  
-    virtual std::unique_ptr<GameObject> Create() = 0;  
-}; 
-
-class PlayerFactory : public GameObjectFactory {
-public: 
-    std::unique_ptr<GameObject> Create() override;  
-};
-
-class ItemFactory : public GameObjectFactory {
-public: 
-    std::unique_ptr<GameObject> Create() override; 
-}; 
-
-class StructureComponentFactory : public GameObjectFactory {
-public:
-    std::unique_ptr<GameObject> Create() override;
-};
-
-
-// This GameState class is all that the client receives.
-// All components of the game which must me synced between players 
-// are all stored in this game object. 
-
-// For the sake of Easy network processing. 
-// these goals shall be met 
-// 1. All information can be serialized and deserialized. 
-// 2. New Sort of items should be serialized easily. 
-
-class GameState {
-public:
-    std::string GetName() const;
-
-private:
-    void log(LogLevel level, std::string text);
-
-private:
-    // Current highest ID + 1, always increases
-    uint32_t nextGameObjectId = 1;
-
-    // gameobject_type_id -> gameobject_factory
-    std::unordered_map<uint8_t, std::unique_ptr<GameObjectFactory>> factoryRegistry;
-    // gameobject_id -> gameobject 
-    std::unordered_map<uint32_t, std::unique_ptr<GameObject>> gameObjects;
-
-    // Optional: Keep a separate map for quick type-based lookups
-    std::unordered_multimap<uint8_t, uint32_t> objectsByType;
-
-    std::unordered_map<uint8_t, PlayableObject*> playableObjects; 
-
-    // f: CLientID -> PlayerObject
-    std::unordered_map<uint32_t, PlayableObject*> players; 
-
-    int gridHeight = 32; 
-    int gridWidth = 32; 
-
-    std::vector<uint32_t> droppedItemGrid; 
-    std::vector<uint32_t> structureGrid;  
-    std::vector<GroundType> groundTypeGrid;
-
-    // Render 
-    std::unique_ptr<Renderer> renderer_; 
-
-public: 
-    uint32_t GenerateNewGameObjectId();
-
-    void Draw();
-
-public:
-    // If from Network. The resulting updates don't have to be passed on to the network. 
-    // Because they are the one who informed us. 
-    // If the calls are directly made, it is a desicion made locally and has to be propagated. 
-
-    // If you told me A, there is no reason for me to repeat it for you.
-
-    // Grid Management 
-    void FoldGridIntoCubeAt(int startY, int startX, int size, bool fromNetwork);
-    void CreatePortalOnGridAt(int yCoord, int xCoord, bool fromNetwork);
-
-    // Object Management
-    void CreateAndRegisterPlayerObject(uint32_t player_id);  
-
-    void CreateAndRegisterGameObject(uint8_t typeId, bool fromNetwork);  
-    // How do you know the ID of Object in Prior? When The Object's ID is given by the server :) 
-    void CreateAndRegisterGameObjectWithID(uint32_t id, uint8_t typeId, bool fromNetwork); 
-
-    void AddRidableObject(
-        uint32_t objID,
-        uint32_t meshID,
-        uint32_t textureID,
-        uint8_t gridHeight,
-        uint8_t gridWidth
-        );
-
-    
-    void RemoveGameObjectOfID(uint32_t id, bool fromNetwork);
-    
-    GameObject* GetGameObject(uint32_t id);
-
-    // Hierarchical Operations
-    void SetParent(uint32_t childId, uint32_t parentId, bool fromNetwork);
-
-    // State Updates
-    void UpdateGameObjectPosition(uint32_t id, int y, int x, bool fromNetwork);
-    void PlayerTakeAction(uint32_t playerId, Direction input, bool fromNetwork);
-
-    // Queries
-    std::vector<GameObject*> GetObjectsByType(uint8_t typeId);
-    bool IsValidGameObject(uint32_t id) const; 
-
-public: 
-    // BroadCast from Server  
-    void RegisterAndBroadcastNewGameObject(GameObject* newGameObject);
-
-    void BroadcastGameObjectRemoval(uint32_t id);
-
-    void BroadcastGameObjectPosition(GameObject* gameObject);
-
-    void BroadcastGameObjectParenting(uint32_t parentID, uint32_t objID); 
-
-    std::unique_ptr<INetworkMessage> CaptureGameState();
-
-public: 
-    // send from client 
-    void SendPlayerInput(Direction direction);
-
-public: 
-    GroundType GetGroundTypeAtCoord(int y, int x);  
-
-    void DropItemAt(int y, int x, Item* item); 
-
-public: 
-    // abstract interface 
-    // client::update
-    void DrawGameState(); 
-
-    // server / host 
-    void UpdateGameState(float deltaTime);
-
-    GameState() {
-        isWorking = false; 
-
-
-        client = nullptr; 
-        server = nullptr; 
-
-        Initialize();
-    }
-
-    GameState(GameClient* client) 
-        : client(client), server(nullptr)
-    {
-        isWorking = true;
-        isServerSide = false;  
-
-        Initialize();
-    }
-
-    GameState(GameServer* server)
-        : client(nullptr), server(server)
-    {
-        isWorking = true; 
-        isServerSide = true;
-
-        Initialize();
-    }
-
-    void Initialize() {
-        log(LOG_INFO, "Initialize GameState"); 
-        this->InitializeGrid(gridHeight, gridWidth);  
-        this->InitializeRenderer(); 
-    }
-
-    void InitializeGrid(int height, int width) {
-        int total_size = height * width; 
-
-        droppedItemGrid.resize(total_size, 0);  
-        structureGrid.resize(total_size, 0); 
-        groundTypeGrid.resize(total_size, GroundType::GRASS); 
-
-        movementManager = std::make_unique<MovementManager>();
-        gridTransformManager = std::make_unique<GridTransformManager>();
-    } 
-
-    void InitializeRenderer() {
-        renderer_ = std::make_unique<Renderer>(this);
-    }
-
-public: 
-    // server (& client potentially)
-    std::unique_ptr<MovementManager> movementManager; 
-
-    // Client 
-    std::unique_ptr<GridTransformManager> gridTransformManager;
-
-
-public:  
-    // A bit messy but who cares 
-    bool isWorking = false;
-    bool isServerSide = false;  
-    GameClient* client; 
-    GameServer* server;  
-};
-
-
-
+#pragma once
+#include "../Core/PlayerDirection.h"
+#include "../Core/GridManager.h"
+#include "../Core/GameObject.h"
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+
+#include "UDPServer.h"
+#include "UDPClient.h"
+
+#include "Core/RidableObject.h"
+#include "Core/ComponentStore.h"
+#include "Core/PortalGraph.h"
+#include "Core/SlotMap.h"
+#include "Network/CommandBuffer.h"
+#include "Network/DeferredCommandBuffer.h"
+#include "Network/ChangeJournal.h"
+#include "Network/WorldSnapshot.h"
+#include "Network/Lockstep.h"
+#include "Network/SubWorldStreamer.h"
+#include "Network/Pathfinder.h"
+#include "Core/TripleBuffer.h"
+#include "Rendering/RenderView.h"
+#include "Rendering/Renderer.h"
+#include "Utils/LOG.h"
+#include "Core/RidableObject.h"
+
+class PlayableObject;
+class GameObject;
+
+class MovementManager;
+class GridTransformManager;
+class Renderer;
+class JobSystem;
+
+class GameObjectFactory { 
+public:  
+    virtual ~GameObjectFactory() = default;  
+    virtual std::unique_ptr<GameObject> Create() = 0;  
+}; 
+
+class PlayerFactory : public GameObjectFactory {
+public: 
+    std::unique_ptr<GameObject> Create() override;  
+};
+
+class ItemFactory : public GameObjectFactory {
+public: 
+    std::unique_ptr<GameObject> Create() override; 
+}; 
+
+class StructureComponentFactory : public GameObjectFactory {
+public:
+    std::unique_ptr<GameObject> Create() override;
+};
+
+
+// This GameState class is all that the client receives.
+// All components of the game which must me synced between players 
+// are all stored in this game object. 
+
+// For the sake of Easy network processing. 
+// these goals shall be met 
+// 1. All information can be serialized and deserialized. 
+// 2. New Sort of items should be serialized easily. 
+
+class GameState {
+    // reads and rebuilds everything below in bulk
+    friend class WorldSnapshot;
+
+public:
+    std::string GetName() const;
+
+private:
+    void log(LogLevel level, std::string text);
+
+private:
+    // gameobject_type_id -> gameobject_factory
+    std::unordered_map<uint8_t, std::unique_ptr<GameObjectFactory>> factoryRegistry;
+    // every mutation of this tick. declared before the store and the objects, they record into it until they are gone
+    ChangeJournal changeJournal_;
+
+    // dense per object data, iterated every tick. 
+    // declared before gameObjects, objects unregister themselves from it when they are destroyed
+    ComponentStore componentStore_;
+
+    // gameobject_id (generational handle) -> gameobject 
+    // ids are handed out by the slot map, freed slots get reused with a new generation
+    SlotMap<std::unique_ptr<GameObject>> gameObjects;
+
+    // Optional: Keep a separate map for quick type-based lookups
+    std::unordered_multimap<uint8_t, uint32_t> objectsByType;
+
+    std::unordered_map<uint8_t, PlayableObject*> playableObjects; 
+
+    // f: CLientID -> PlayerObject
+    std::unordered_map<uint32_t, PlayableObject*> players; 
+
+    int gridHeight = 32; 
+    int gridWidth = 32; 
+
+    // chunked, only what is not empty (or not grass) is stored
+    ChunkedGrid<uint32_t> droppedItemGrid; 
+    ChunkedGrid<uint32_t> structureGrid;  
+    ChunkedGrid<GroundType> groundTypeGrid;
+
+    // Render 
+    std::unique_ptr<Renderer> renderer_; 
+
+    // simulation -> renderer. written at the end of every tick, read by whoever draws
+    TripleBuffer<RenderView> renderViews_;
+    uint64_t renderViewTick_ = 0;
+
+    // what came in from the network since the last tick, executed at the start of the next one
+    CommandBuffer commands_;
+
+    // Update pass. Not owned, the GameEngine's thread pool. nullptr -> UpdateGameState runs on the calling thread
+    JobSystem* jobSystem_ = nullptr;
+    // one per thread of the job system, merged at the end of every UpdateGameState
+    std::vector<DeferredCommandBuffer> deferredCommands_;
+
+    // Persistence. The server saves in the background every AUTOSAVE_INTERVAL seconds, if anything changed
+    WorldSnapshot snapshot_;
+    bool changedSinceSave_ = false;
+    float timeSinceSave_ = 0;
+
+    // nullptr unless the match runs in lockstep, see Network/Lockstep.h
+    std::unique_ptr<LockstepController> lockstep_;
+
+    // nullptr unless the server streams sub worlds, see Network/SubWorldStreamer.h
+    std::unique_ptr<SubWorldStreamer> streamer_;
+
+    // made by the first GetPathfinder
+    std::unique_ptr<Pathfinder> pathfinder_;
+
+    // the portals of every grid, the ends are also set in the MovementManagers of the grids
+    PortalGraph portalGraph_;
+
+    // f: NetCompiler::Hash of a description -> its compiled net. every ridable of a shape shares the tables
+    std::unordered_map<uint64_t, std::shared_ptr<const CompiledNet>> nets_;
+
+public: 
+    // reserves a slot, ObjectHandle::NONE when we ran out of them
+    uint32_t GenerateNewGameObjectId();
+
+    void Draw();
+
+public:
+    // If from Network. The resulting updates don't have to be passed on to the network. 
+    // Because they are the one who informed us. 
+    // If the calls are directly made, it is a desicion made locally and has to be propagated. 
+
+    // If you told me A, there is no reason for me to repeat it for you.
+
+    // Grid Management 
+    void FoldGridIntoCubeAt(int startY, int startX, int size, bool fromNetwork);
+
+    // A two way portal between (yCoord, xCoord) on the grid of ridableID and (toY, toX) on the grid of toRidableID.
+    // Stepping onto one end lands on the other with the facing turned by rotation, and turned back on the way back.
+    // An end that already was a portal is unlinked from its old partner first.
+    // false if a ridable is unknown, a cell is off its grid or both ends are the same cell
+    bool CreatePortalOnGridAt(uint32_t ridableID, int yCoord, int xCoord, uint32_t toRidableID, int toY, int toX, uint8_t rotation, bool fromNetwork);
+
+    // every portal between grids, see Core/PortalGraph.h
+    PortalGraph& GetPortalGraph() {
+        return portalGraph_;
+    }
+
+    // Object Management
+    void CreateAndRegisterPlayerObject(uint32_t player_id);  
+    // the player objects of the other lockstep peers, under the ids the host gave them
+    void CreateAndRegisterPlayerObjectWithID(uint32_t player_id, uint32_t id);
+
+    // the client left. its streaming goes, and its player object unless it walks in a lockstep match
+    void RemovePlayerObject(uint32_t player_id);
+
+    // nullptr when player_id has none
+    PlayableObject* GetPlayerObject(uint32_t player_id);
+
+    void CreateAndRegisterGameObject(uint8_t typeId, bool fromNetwork);  
+    // How do you know the ID of Object in Prior? When The Object's ID is given by the server :) 
+    void CreateAndRegisterGameObjectWithID(uint32_t id, uint8_t typeId, bool fromNetwork); 
+
+    void AddRidableObject(
+        uint32_t objID,
+        uint32_t meshID,
+        uint32_t textureID,
+        uint16_t gridHeight,
+        uint16_t gridWidth
+        );
+
+    // folded like description, the shape is compiled by the first ridable of it (GetNet)
+    void AddRidableObject(
+        uint32_t objID,
+        uint32_t meshID,
+        uint32_t textureID,
+        const NetDescription& description
+        );
+
+    // the compiled net of description, compiled once and kept for every ridable of the shape. nullptr if it doesn't compile
+    std::shared_ptr<const CompiledNet> GetNet(const NetDescription& description);
+
+    
+    void RemoveGameObjectOfID(uint32_t id, bool fromNetwork);
+    
+    GameObject* GetGameObject(uint32_t id);
+
+    ComponentStore& GetComponentStore() {
+        return componentStore_;
+    }
+
+    ChangeJournal& GetChangeJournal() {
+        return changeJournal_;
+    }
+
+    CommandBuffer& GetCommandBuffer() {
+        return commands_;
+    }
+
+    // runs the queued commands. start of UpdateGameState / DrawGameState
+    void ExecuteCommands();
+
+    // end of tick. hands the journal to its consumers (replication, renderer, ...)
+    void PublishChanges();
+
+    // Copies what the renderer needs out of this tick and hands it over. Simulation thread
+    void PublishRenderView();
+
+    // The latest published view. Render thread, valid until its next call
+    const RenderView& AcquireRenderView() {
+        return renderViews_.AcquireLatest();
+    }
+
+    // see WorldSnapshot. Save copies the state now and writes it on a background thread
+    bool SaveSnapshot(const std::string& path);
+    bool LoadSnapshot(const std::string& path);
+    void WaitForSnapshot();
+
+    static constexpr float AUTOSAVE_INTERVAL = 30.0f;
+
+    // From then on every peer simulates the state itself, the game mode calls GetLockstep()->Advance instead of UpdateGameState.
+    // Once per GameState, all peers from the same starting state. On the host every player created afterwards becomes a peer
+    LockstepController* EnableLockstep(uint32_t localPeerID, uint32_t localWalkerID);
+
+    LockstepController* GetLockstep() {
+        return lockstep_.get();
+    }
+
+    // Server. From then on every client only gets the sub worlds around its player object (or around the root ridable
+    // while it stands on no grid, see SubWorldStreamer), and the journal is replicated per client instead of broadcast. Before the first client joins
+    SubWorldStreamer* EnableSubWorldStreaming(uint8_t subscribeDistance = StreamingConfig::SUBSCRIBE_DISTANCE);
+
+    SubWorldStreamer* GetSubWorldStreamer() {
+        return streamer_.get();
+    }
+
+    // paths on the grids of ridables, see Network/Pathfinder.h. starts following the journal on the first call
+    Pathfinder* GetPathfinder();
+
+    // a ray on the grid of a ridable, see Ray in Core/GridManager.h
+    struct RayQuery {
+        uint32_t ridableID;
+        Ray ray;
+    };
+
+    // Line of sight for many at once (AI perception). Spread over the job system, RAYCAST_CHUNK_SIZE rays per job.
+    // a ridable that is unknown or stale leaves its rays where they start, nothing hit
+    void CastRays(std::vector<RayQuery>& queries);
+
+    static constexpr size_t RAYCAST_CHUNK_SIZE = 256;
+
+private: 
+    // every way of creating an object ends up here 
+    GameObject* InsertGameObject(uint32_t id, std::unique_ptr<GameObject> gameObject, bool fromNetwork);
+
+    // journal consumer on the server. sends what was decided here, not what came in from the network
+    void ReplicateChanges(const ChangeJournal& journal);
+
+    // one end of a portal, into the MovementManager and the graph. no checks
+    void LinkPortal(RidableObject* from, uint32_t fromCell, RidableObject* to, uint32_t toCell, uint8_t rotation);
+    // drops the portal at cell of gridID and the end that leads back to it
+    void UnlinkPortal(uint32_t gridID, uint32_t cell);
+    // the ridable gridID is gone, so are the portals into it
+    void UnlinkPortalsOf(uint32_t gridID);
+
+public:
+
+    // Hierarchical Operations
+    void SetParent(uint32_t childId, uint32_t parentId, bool fromNetwork);
+
+    // State Updates
+    void UpdateGameObjectPosition(uint32_t id, int y, int x, bool fromNetwork);
+    void PlayerTakeAction(uint32_t playerId, Direction input, bool fromNetwork);
+
+    // Queries
+    std::vector<GameObject*> GetObjectsByType(uint8_t typeId);
+    // false for 0, unknown and stale (removed, slot reused) ids
+    bool IsValidGameObject(uint32_t id) const; 
+
+public: 
+    // BroadCast from Server  
+    // the broadcast itself happens through the journal, see ReplicateChanges
+    void RegisterAndBroadcastNewGameObject(GameObject* newGameObject);
+
+    void BroadcastGameObjectSpawn(uint8_t typeID, uint32_t id);
+
+    void BroadcastGameObjectRemoval(uint32_t id);
+
+    void BroadcastGameObjectPosition(GameObject* gameObject);
+
+    void BroadcastGameObjectParenting(uint32_t parentID, uint32_t objID); 
+
+    void BroadcastPortal(uint32_t ridableID, int yCoord, int xCoord, uint32_t toRidableID, int toY, int toX, uint8_t rotation);
+
+    std::unique_ptr<INetworkMessage> CaptureGameState();
+
+public: 
+    // send from client 
+    void SendPlayerInput(Direction direction);
+
+public: 
+    GroundType GetGroundTypeAtCoord(int y, int x);  
+
+    void DropItemAt(int y, int x, Item* item); 
+
+public: 
+    // abstract interface 
+    // client::update
+    void DrawGameState(); 
+
+    // server / host 
+    // Runs the systems and GameObject::Tick over chunks of objects on the job system, 
+    // then the deferred commands, in objectID order
+    void UpdateGameState(float deltaTime);
+
+    void SetJobSystem(JobSystem* jobSystem);
+
+    JobSystem* GetJobSystem() {
+        return jobSystem_;
+    }
+
+    // rows of the component store per job
+    static constexpr size_t UPDATE_CHUNK_SIZE = 1024;
+
+    GameState() {
+        isWorking = false; 
+
+
+        client = nullptr; 
+        server = nullptr; 
+
+        Initialize();
+    }
+
+    GameState(GameClient* client) 
+        : client(client), server(nullptr)
+    {
+        isWorking = true;
+        isServerSide = false;  
+
+        Initialize();
+    }
+
+    GameState(GameServer* server)
+        : client(nullptr), server(server)
+    {
+        isWorking = true; 
+        isServerSide = true;
+
+        Initialize();
+    }
+
+    // the room is over. tears everything down and hands the pooled memory back in bulk
+    ~GameState();
+
+    void Initialize() {
+        log(LOG_INFO, "Initialize GameState"); 
+        this->InitializeChangeJournal();
+        this->InitializeGrid(gridHeight, gridWidth);  
+        this->InitializeRenderer(); 
+    }
+
+    void InitializeGrid(int height, int width) {
+        gridHeight = height;
+        gridWidth = width;
+
+        droppedItemGrid.Reset(height, width, 0);  
+        structureGrid.Reset(height, width, 0); 
+        groundTypeGrid.Reset(height, width, GroundType::GRASS); 
+
+        movementManager = std::make_unique<MovementManager>();
+        gridTransformManager = std::make_unique<GridTransformManager>();
+    } 
+
+    void InitializeChangeJournal();
+
+    void InitializeRenderer() {
+        renderer_ = std::make_unique<Renderer>(this);
+    }
+
+public: 
+    // server (& client potentially)
+    std::unique_ptr<MovementManager> movementManager; 
+
+    // Client 
+    std::unique_ptr<GridTransformManager> gridTransformManager;
+
+
+public:  
+    // A bit messy but who cares 
+    bool isWorking = false;
+    bool isServerSide = false;  
+    GameClient* client; 
+    GameServer* server;  
+};
+
+
+
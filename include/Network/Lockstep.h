@@ -0,0 +1,192 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../Core/PlayerDirection.h"
+#include "../Utils/LOG.h"
+#include "StateHasher.h"
+
+class GameState;
+class INetworkMessage;
+
+// Lockstep. Peers only exchange their inputs, every peer simulates the whole GameState itself.
+//
+// Time is cut into fixed ticks. Input sampled during tick t is scheduled for tick t + INPUT_DELAY
+// and sent to everybody, so it usually arrives before anybody needs it.
+// Tick t is only simulated once the input of every peer for t is there, then all of them are applied
+// in peerID order, followed by UpdateGameState(TICK_DURATION). Same inputs, same order, same state.
+//
+// Every HASH_INTERVAL ticks the peers exchange the StateHasher hash of their state.
+// If one differs, both sides send the per object hashes of that tick and the
+// DesyncReport names the first object (lowest objectID) that does not match.
+//
+// Bandwidth is a few bytes per peer per tick, whatever the size of the world.
+// The host is a peer as well, and relays what the clients send to the other clients.
+//
+// The host owns the peer table. Clients that join before the match starts become peers, later ones are turned away:
+// nobody could send them the state of a running match. The host sends the whole table (peer, walker, first tick)
+// to every client when it starts, and again with every checkpoint and while waiting.
+// A client starts its own controller from the first table it gets. A peer's walker is the one in the table, whatever its messages say.
+namespace LockstepConfig {
+    // 0: the host runs the usual server authoritative game. otherwise a lockstep match,
+    // started by the host once this many peers (itself included) are in
+    constexpr size_t PEERS_PER_MATCH = 0;
+
+    constexpr float TICK_DURATION = 1.0f / 20.0f;
+
+    // ticks between sampling an input and applying it
+    constexpr uint64_t INPUT_DELAY = 3;
+
+    // every input message repeats the last few inputs, a lost packet costs nothing.
+    // peers can't drift further apart than INPUT_DELAY ticks either way, so this covers whatever one of them may still miss
+    constexpr uint8_t INPUT_REDUNDANCY = static_cast<uint8_t>(2 * INPUT_DELAY);
+
+    constexpr uint64_t HASH_INTERVAL = 30;
+
+    // the host's peerID. clients are peers under their client_id, which may not be this one
+    constexpr uint32_t HOST_PEER_ID = 0;
+
+    // hash checkpoints (and their manifests) kept around for peers that are behind
+    constexpr size_t CHECKPOINT_HISTORY = 8;
+
+    // 12 bytes each, keeps a manifest message below the 1024 byte receive buffers
+    constexpr size_t MANIFEST_ENTRIES_PER_MESSAGE = 64;
+
+    // a slow frame may simulate a few ticks at once, not an unbounded amount
+    constexpr int MAX_TICKS_PER_ADVANCE = 4;
+}
+
+struct DesyncReport {
+    uint64_t tick = 0;
+    uint32_t remotePeerID = 0;
+
+    uint64_t localHash = 0;
+    uint64_t remoteHash = 0;
+
+    // ObjectHandle::NONE until the manifest of the other side arrived
+    uint32_t objectID = 0;
+    // 0: the object does not exist on that side
+    uint64_t localObjectHash = 0;
+    uint64_t remoteObjectHash = 0;
+
+    std::string ToString() const;
+};
+
+class LockstepController {
+public:
+    std::string GetName() const;
+
+private:
+    void log(LogLevel level, std::string text);
+
+public:
+    // localWalkerID: the object our inputs walk around
+    LockstepController(GameState& gameState, uint32_t localPeerID, uint32_t localWalkerID);
+
+    LockstepController(const LockstepController&) = delete;
+    LockstepController& operator=(const LockstepController&) = delete;
+
+    // somebody who has to send inputs, for every tick from firstTick on. walkerID is what those inputs walk.
+    // the same table on every peer. false once the match started
+    bool AddPeer(uint32_t peerID, uint32_t walkerID, uint64_t firstTick);
+
+    // Advance does nothing before. the host starts once everybody is there, a client with the first peer table
+    void Start();
+
+    // the input for the next tick that gets sampled. IDLE does nothing
+    void SetLocalInput(Direction direction);
+
+    // call every frame instead of UpdateGameState. simulates as many ticks as time and inputs allow
+    void Advance(float deltaTime);
+
+    // from the network (LockstepInputCommand, ...). on the host they are relayed to the other clients
+    // directions[i] is the input for tick newestTick + 1 - directions.size() + i
+    void ReceiveInputs(uint32_t peerID, uint32_t walkerID, uint64_t newestTick, const std::vector<Direction>& directions);
+    void ReceiveHash(uint32_t peerID, uint64_t tick, uint64_t hash);
+    void ReceiveManifest(uint32_t peerID, uint64_t tick, uint32_t firstEntry, uint32_t totalEntries,
+        const std::vector<uint32_t>& objectIDs, const std::vector<uint64_t>& objectHashes);
+    // the host's peer table, clients only
+    void ReceivePeers(const std::vector<uint32_t>& peerIDs, const std::vector<uint32_t>& walkerIDs, const std::vector<uint64_t>& firstTicks);
+
+    uint64_t GetTick() const {
+        return tick_;
+    }
+
+    uint32_t GetLocalPeerID() const {
+        return localPeerID_;
+    }
+
+    size_t GetPeerCount() const {
+        return peers_.size();
+    }
+
+    bool IsStarted() const {
+        return isStarted_;
+    }
+
+    // the simulation stops at the first desync, the report says where
+    bool IsDesynced() const {
+        return isDesynced_;
+    }
+
+    const DesyncReport& GetDesyncReport() const {
+        return desyncReport_;
+    }
+
+private:
+    struct Peer {
+        uint32_t walkerID;
+        uint64_t firstTick;
+    };
+
+    struct Checkpoint {
+        uint64_t hash;
+        std::vector<StateHasher::Entry> manifest;
+    };
+
+    bool IsTickReady(uint64_t tick) const;
+    void Step();
+
+    void ScheduleLocalInput(uint64_t tick);
+    void SendLocalInputs();
+
+    // host -> every client
+    void SendPeers();
+
+    void TakeCheckpoint();
+    void CompareHash(uint32_t peerID, uint64_t tick, uint64_t remoteHash);
+    void SendManifest(uint64_t tick);
+
+    // host -> every client, client -> host
+    void Send(INetworkMessage& message);
+
+    GameState& gameState_;
+    StateHasher hasher_;
+
+    uint32_t localPeerID_;
+    uint32_t localWalkerID_;
+    // peerID -> walker and first tick. std::map, walked in peerID order
+    std::map<uint32_t, Peer> peers_;
+
+    uint64_t tick_ = 0;
+    float accumulator_ = 0;
+
+    Direction pendingInput_ = Direction::IDLE;
+
+    // tick -> peerID -> input. std::map, both levels are walked in order
+    std::map<uint64_t, std::map<uint32_t, Direction>> inputs_;
+    // ours, newest last, INPUT_REDUNDANCY of them go into every message
+    std::vector<Direction> recentLocalInputs_;
+    uint64_t newestLocalInputTick_ = 0;
+
+    std::map<uint64_t, Checkpoint> checkpoints_;
+    // hashes of peers that are ahead of us. tick -> peerID -> hash
+    std::map<uint64_t, std::map<uint32_t, uint64_t>> remoteHashes_;
+
+    bool isStarted_ = false;
+
+    bool isDesynced_ = false;
+    DesyncReport desyncReport_;
+};
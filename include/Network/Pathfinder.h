@@ -0,0 +1,163 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../Core/ChunkedGrid.h"
+#include "../Core/PortalGraph.h"
+#include "../Core/GridTopology.h"
+#include "../Core/PlayerDirection.h"
+#include "../Utils/LOG.h"
+
+class GameState;
+class ChangeJournal;
+class RidableObject;
+class MovementManager;
+
+namespace PathfindingConfig {
+    // queries answered per job of Solve
+    constexpr size_t QUERY_CHUNK_SIZE = 256;
+}
+
+// Shortest walks on the grid of a ridable, seams and all.
+//
+// Paths follow the CellLinks of the grid's MovementManager, so a walk over the edge of a cube or around a torus
+// costs one step like any other. A path is a list of directions in the grid's own frame, what
+// WalkOnRidableObjectCommand takes one at a time. Cells somebody stands on are walls, except the target.
+//
+// Portal cells (Core/PortalGraph.h) are walls too unless they are the target, stepping on one leaves the grid.
+// NextStepAcross goes to another grid: the portals to take come from the PortalGraph, and on every grid
+// the walk heads for the next portal like for any other target.
+//
+// Every step costs the same, so instead of searching per agent the pathfinder keeps a distance field per
+// (grid, target): a breadth first search backwards from the target, once. Every agent heading there reads its next
+// step off the field, which is 4 lookups. A field stays until the occupancy of its grid changes, then it is
+// rebuilt the next time somebody asks, or dropped if nobody asked since the last change.
+//
+// Game thread only, between ticks. Solve spreads a batch over the job system.
+class Pathfinder {
+public:
+    std::string GetName() const;
+
+private:
+    void log(LogLevel level, std::string text);
+
+public:
+    // distance of a cell that can't reach the target
+    static constexpr uint32_t UNREACHABLE = 0xFFFFFFFF;
+
+    struct Query {
+        uint32_t ridableID;
+        uint32_t fromCell;
+        uint32_t targetCell;
+
+        // filled in by Solve. IDLE: there already, or no way there
+        Direction next = Direction::IDLE;
+        uint32_t distance = UNREACHABLE;
+    };
+
+    // follows the journal of gameState from now on
+    explicit Pathfinder(GameState& gameState);
+
+    Pathfinder(const Pathfinder&) = delete;
+    Pathfinder& operator=(const Pathfinder&) = delete;
+
+    // the first step from fromCell towards targetCell on the grid of ridableID. distance: steps left, UNREACHABLE if none
+    Direction NextStep(uint32_t ridableID, uint32_t fromCell, uint32_t targetCell, uint32_t* distance = nullptr);
+
+    // towards targetCell on the grid of targetRidableID, through as few portals as possible.
+    // on the grid of targetRidableID itself it is NextStep. distance: steps to the next portal or the target
+    Direction NextStepAcross(uint32_t ridableID, uint32_t fromCell, uint32_t targetRidableID, uint32_t targetCell, uint32_t* distance = nullptr);
+
+    // the whole walk, false if there is none. an empty path: already there
+    bool FindPath(uint32_t ridableID, uint32_t fromCell, uint32_t targetCell, std::vector<Direction>& path);
+
+    // answers every query. the missing fields are built in parallel first, then the queries are split over the threads
+    void Solve(std::vector<Query>& queries);
+
+    // forget everything about the grid of ridableID. the journal takes care of occupancy, this is for the topology
+    void Invalidate(uint32_t ridableID);
+
+    size_t GetFieldCount() const;
+
+    void LogStats();
+
+private:
+    struct Field {
+        // steps from each cell to the target. 32 bits, a walk around a big torus is longer than 65535 steps
+        std::vector<uint32_t> distance;
+        // Grid::version it was built for
+        uint32_t version = 0;
+        // asked for since the last occupancy change
+        bool isUsed = false;
+    };
+
+    struct Grid {
+        // what MovementManager::GetLinks said when the predecessors were built. a refold detaches the shared table, and it moves.
+        // nullptr for a plain torus that doesn't store its links, they are asked from movement one cell at a time
+        const CellLink* links = nullptr;
+        const MovementManager* movement = nullptr;
+        uint32_t cellCount = 0;
+
+        // the reverse of links: the cells that step into c are predecessors[predecessorStart[c] .. predecessorStart[c + 1]).
+        // empty for a plain torus, every link goes both ways there and the predecessors are the neighbours
+        std::vector<uint32_t> predecessorStart;
+        std::vector<uint32_t> predecessors;
+
+        // the portal cells of the grid, walls unless they are the target
+        std::vector<uint32_t> portalCells;
+
+        // bumped when somebody steps on or off the grid
+        uint32_t version = 1;
+        uint64_t changedTick = UINT64_MAX;
+
+        // target cell -> field
+        std::unordered_map<uint32_t, Field> fields;
+    };
+
+    // one field to build in Solve
+    struct Build {
+        const Grid* grid;
+        const ChunkedGrid<uint32_t>* occupancy;
+        uint32_t target;
+        Field* field;
+    };
+
+    // nullptr if ridableID has no grid. rebuilds the predecessors when the links moved
+    Grid* GetGrid(uint32_t ridableID, RidableObject*& ridable);
+
+    // the field towards target, nullptr for a target off the grid. needsBuild: stale or new, distances not valid yet
+    Field* GetField(Grid& grid, uint32_t target, bool& needsBuild);
+
+    static void BuildPredecessors(Grid& grid);
+
+    // links[cell], or worked out by the MovementManager of a plain torus
+    static CellLink GetLink(const Grid& grid, uint32_t cell);
+
+    // backwards breadth first search from target. queue is scratch
+    static void BuildField(const Grid& grid, const ChunkedGrid<uint32_t>& occupancy, uint32_t target, Field& field, std::vector<uint32_t>& queue);
+
+    // the neighbour closest to the target
+    static Direction StepDown(const Grid& grid, const Field& field, uint32_t fromCell, uint32_t targetCell, uint32_t* distance);
+
+    // journal consumer
+    void OnChanges(const ChangeJournal& journal);
+
+    GameState& gameState_;
+
+    // ridableID -> its grid
+    std::unordered_map<uint32_t, Grid> grids_;
+
+    // scratch of Solve, kept for their capacity
+    std::vector<Build> builds_;
+    std::vector<const Grid*> queryGrids_;
+    std::vector<const Field*> queryFields_;
+    std::vector<std::vector<uint32_t>> queues_;
+    // scratch of NextStepAcross
+    std::vector<Portal> route_;
+
+    // stats
+    uint64_t fieldBuilds_ = 0;
+    uint64_t queries_ = 0;
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../Utils/LOG.h"
+
+class GameState;
+class ChangeJournal;
+
+// Running hash of the simulated state, for lockstep desync detection.
+//
+// Every object has its own hash: id, type, parent, and for ridables the size and the content of the grid
+// (which also covers where everybody stands). The state hash is the sum of them, so it does not depend on
+// the order objects are visited in, and one object changing is one subtraction and one addition.
+//
+// The hasher listens to the ChangeJournal and only rehashes the objects that were touched during the tick.
+// Transforms are left out on purpose, they are presentation (idle spin, interpolation) and floats
+// are not guaranteed to come out bit identical on every machine.
+class StateHasher {
+public:
+    std::string GetName() const;
+
+private:
+    void log(LogLevel level, std::string text);
+
+public:
+    // one object of a manifest, see GetManifest
+    struct Entry {
+        uint32_t objectID;
+        uint64_t hash;
+    };
+
+    StateHasher() = default;
+
+    StateHasher(const StateHasher&) = delete;
+    StateHasher& operator=(const StateHasher&) = delete;
+
+    // hashes everything once and starts following the journal of gameState
+    void Attach(GameState& gameState);
+
+    // rehashes what changed since the last call, returns the state hash
+    uint64_t Update();
+
+    uint64_t GetHash() const {
+        return stateHash_;
+    }
+
+    // every object with its hash, sorted by objectID. what peers compare to find the first differing object
+    std::vector<Entry> GetManifest() const;
+
+    static uint64_t HashObject(GameState& gameState, uint32_t objectID);
+
+private:
+    void MarkDirty(const ChangeJournal& journal);
+    void Rehash(uint32_t objectID);
+
+    GameState* gameState_ = nullptr;
+
+    uint64_t stateHash_ = 0;
+
+    // by slot index of the objectID. 0: no object
+    std::vector<uint64_t> objectHashes_;
+    std::vector<uint32_t> objectIDs_;
+
+    // touched this tick. may repeat, and may hold the removed and the new id of the same slot
+    std::vector<uint32_t> dirtyIDs_;
+};
@@ -0,0 +1,129 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../Utils/LOG.h"
+
+class GameState;
+class ChangeJournal;
+class INetworkMessage;
+
+// Server side interest management for nested ridables.
+//
+// A client only gets the sub worlds it is close to. Close is counted in hierarchy hops from its focus object
+// (its player object): standing on a grid, or having somebody stand on yours, is one hop.
+// So is a portal between two grids, see Core/PortalGraph.h.
+// While the focus stands on no grid (a player that just joined), the hops are counted from the root ridable instead,
+// the lowest id ridable nothing carries. Once it steps onto a grid, streaming follows it.
+// - within subscribeDistance: the ridable is subscribed, the client gets its grid and everybody on it
+// - everybody on a subscribed grid is known to the client as a shell: mesh, texture and grid size, empty grid
+// - a subscribed ridable that drifts further than subscribeDistance + RELEASE_MARGIN away is released,
+//   the client clears its grid and loses whoever it only knew from there
+//
+// While streaming, the server sends state instead of forwarding commands: every grid slot that changes on a
+// subscribed grid goes to the clients subscribed to it, nothing else. Client memory and join traffic grow
+// with what is around the player, not with the size of the world.
+namespace StreamingConfig {
+    // the host streams to its clients (HostLobbyMode). not in a lockstep match, every peer has the whole world there
+    constexpr bool IS_ENABLED = true;
+
+    // hops from the focus whose grids are sent
+    constexpr uint8_t SUBSCRIBE_DISTANCE = 2;
+
+    // walking back and forth over the border doesn't send the same grid again and again
+    constexpr uint8_t RELEASE_MARGIN = 1;
+}
+
+class SubWorldStreamer {
+public:
+    std::string GetName() const;
+
+private:
+    void log(LogLevel level, std::string text);
+
+public:
+    // how a message reaches one client. GameServer::send_reliable_message_to_client on the server:
+    // nothing is sent twice, a lost shell or grid slot would stay lost
+    using SendFunction = std::function<void(uint32_t clientID, const INetworkMessage& message)>;
+
+    SubWorldStreamer(GameState& gameState, SendFunction send, uint8_t subscribeDistance = StreamingConfig::SUBSCRIBE_DISTANCE);
+
+    ~SubWorldStreamer();
+
+    SubWorldStreamer(const SubWorldStreamer&) = delete;
+    SubWorldStreamer& operator=(const SubWorldStreamer&) = delete;
+
+    // the client gets what is around focusID on the next Update
+    void AddClient(uint32_t clientID, uint32_t focusID);
+    void RemoveClient(uint32_t clientID);
+
+    void SetFocus(uint32_t clientID, uint32_t focusID);
+
+    // after GameState::PublishChanges. re-evaluates the clients whose surroundings changed
+    void Update();
+
+    // a portal between the grids of two ridables came or went. not in the journal, GameState tells
+    void OnPortalChanged(uint32_t ridableID, uint32_t toRidableID);
+
+    bool IsSubscribed(uint32_t clientID, uint32_t ridableID) const;
+
+    // objects the client has, shells included
+    size_t GetKnownCount(uint32_t clientID) const;
+
+    uint8_t GetSubscribeDistance() const {
+        return subscribeDistance_;
+    }
+
+private:
+    struct Client {
+        uint32_t focusID;
+        // re-evaluate on the next Update
+        bool isDirty;
+
+        // ridables whose grid the client has
+        std::unordered_set<uint32_t> subscribed;
+        // everything the client has
+        std::unordered_set<uint32_t> known;
+        // everything the last walk went through. a change on one of their grids may change what is close
+        std::unordered_set<uint32_t> reached;
+    };
+
+    // journal consumer. passes grid slot changes on to the subscribers, marks who has to be re-evaluated
+    void Replicate(const ChangeJournal& journal);
+
+    void Refresh(uint32_t clientID, Client& client);
+
+    // hops from the focus, up to maxDistance, into distance_
+    void Walk(uint32_t focusID, uint8_t maxDistance);
+
+    // where the hops of client are counted from: its focus, or the root ridable while the focus stands on no grid. 0 if neither exists
+    uint32_t FindWalkStart(const Client& client) const;
+
+    void SendShell(uint32_t clientID, uint32_t objectID);
+    void SendGrid(uint32_t clientID, Client& client, uint32_t ridableID);
+    void SendSlot(uint32_t clientID, Client& client, uint32_t ridableID, uint32_t cell, uint32_t occupantID);
+
+    GameState& gameState_;
+    SendFunction send_;
+
+    uint8_t subscribeDistance_;
+
+    // std::map, clients are served in the same order every time
+    std::map<uint32_t, Client> clients_;
+
+    // scratch of Walk and Refresh, kept for their capacity
+    std::unordered_map<uint32_t, uint8_t> distance_;
+    std::vector<uint32_t> frontier_;
+    std::vector<uint32_t> nextFrontier_;
+    std::vector<uint32_t> sorted_;
+
+    // stats
+    uint64_t sentShells_ = 0;
+    uint64_t sentSlots_ = 0;
+    uint64_t releases_ = 0;
+};
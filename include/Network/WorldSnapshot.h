@@ -0,0 +1,179 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../Utils/LOG.h"
+
+class GameState;
+
+// Binary snapshot of a GameState, so that a restarted host comes back with its world.
+//
+// Layout (little endian, everything addressed by offsets from the start of the file, no pointers):
+//
+//   Header
+//   SectionEntry[nSections]     kind, offset, size, count of each section
+//   sections                    each one an array of fixed size records, 8 byte aligned
+//
+// Sections
+//   SLOTS        SlotMap<GameObject> bookkeeping (generations, reservations), so ids keep their meaning
+//   FREE_LIST    the slot map's free list, in allocation order
+//   OBJECTS      one ObjectRecord per object, in slot order
+//   GRID_CELLS   the occupied cells of all ridable grids back to back (GridCellRecord), ObjectRecord::gridOffset points in here
+//   WORLD        one WorldRecord
+//   WORLD_CELLS  the cells of the world grids that are not empty (WorldCellRecord), ascending
+//   PORTALS      every portal between grids, one record per direction (PortalRecord), like the PortalGraph keeps them
+//   NETS         the ridables folded like a compiled net (NetRecord), where their description is in NET_BYTES
+//   NET_BYTES    the descriptions back to back (NetCompiler::SerializeDescription), compiled again when loading
+//
+// Grids are stored sparse, like they are kept in memory (ChunkedGrid). A cell that isn't listed is empty.
+//
+// Loading maps the file and reads the records in place. Objects are created in one pass,
+// the ridable grids are filled in a second pass once every id standing on them exists.
+// Player objects are saved but not loaded: they were bound to the clients of the session that saved them.
+// The clients connected while loading get new player objects instead.
+//
+// A new field means a new VERSION. Files of another version are refused, not guessed at.
+namespace SnapshotFormat {
+    constexpr char MAGIC[8] = { 'D', 'F', 'S', 'N', 'A', 'P', '\0', '\0' };
+    constexpr uint32_t VERSION = 4;
+
+    // where the host keeps its world, next to the executable
+    constexpr const char* DEFAULT_PATH = "world.snapshot";
+
+    enum class SectionKind : uint32_t {
+        SLOTS,
+        FREE_LIST,
+        OBJECTS,
+        GRID_CELLS,
+        WORLD,
+        WORLD_CELLS,
+        PORTALS,
+        NETS,
+        NET_BYTES,
+        LAST
+    };
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t nSections;
+        uint64_t fileSize;
+    };
+
+    struct SectionEntry {
+        SectionKind kind;
+        uint32_t recordSize;
+        uint64_t offset;
+        uint64_t size;
+        uint64_t count;
+    };
+
+    struct ObjectRecord {
+        uint32_t objectID;
+        uint32_t parentID;
+        uint32_t meshID;
+        uint32_t textureID;
+
+        uint8_t typeID;
+        uint8_t flags;
+        uint16_t gridHeight;
+        uint16_t gridWidth;
+        uint16_t padding;
+        // first record in GRID_CELLS, gridCount of them
+        uint32_t gridOffset;
+        uint32_t gridCount;
+
+        float translation[3];
+        float rotation[4];  // w, x, y, z
+        float scale[3];
+    };
+
+    // ObjectRecord::flags
+    constexpr uint8_t IS_RIDABLE = 1 << 0;
+    constexpr uint8_t IS_CUBE_NET = 1 << 1;
+    // folded like a compiled net, it has a NetRecord
+    constexpr uint8_t IS_NET = 1 << 2;
+
+    struct SlotRecord {
+        uint32_t generation;
+        uint8_t occupied;
+        uint8_t retired;
+        uint16_t padding;
+    };
+
+    struct GridCellRecord {
+        uint32_t cell;
+        uint32_t objectID;
+    };
+
+    struct WorldRecord {
+        int32_t gridHeight;
+        int32_t gridWidth;
+    };
+
+    struct WorldCellRecord {
+        uint32_t cell;
+        uint32_t droppedItem;
+        uint32_t structure;
+        uint32_t groundType;
+    };
+
+    struct PortalRecord {
+        uint32_t fromGridID;
+        uint32_t fromCell;
+        uint32_t toGridID;
+        uint32_t toCell;
+        uint8_t rotation;
+        uint8_t padding[3];
+    };
+
+    struct NetRecord {
+        uint32_t objectID;
+        // the description is size bytes at offset in NET_BYTES
+        uint32_t offset;
+        uint32_t size;
+        uint32_t padding;
+    };
+}
+
+class WorldSnapshot {
+public:
+    std::string GetName() const;
+
+private:
+    void log(LogLevel level, std::string text);
+
+public:
+    WorldSnapshot() = default;
+    // waits for a write still in flight
+    ~WorldSnapshot();
+
+    WorldSnapshot(const WorldSnapshot&) = delete;
+    WorldSnapshot& operator=(const WorldSnapshot&) = delete;
+
+    // Copies the state on the calling (game) thread, writes it to disk on a background thread.
+    // The file is written next to path and renamed over it at the end, a crash never leaves half a world behind.
+    // false if the previous write is still running.
+    bool SaveAsync(GameState& gameState, const std::string& path);
+
+    bool IsSaving() const {
+        return saving_.load();
+    }
+
+    void WaitForSave();
+
+    // replaces everything in gameState with the contents of path
+    bool Load(GameState& gameState, const std::string& path);
+
+    static std::vector<uint8_t> Capture(GameState& gameState);
+    static bool Restore(GameState& gameState, const uint8_t* data, size_t size);
+
+private:
+    static bool WriteFileAtomically(const std::string& path, const std::vector<uint8_t>& bytes);
+
+    std::thread writer_;
+    std::atomic<bool> saving_{ false };
+};
@@ -0,0 +1,74 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../Core/SlotMap.h"
+
+// What the renderer needs of one tick, copied out of the GameState.
+//
+// GameState::PublishRenderView fills one at the end of every tick and hands it over through a TripleBuffer.
+// The renderer only ever reads a published one, so it can run on its own thread while the next tick is simulated.
+//
+// Row i of the per object columns is one object (same order as the ComponentStore at that tick).
+// Ridable objects additionally own a range of entries: cellBegin[i] .. cellBegin[i] + cellCount[i]
+// in cellIndices (which cell of the grid, ascending), cellObjectIDs (who stands there) and cellMatrices (the grid transform of that cell).
+// Only occupied cells are listed, a big grid with a few riders costs a few entries.
+struct RenderView {
+    static constexpr uint32_t NO_ROW = std::numeric_limits<uint32_t>::max();
+
+    uint64_t tick = 0;
+
+    std::vector<uint32_t> objectIDs;
+    std::vector<glm::mat4> localMatrices;
+    std::vector<uint32_t> meshIDs;
+    std::vector<uint32_t> textureIDs;
+    std::vector<uint32_t> parentIDs;
+
+    std::vector<uint32_t> cellBegin;
+    std::vector<uint32_t> cellCount;
+    std::vector<uint32_t> cellIndices;
+    std::vector<uint32_t> cellObjectIDs;
+    std::vector<glm::mat4> cellMatrices;
+
+    // slot index of the objectID -> row
+    std::vector<uint32_t> rowOfSlot;
+
+    uint32_t RowOf(uint32_t objectID) const {
+        uint32_t slot = ObjectHandle::IndexOf(objectID);
+
+        if (objectID == ObjectHandle::NONE || slot >= rowOfSlot.size()) {
+            return NO_ROW;
+        }
+
+        uint32_t row = rowOfSlot[slot];
+        if (row == NO_ROW || objectIDs[row] != objectID) {
+            return NO_ROW;
+        }
+        return row;
+    }
+
+    size_t Size() const {
+        return objectIDs.size();
+    }
+
+    // keeps the capacity, the next tick fills it again
+    void Clear() {
+        objectIDs.clear();
+        localMatrices.clear();
+        meshIDs.clear();
+        textureIDs.clear();
+        parentIDs.clear();
+
+        cellBegin.clear();
+        cellCount.clear();
+        cellIndices.clear();
+        cellObjectIDs.clear();
+        cellMatrices.clear();
+
+        std::fill(rowOfSlot.begin(), rowOfSlot.end(), NO_ROW);
+    }
+};
@@ -0,0 +1,113 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "RenderView.h"
+#include "../Utils/LOG.h"
+
+// World matrices of everything drawn from one root, kept from frame to frame.
+//
+// The same object shows up once per place it is seen from (A on B, and B through the exit on A ...),
+// so a node is an (object, lineage) pair, not an object. Nodes are stored depth first;
+// world = parent world * grid transform of the cell * local.
+//
+// Update does nothing while the RenderView tick, the root and the depth stay the same.
+// On a new tick the tree is walked again, and every node is matched with the node of the previous tick
+// that came from the same parent node and the same cell. Its world matrix is only recomputed when
+// it is new, its local or cell matrix changed, or its parent's world matrix changed.
+// A static scene costs a walk with a few matrix compares, no multiplication.
+class TransformHierarchy {
+public:
+    std::string GetName() const;
+
+private:
+    void log(LogLevel level, std::string text);
+
+public:
+    static constexpr uint32_t NO_NODE = std::numeric_limits<uint32_t>::max();
+
+    struct Node {
+        uint32_t objectID;
+        uint32_t meshID;
+        uint32_t textureID;
+
+        uint32_t parent;    // NO_NODE for the root
+        uint32_t cell;      // in the parent's grid
+        uint8_t depth;
+
+        // one entry per occupied cell of the view, cellCount of them from childBase. NO_NODE if the node was not expanded.
+        // childCells_[childBase + i]: the cell (ascending), childOfCell_[childBase + i]: the node drawn from it
+        uint32_t childBase;
+        uint32_t cellCount;
+
+        glm::mat4 localMatrix;
+        glm::mat4 cellMatrix;
+        glm::mat4 worldMatrix;
+
+        // worldMatrix was recomputed by the last Update, so are the ones of all children
+        bool changed;
+    };
+
+    TransformHierarchy() = default;
+
+    TransformHierarchy(const TransformHierarchy&) = delete;
+    TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+    // rootRow is a row of view
+    void Update(const RenderView& view, uint32_t rootRow, uint8_t descendDepth);
+
+    const std::vector<Node>& GetNodes() const {
+        return nodes_;
+    }
+
+    // world matrices computed by the last Update that did anything, out of GetNodes().size()
+    size_t GetRecomputedCount() const {
+        return recomputed_;
+    }
+
+    void LogStats();
+
+private:
+    // the node of the previous tick for (previous parent node, cell) if it still shows objectID
+    uint32_t MatchPrevious(uint32_t previousParent, uint32_t cell, uint32_t objectID) const;
+
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> childCells_;
+    std::vector<uint32_t> childOfCell_;
+
+    // last tick's, swapped with the above on every rebuild so they keep their capacity
+    std::vector<Node> previousNodes_;
+    std::vector<uint32_t> previousChildCells_;
+    std::vector<uint32_t> previousChildOfCell_;
+
+    // depth first walk. row of the view, parent node in nodes_, and the matching node of previousNodes_
+    struct Pending {
+        uint32_t row;
+        uint32_t parent;
+        uint32_t cell;
+        // entry of the parent's range, in childOfCell_
+        uint32_t entry;
+        uint32_t cellMatrixIndex;
+        uint8_t depth;
+        uint32_t previous;
+    };
+    std::vector<Pending> stack_;
+    std::vector<uint32_t> lineage_;
+
+    bool hasBuilt_ = false;
+    uint64_t builtTick_ = 0;
+    uint32_t builtRootID_ = 0;
+    uint8_t builtDepth_ = 0;
+
+    size_t recomputed_ = 0;
+
+    // stats
+    uint64_t updates_ = 0;
+    uint64_t skippedUpdates_ = 0;
+    uint64_t totalNodes_ = 0;
+    uint64_t totalRecomputed_ = 0;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Bit tricks on 64 bit words, with the intrinsic of whichever compiler builds us.
+// 32 bit MSVC has no 64 bit versions, the word is done in two halves there.
+namespace BitOps {
+    // index of the lowest set bit. word != 0
+    inline uint32_t CountTrailingZeros(uint64_t word) {
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<uint32_t>(index);
+#elif defined(_MSC_VER)
+        unsigned long index;
+        if (_BitScanForward(&index, static_cast<uint32_t>(word))) {
+            return static_cast<uint32_t>(index);
+        }
+        _BitScanForward(&index, static_cast<uint32_t>(word >> 32));
+        return static_cast<uint32_t>(index) + 32;
+#else
+        return static_cast<uint32_t>(__builtin_ctzll(word));
+#endif
+    }
+
+    inline uint32_t PopCount(uint64_t word) {
+#if defined(_MSC_VER) && defined(_M_X64)
+        return static_cast<uint32_t>(__popcnt64(word));
+#elif defined(_MSC_VER)
+        return __popcnt(static_cast<uint32_t>(word)) + __popcnt(static_cast<uint32_t>(word >> 32));
+#else
+        return static_cast<uint32_t>(__builtin_popcountll(word));
+#endif
+    }
+
+    // the bits [begin, end) of a word set, 0 <= begin <= end <= 64
+    inline uint64_t RangeMask(uint32_t begin, uint32_t end) {
+        if (begin >= end) {
+            return 0;
+        }
+        uint64_t upTo = end >= 64 ? ~0ull : (1ull << end) - 1;
+        return upTo & (~0ull << begin);
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "LOG.h"
+
+// Latency histogram with logarithmic buckets.
+// Each power of two (in nanoseconds) is split into SUB_BUCKETS linear pieces,
+// so a percentile is off by at most 1 / SUB_BUCKETS of its value. Recording is a couple of shifts and an increment.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 2;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int N_BUCKETS = 64 * SUB_BUCKETS;
+
+    void Record(uint64_t nanoseconds);
+
+    // p in [0, 1]. returns the upper bound of the bucket holding the p-th sample
+    uint64_t Percentile(double p) const;
+
+    uint64_t GetCount() const { return count_; }
+    uint64_t GetMax() const { return max_; }
+    uint64_t GetTotal() const { return total_; }
+
+    void Reset();
+
+private:
+    static int BucketOf(uint64_t nanoseconds);
+    static uint64_t UpperBoundOf(int bucket);
+
+    std::array<uint64_t, N_BUCKETS> buckets_{};
+    uint64_t count_ = 0;
+    uint64_t max_ = 0;
+    uint64_t total_ = 0;
+};
+
+// Everything we know about one subscriber
+struct ListenerStats {
+    struct Sample {
+        uint64_t startNs = 0;   // since the profiler was created
+        uint64_t durationNs = 0;
+    };
+
+    // last few calls, kept for the trace export
+    static constexpr size_t N_RECENT_SAMPLES = 256;
+
+    std::string name;
+    LatencyHistogram histogram;
+
+    std::array<Sample, N_RECENT_SAMPLES> recentSamples{};
+    size_t nextSample = 0;
+};
+
+// Collects call counts and latencies of every named event listener
+// (EventDispatcher listeners and EventBus subscribers).
+// Dump() prints p50 / p99 / max per listener. ExportTrace() writes the recent calls
+// in the Chrome trace event format, which chrome://tracing or Perfetto can open.
+//
+// Recording happens on the thread that publishes, which is the game thread since events are queued.
+class ListenerProfiler {
+public:
+    std::string GetName() const;
+
+private:
+    void log(LogLevel level, std::string text);
+
+public:
+    static ListenerProfiler& GetInstance();
+
+    // The returned pointer stays valid for the whole program, listeners keep it next to themselves.
+    // Registering the same name twice returns the same stats.
+    ListenerStats* Register(const std::string& name);
+
+    uint64_t NowNs() const;
+
+    void Record(ListenerStats* stats, uint64_t startNs, uint64_t endNs);
+
+    void Dump();
+
+    bool ExportTrace(const std::string& path);
+
+    void Reset();
+
+    bool enabled = true;
+
+private:
+    ListenerProfiler();
+
+    ListenerProfiler(const ListenerProfiler&) = delete;
+    ListenerProfiler& operator=(const ListenerProfiler&) = delete;
+
+    std::chrono::steady_clock::time_point origin_;
+
+    std::vector<std::unique_ptr<ListenerStats>> stats_;
+};
+
+// Times one listener call
+class ScopedListenerTimer {
+public:
+    explicit ScopedListenerTimer(ListenerStats* stats)
+        : stats_(stats) {
+        if (stats_ != nullptr && ListenerProfiler::GetInstance().enabled) {
+            startNs_ = ListenerProfiler::GetInstance().NowNs();
+        }
+        else {
+            stats_ = nullptr;
+        }
+    }
+
+    ~ScopedListenerTimer() {
+        if (stats_ != nullptr) {
+            ListenerProfiler& profiler = ListenerProfiler::GetInstance();
+            profiler.Record(stats_, startNs_, profiler.NowNs());
+        }
+    }
+
+    ScopedListenerTimer(const ScopedListenerTimer&) = delete;
+    ScopedListenerTimer& operator=(const ScopedListenerTimer&) = delete;
+
+private:
+    ListenerStats* stats_;
+    uint64_t startNs_ = 0;
+};
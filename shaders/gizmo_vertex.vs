@@ -1,9 +1,9 @@
-#version 330 core
-layout (location = 0) in vec3 aPos;
-
-uniform mat4 model;
-uniform mat4 viewProj;
-
-void main() {
-    gl_Position = viewProj * model * vec4(aPos, 1.0);
-}
+#version 330 core
+layout (location = 0) in vec3 aPos;
+
+uniform mat4 model;
+uniform mat4 viewProj;
+
+void main() {
+    gl_Position = viewProj * model * vec4(aPos, 1.0);
+}
@@ -0,0 +1,102 @@
+#ifdef DUCKFISHING_BENCH
+#include "Bench/Bench.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include "Utils/LOG.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    struct Suite {
+        const char* name;
+        void (*run)();
+    };
+
+    const Suite SUITES[] = {
+        { "eventbus", &Bench::RunEventBus },
+        { "update", &Bench::RunUpdate },
+        { "spawn", &Bench::RunSpawn },
+        { "parallel", &Bench::RunParallelUpdate },
+        { "cubenet", &Bench::RunCubeNet },
+        { "grid-churn", &Bench::RunGridChurn },
+        { "move", &Bench::RunMove },
+        { "raycast", &Bench::RunRaycast },
+        { "netcompiler", &Bench::RunNetCompiler },
+    };
+
+    const char* currentSuite = "";
+    int nFailed = 0;
+    volatile uint64_t sink = 0;
+}
+
+namespace Bench {
+    void Report(const std::string& what, double value, const std::string& unit) {
+        std::printf("%-12s %-56s %14.2f %s\n", currentSuite, what.c_str(), value, unit.c_str());
+        std::fflush(stdout);
+    }
+
+    bool Check(bool isOk, const char* what, const char* file, int line) {
+        if (!isOk) {
+            nFailed++;
+            std::printf("%-12s FAILED %s (%s:%d)\n", currentSuite, what, file, line);
+        }
+        return isOk;
+    }
+
+    size_t GetResidentBytes() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return counters.WorkingSetSize;
+        }
+        return 0;
+#else
+        FILE* file = std::fopen("/proc/self/statm", "r");
+        if (file == nullptr) {
+            return 0;
+        }
+        unsigned long pages = 0;
+        unsigned long residentPages = 0;
+        int nRead = std::fscanf(file, "%lu %lu", &pages, &residentPages);
+        std::fclose(file);
+        return nRead == 2 ? residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE)) : 0;
+#endif
+    }
+
+    void Consume(uint64_t value) {
+        sink = sink + value;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // the game logs a line per move, that would be what we measure
+    CURRENT_LOG_LEVEL = LOG_ERROR;
+
+    for (const Suite& suite : SUITES) {
+        bool isPicked = argc <= 1;
+        for (int i = 1; i < argc; i++) {
+            isPicked = isPicked || std::strcmp(argv[i], suite.name) == 0;
+        }
+        if (!isPicked) {
+            continue;
+        }
+
+        currentSuite = suite.name;
+        Bench::Clock::time_point start = Bench::Clock::now();
+        suite.run();
+        std::printf("%-12s done in %.1f s\n\n", suite.name, Bench::SecondsSince(start));
+    }
+
+    std::printf("%d checks failed\n", nFailed);
+    return nFailed;
+}
+#endif
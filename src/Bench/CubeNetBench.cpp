@@ -0,0 +1,123 @@
+#ifdef DUCKFISHING_BENCH
+#include "Bench/Bench.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "Core/GridManager.h"
+#include "Core/GridTopology.h"
+#include "Core/Transform.h"
+
+// The compile time cube nets of edge 1 to 16 against what the runtime builds, and what a cube's topology costs to spawn.
+// The links have to be the same as LinkTorus + LinkCubeNet, the matrices the same as a Transform placed like
+// PlaceCubeNetCell says (the tables use exact quarter turns, a Transform goes through sin and cos).
+namespace {
+    constexpr float MATRIX_TOLERANCE = 1e-5f;
+    constexpr float QUARTER_TURN = 1.57079632679f;
+    constexpr int N_SPAWNS = 2000;
+
+    bool IsSameLink(const CellLink& a, const CellLink& b) {
+        return std::memcmp(a.neighbours, b.neighbours, sizeof(a.neighbours)) == 0 && a.rotations == b.rotations;
+    }
+
+    // what GridTransformManager::InitTransforms used to do with a Transform per cell
+    glm::mat4 TransformMatrix(int edge, int i, int j) {
+        GridTopology::CubeNetPlacement placement = GridTopology::PlaceCubeNetCell(edge, i, j);
+
+        Transform transform;
+        transform.SetTranslation(glm::vec3(placement.x, placement.y, placement.z));
+        if (placement.axis != 0) {
+            glm::vec3 axis = placement.axis == 'x' ? glm::vec3(1, 0, 0) : glm::vec3(0, 0, 1);
+            transform.SetRotation(placement.quarterTurns * QUARTER_TURN, axis);
+        }
+        transform.SetScale(glm::vec3(GridTopology::BLOCK_SIZE));
+        return transform.GetTransformMatrix();
+    }
+
+    void CheckEdge(uint8_t edge) {
+        int width = edge * 6;
+        size_t cellCount = static_cast<size_t>(edge) * width;
+
+        std::vector<CellLink> links(cellCount);
+        GridTopology::LinkTorus(links.data(), edge, width);
+        GridTopology::LinkCubeNet(links.data(), width, 0, 0, edge);
+
+        MovementManager movementManager(edge);
+        GridTransformManager gridTransformManager(edge);
+        bool isPrecomputed = edge <= CubeNet::MAX_PRECOMPUTED_EDGE;
+
+        // precomputed sizes point at the table, the others fold their own
+        BENCH_CHECK(movementManager.IsShared() == isPrecomputed && gridTransformManager.IsShared() == isPrecomputed);
+        if (isPrecomputed) {
+            BENCH_CHECK(movementManager.GetLinks() == CubeNet::GetLinks(edge) && gridTransformManager.GetMatrices() == CubeNet::GetMatrices(edge));
+        }
+
+        bool isSameLinks = movementManager.GetCellCount() == cellCount;
+        for (size_t cell = 0; isSameLinks && cell < cellCount; cell++) {
+            isSameLinks = IsSameLink(movementManager.GetLink(static_cast<uint32_t>(cell)), links[cell]);
+        }
+        BENCH_CHECK(isSameLinks);
+
+        float maxError = 0;
+        for (int i = 0; i < edge; i++) {
+            for (int j = 0; j < width; j++) {
+                glm::mat4 expected = TransformMatrix(edge, i, j);
+                glm::mat4 actual = gridTransformManager.GetCellMatrix(i, j);
+                for (int c = 0; c < 4; c++) {
+                    for (int r = 0; r < 4; r++) {
+                        maxError = std::max(maxError, std::fabs(expected[c][r] - actual[c][r]));
+                    }
+                }
+            }
+        }
+        BENCH_CHECK(maxError <= MATRIX_TOLERANCE);
+    }
+
+    void Measure(uint8_t edge) {
+        size_t cellCount = static_cast<size_t>(edge) * edge * 6;
+        std::vector<std::unique_ptr<MovementManager>> movementManagers(N_SPAWNS);
+        std::vector<std::unique_ptr<GridTransformManager>> gridTransformManagers(N_SPAWNS);
+
+        // the tables of the size
+        double sharedSeconds = Bench::Time([&]() {
+            for (int i = 0; i < N_SPAWNS; i++) {
+                movementManagers[i] = std::make_unique<MovementManager>(edge);
+                gridTransformManagers[i] = std::make_unique<GridTransformManager>(edge);
+            }
+        });
+
+        // folded per object at runtime, like every size did before the tables
+        double foldedSeconds = Bench::Time([&]() {
+            for (int i = 0; i < N_SPAWNS; i++) {
+                movementManagers[i] = std::make_unique<MovementManager>(static_cast<uint16_t>(edge), static_cast<uint16_t>(edge * 6));
+                movementManagers[i]->InitPlanarFigure(0, 0, edge);
+                gridTransformManagers[i] = std::make_unique<GridTransformManager>(static_cast<uint16_t>(edge), static_cast<uint16_t>(edge * 6));
+                gridTransformManagers[i]->InitTransforms(0, 0, edge);
+            }
+        });
+        BENCH_CHECK(!movementManagers[0]->IsShared() && !gridTransformManagers[0]->IsShared());
+        Bench::Consume(movementManagers[0]->GetLink(0).neighbours[0]);
+
+        std::string suffix = "edge " + std::to_string(edge);
+        Bench::Report("spawn us per cube, shared table, " + suffix, sharedSeconds / N_SPAWNS * 1e6, "us");
+        Bench::Report("spawn us per cube, runtime fold, " + suffix, foldedSeconds / N_SPAWNS * 1e6, "us");
+        Bench::Report("topology bytes per cube, runtime fold, " + suffix, static_cast<double>(cellCount * (sizeof(CellLink) + sizeof(CellMatrix))), "B");
+    }
+}
+
+namespace Bench {
+    void RunCubeNet() {
+        // past the tables too, the fallback has to fold the same cube
+        for (int edge = 1; edge <= CubeNet::MAX_PRECOMPUTED_EDGE + 4; edge++) {
+            CheckEdge(static_cast<uint8_t>(edge));
+        }
+
+        for (uint8_t edge : { 4, 16 }) {
+            Measure(edge);
+        }
+    }
+}
+#endif
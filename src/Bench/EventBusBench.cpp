@@ -0,0 +1,102 @@
+#ifdef DUCKFISHING_BENCH
+#include "Bench/Bench.h"
+
+#include <memory>
+#include <vector>
+
+#include "Core/Event.h"
+#include "Core/EventBus.h"
+#include "Network/NetworkMessage.h"
+
+// Events/s through EventBus<T> against the byte listeners of the EventDispatcher, 1 to 64 subscribers.
+// Every byte listener decodes the message again, like they did before the typed bus.
+// Both go through the ListenerProfiler's timers, which cost more than the dispatch itself: measured with it on and off
+namespace {
+    struct BenchEvent {
+        uint32_t playerID;
+        Direction direction;
+    };
+
+    struct Counter {
+        uint64_t total = 0;
+
+        void OnEvent(const BenchEvent& event) {
+            total += event.playerID + static_cast<uint32_t>(event.direction);
+        }
+    };
+
+    constexpr size_t N_DELIVERIES = 1 << 21;
+
+    void Measure(size_t nSubscribers, bool isProfiled) {
+        EventBus<BenchEvent>& bus = EventBus<BenchEvent>::GetInstance();
+        EventDispatcher& dispatcher = EventDispatcher::GetInstance();
+
+        std::vector<uint8_t> bytes = PlayerInputMessage(Direction::LEFT, 7).Serialize();
+        size_t nEvents = N_DELIVERIES / nSubscribers;
+
+        // typed
+        std::vector<Counter> counters(nSubscribers);
+        for (Counter& counter : counters) {
+            bus.Subscribe<&Counter::OnEvent>(&counter, "bench");
+        }
+
+        double typedSeconds = Bench::Time([&]() {
+            for (size_t i = 0; i < nEvents; i++) {
+                bus.Publish(BenchEvent{ static_cast<uint32_t>(i), Direction::LEFT });
+            }
+        });
+
+        uint64_t typedTotal = 0;
+        for (Counter& counter : counters) {
+            typedTotal += counter.total;
+            bus.Unsubscribe<&Counter::OnEvent>(&counter);
+        }
+        BENCH_CHECK(bus.GetSubscriberCount() == 0);
+        BENCH_CHECK(counters[0].total > 0);
+        Bench::Consume(typedTotal);
+
+        // bytes, decoded by every listener
+        uint64_t decodedTotal = 0;
+        std::vector<std::unique_ptr<Listener>> listeners;
+        for (size_t s = 0; s < nSubscribers; s++) {
+            listeners.push_back(std::make_unique<Listener>([&decodedTotal](const std::vector<uint8_t>& data) {
+                PlayerInputMessage message;
+                message.Deserialize(data);
+                decodedTotal += message.playerID + static_cast<uint32_t>(message.playerDirection);
+            }));
+            dispatcher.Subscribe(Tag::TCP, listeners.back().get(), "bench");
+        }
+
+        double byteSeconds = Bench::Time([&]() {
+            for (size_t i = 0; i < nEvents; i++) {
+                dispatcher.Publish(Tag::TCP, bytes);
+            }
+        });
+
+        for (std::unique_ptr<Listener>& listener : listeners) {
+            dispatcher.Unsubscribe(Tag::TCP, listener.get());
+        }
+        BENCH_CHECK(decodedTotal == 3ull * (7 + static_cast<uint32_t>(Direction::LEFT)) * nEvents * nSubscribers);
+
+        std::string suffix = std::to_string(nSubscribers) + " subscribers" + (isProfiled ? "" : ", no profiler");
+        Bench::Report("EventBus<T> events/s, " + suffix, nEvents / typedSeconds, "1/s");
+        Bench::Report("byte listeners events/s, " + suffix, nEvents / byteSeconds, "1/s");
+    }
+}
+
+namespace Bench {
+    void RunEventBus() {
+        ListenerProfiler& profiler = ListenerProfiler::GetInstance();
+
+        for (bool isProfiled : { true, false }) {
+            profiler.enabled = isProfiled;
+
+            for (size_t nSubscribers = 1; nSubscribers <= 64; nSubscribers *= 2) {
+                Measure(nSubscribers, isProfiled);
+            }
+        }
+
+        profiler.enabled = true;
+    }
+}
+#endif
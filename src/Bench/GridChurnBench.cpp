@@ -0,0 +1,218 @@
+#ifdef DUCKFISHING_BENCH
+#include "Bench/Bench.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Core/RidableObject.h"
+
+// The reverse index of RidableObject (object ID -> cell) under heavy churn on a 255 cell grid.
+// Random moves, swaps, removals, exits and stale ids are played against a plain array of the grid, and after every one
+// grid_ and the index have to agree with it. Then the lookups the index replaced (GetPosition, RemoveChildAtGrid,
+// the exit of SetParentObjectAndExit) are timed against the linear scan over the grid they used to be.
+namespace {
+    constexpr uint16_t GRID_HEIGHT = 15;
+    constexpr uint16_t GRID_WIDTH = 17;
+    constexpr uint32_t CELL_COUNT = GRID_HEIGHT * GRID_WIDTH;
+
+    // ids of the objects walking around, more than fit so that the grid stays crowded
+    constexpr uint32_t FIRST_ID = 100;
+    constexpr uint32_t N_IDS = 300;
+    // never spawned, what a cell holds after its object is gone
+    constexpr uint32_t STALE_ID = 99;
+    constexpr uint32_t PARENT_IDS[] = { 1, 2 };
+
+    constexpr int N_CHECKED_OPS = 20000;
+    constexpr int N_TIMED_OPS = 200000;
+
+    // what the grid should hold, cell -> id
+    struct Model {
+        std::vector<uint32_t> cells = std::vector<uint32_t>(CELL_COUNT, 0);
+
+        uint32_t Find(uint32_t objID) const {
+            for (uint32_t cell = 0; cell < CELL_COUNT; cell++) {
+                if (cells[cell] == objID) {
+                    return cell;
+                }
+            }
+            return RidableObject::NO_CELL;
+        }
+
+        // placing an object that stands elsewhere moves it, like WriteCell
+        void Write(uint32_t cell, uint32_t objID) {
+            uint32_t current = objID != 0 ? Find(objID) : RidableObject::NO_CELL;
+            if (current != RidableObject::NO_CELL) {
+                cells[current] = 0;
+            }
+            cells[cell] = objID;
+        }
+    };
+
+    Coord2d ToCoord(uint32_t cell) {
+        return { static_cast<int>(cell / GRID_WIDTH), static_cast<int>(cell % GRID_WIDTH) };
+    }
+
+    bool IsSame(RidableObject& ridable, const Model& model) {
+        if (!ridable.IsGridIndexConsistent()) {
+            return false;
+        }
+        for (uint32_t cell = 0; cell < CELL_COUNT; cell++) {
+            uint32_t objID = model.cells[cell];
+            if (ridable.GetGrid().Get(cell) != objID || (objID != 0 && ridable.FindCell(objID) != cell)) {
+                return false;
+            }
+        }
+        size_t emptyCount = static_cast<size_t>(std::count(model.cells.begin(), model.cells.end(), 0u));
+        return ridable.GetOccupiedCount() == CELL_COUNT - emptyCount;
+    }
+
+    // one random write through the public interface, mirrored on the model
+    void Churn(RidableObject& ridable, Model& model, std::mt19937& random) {
+        uint32_t cell = random() % CELL_COUNT;
+        uint32_t objID = FIRST_ID + random() % N_IDS;
+
+        switch (random() % 8) {
+        case 0:
+        case 1:
+            // walk in, or over from another cell
+            ridable.AddChildObjectToGridAtPosition(objID, ToCoord(cell));
+            model.Write(cell, objID);
+            break;
+        case 2:
+            ridable.SetObjIdAtPos(cell, objID);
+            model.Write(cell, objID);
+            break;
+        case 3: {
+            uint32_t other = random() % CELL_COUNT;
+            ridable.SwapObjOnGrid(ToCoord(cell), ToCoord(other));
+            uint32_t a = model.cells[cell];
+            model.cells[cell] = model.cells[other];
+            model.cells[other] = a;
+            break;
+        }
+        case 4: {
+            // the id may not be on the grid, then nothing happens
+            uint32_t current = model.Find(objID);
+            bool isRemoved = ridable.RemoveChildAtGrid(objID);
+            BENCH_CHECK(isRemoved == (current != RidableObject::NO_CELL));
+            if (current != RidableObject::NO_CELL) {
+                model.cells[current] = 0;
+            }
+            break;
+        }
+        case 5:
+            // somebody left the world without leaving the cell, then the cell is cleared or taken over (WalkOnRidableObjectCommand)
+            ridable.SetObjIdAtCell(cell, STALE_ID);
+            model.Write(cell, STALE_ID);
+            if (random() % 2 == 0) {
+                ridable.SetObjIdAtPos(cell, 0);
+                model.cells[cell] = 0;
+            }
+            else {
+                ridable.SetObjIdAtPos(cell, objID);
+                model.Write(cell, objID);
+            }
+            break;
+        case 6: {
+            // ride on another parent, the exit moves to the new id in the same cell, or to the first free one
+            uint32_t parentID = PARENT_IDS[random() % 2];
+            uint32_t exitCell = ridable.GetExitCell();
+            bool hasExit = ridable.SetParentObjectAndExit(parentID);
+
+            uint32_t free = RidableObject::NO_CELL;
+            for (uint32_t c = 0; c < CELL_COUNT && free == RidableObject::NO_CELL; c++) {
+                free = model.cells[c] == 0 ? c : free;
+            }
+            uint32_t expected = exitCell != RidableObject::NO_CELL ? exitCell : free;
+            BENCH_CHECK(hasExit == (expected != RidableObject::NO_CELL));
+            if (expected != RidableObject::NO_CELL) {
+                model.Write(expected, parentID);
+            }
+            break;
+        }
+        default:
+            // the exit, if there is one, is walked over like any other cell
+            ridable.SetObjIdAtPos(cell, 0);
+            model.cells[cell] = 0;
+            break;
+        }
+    }
+
+    // GetPosition before the index: a scan over the grid
+    uint32_t ScanFor(const RidableObject& ridable, uint32_t objID) {
+        for (uint32_t cell = 0; cell < CELL_COUNT; cell++) {
+            if (ridable.GetGrid().Get(cell) == objID) {
+                return cell;
+            }
+        }
+        return RidableObject::NO_CELL;
+    }
+}
+
+namespace Bench {
+    void RunGridChurn() {
+        std::mt19937 random(37);
+
+        // checked, every op
+        {
+            RidableObject ridable(1000, 0, 0, GRID_HEIGHT, GRID_WIDTH);
+            Model model;
+            bool isSame = true;
+
+            for (int op = 0; op < N_CHECKED_OPS && isSame; op++) {
+                Churn(ridable, model, random);
+                isSame = IsSame(ridable, model);
+            }
+            BENCH_CHECK(isSame);
+            BENCH_CHECK(ridable.FindCell(STALE_ID) == model.Find(STALE_ID));
+        }
+
+        // timed. the grid is filled first, then every op moves somebody and looks somebody up
+        RidableObject ridable(1000, 0, 0, GRID_HEIGHT, GRID_WIDTH);
+        for (uint32_t i = 0; i < CELL_COUNT * 3 / 4; i++) {
+            ridable.SetObjIdAtCell(i * 4 / 3, FIRST_ID + i);
+        }
+
+        std::vector<uint32_t> cells(N_TIMED_OPS);
+        std::vector<uint32_t> ids(N_TIMED_OPS);
+        for (int op = 0; op < N_TIMED_OPS; op++) {
+            cells[op] = random() % CELL_COUNT;
+            ids[op] = FIRST_ID + random() % N_IDS;
+        }
+
+        uint64_t indexed = 0;
+        double churnSeconds = Bench::Time([&]() {
+            for (int op = 0; op < N_TIMED_OPS; op++) {
+                ridable.SetObjIdAtCell(cells[op], ids[op]);
+                indexed += ridable.FindCell(ids[(op * 7) % N_TIMED_OPS]);
+            }
+        });
+        BENCH_CHECK(ridable.IsGridIndexConsistent());
+
+        uint64_t scanned = 0;
+        double indexSeconds = Bench::Time([&]() {
+            for (int op = 0; op < N_TIMED_OPS; op++) {
+                scanned += ridable.FindCell(ids[op]);
+            }
+        });
+        double scanSeconds = Bench::Time([&]() {
+            for (int op = 0; op < N_TIMED_OPS; op++) {
+                scanned += ScanFor(ridable, ids[op]);
+            }
+        });
+
+        bool isSame = true;
+        for (uint32_t i = 0; i < N_IDS; i++) {
+            isSame = isSame && ridable.FindCell(FIRST_ID + i) == ScanFor(ridable, FIRST_ID + i);
+        }
+        BENCH_CHECK(isSame);
+        Bench::Consume(indexed + scanned);
+
+        Report("moves + lookups/s, 255 cells", N_TIMED_OPS / churnSeconds, "1/s");
+        Report("lookups/s, reverse index, 255 cells", N_TIMED_OPS / indexSeconds, "1/s");
+        Report("lookups/s, linear scan, 255 cells", N_TIMED_OPS / scanSeconds, "1/s");
+        Report("occupied cells", static_cast<double>(ridable.GetOccupiedCount()), "");
+    }
+}
+#endif
@@ -0,0 +1,209 @@
+#ifdef DUCKFISHING_BENCH
+#include "Bench/Bench.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Core/GridManager.h"
+
+// Moves/s and memory per cell of the flat CellLink table against the per cell maps it replaced.
+// Before, every cell had a heap std::map<Direction, Coord2d> of where each step leads and a heap ParallelTransporter with a
+// map of std::function rotations and a map of rotation ints. The bench rebuilds that layout from the same links and walks both.
+namespace {
+    constexpr int N_WALKERS = 4096;
+    constexpr int N_STEPS = 256;
+
+    using Action2Coord2d = std::map<Direction, Coord2d>;
+
+    // the old ParallelTransporter, only what Move read of it
+    struct Transporter {
+        std::map<int, std::function<int(int)>> directionInt2RotationInt;
+        std::map<int, int> int2Int;
+
+        Transporter() {
+            for (int i = 0; i < 4; i++) {
+                directionInt2RotationInt[i] = [](int x) { return x; };
+            }
+        }
+    };
+
+    // grid2Transporter and grid2ParallelTransporter, one heap allocation of each per cell
+    struct MappedGrid {
+        int width = 0;
+        std::vector<std::vector<Action2Coord2d*>> grid2Transporter;
+        std::vector<std::vector<Transporter*>> grid2ParallelTransporter;
+
+        MappedGrid(const MovementManager& movementManager) : width(movementManager.GetGridWidth()) {
+            int height = movementManager.GetGridHeight();
+            grid2Transporter.assign(height, std::vector<Action2Coord2d*>(width));
+            grid2ParallelTransporter.assign(height, std::vector<Transporter*>(width));
+
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    CellLink link = movementManager.GetLink(static_cast<uint32_t>(y * width + x));
+                    Action2Coord2d* action2Coord2d = new Action2Coord2d();
+                    Transporter* transporter = new Transporter();
+
+                    for (int d = 0; d < 4; d++) {
+                        (*action2Coord2d)[static_cast<Direction>(d)] = { static_cast<int>(link.neighbours[d] / width), static_cast<int>(link.neighbours[d] % width) };
+
+                        int rotation = link.RotationOf(d);
+                        if (rotation != 0) {
+                            transporter->directionInt2RotationInt[d] = [rotation](int x) { return (x + rotation) & 3; };
+                            transporter->int2Int[d] = rotation;
+                        }
+                    }
+                    grid2Transporter[y][x] = action2Coord2d;
+                    grid2ParallelTransporter[y][x] = transporter;
+                }
+            }
+        }
+
+        ~MappedGrid() {
+            for (size_t y = 0; y < grid2Transporter.size(); y++) {
+                for (size_t x = 0; x < grid2Transporter[y].size(); x++) {
+                    delete grid2Transporter[y][x];
+                    delete grid2ParallelTransporter[y][x];
+                }
+            }
+        }
+
+        // the old MovementManager::Move, less its log line
+        NavigationInfo Move(Coord2d position, Direction movingDirection, Direction facingDirection) {
+            Coord2d target = (*grid2Transporter[position.first][position.second])[movingDirection];
+
+            Transporter* transporter = grid2ParallelTransporter[position.first][position.second];
+            int goingInt = static_cast<int>(movingDirection);
+            std::function<int(int)> rotation = transporter->directionInt2RotationInt.count(goingInt)
+                ? transporter->directionInt2RotationInt[goingInt] : [](int x) { return x; };
+
+            NavigationInfo newInfo = NavigationInfo();
+            newInfo.pos = target;
+            newInfo.direction = static_cast<Direction>(rotation(static_cast<int>(facingDirection)));
+            newInfo.changeOfOrientation = transporter->int2Int[goingInt];
+            return newInfo;
+        }
+    };
+
+    struct Walker {
+        Coord2d position;
+        Direction facing;
+    };
+
+    double ToMB(size_t bytes) {
+        return bytes / (1024.0 * 1024.0);
+    }
+
+    void Measure(const std::string& suffix, MovementManager& movementManager) {
+        std::mt19937 random(41);
+        int height = movementManager.GetGridHeight();
+        int width = movementManager.GetGridWidth();
+        size_t cellCount = movementManager.GetCellCount();
+
+        std::vector<Walker> start(N_WALKERS);
+        std::vector<uint8_t> moves(static_cast<size_t>(N_WALKERS) * N_STEPS);
+        for (Walker& walker : start) {
+            walker = { { static_cast<int>(random() % height), static_cast<int>(random() % width) }, static_cast<Direction>(random() % 4) };
+        }
+        for (uint8_t& move : moves) {
+            move = static_cast<uint8_t>(random() % 4);
+        }
+
+        size_t before = Bench::GetResidentBytes();
+        std::unique_ptr<MappedGrid> mapped = std::make_unique<MappedGrid>(movementManager);
+        size_t mappedBytes = Bench::GetResidentBytes() - before;
+
+        // same walks, same answers, step by step
+        bool isSame = true;
+        for (int i = 0; i < N_WALKERS / 16 && isSame; i++) {
+            Walker a = start[i];
+            Walker b = start[i];
+            for (int step = 0; step < N_STEPS && isSame; step++) {
+                Direction moving = static_cast<Direction>(moves[i * N_STEPS + step]);
+                NavigationInfo x = mapped->Move(a.position, moving, a.facing);
+                NavigationInfo y = movementManager.Move(b.position, moving, b.facing);
+                isSame = x.pos == y.pos && x.direction == y.direction && x.changeOfOrientation == y.changeOfOrientation;
+                a = { x.pos, x.direction };
+                b = { y.pos, y.direction };
+            }
+        }
+        BENCH_CHECK(isSame);
+
+        std::vector<Walker> walkers;
+        uint64_t total = 0;
+
+        double mappedSeconds = Bench::Time([&]() {
+            walkers = start;
+            for (int step = 0; step < N_STEPS; step++) {
+                for (int i = 0; i < N_WALKERS; i++) {
+                    NavigationInfo info = mapped->Move(walkers[i].position, static_cast<Direction>(moves[i * N_STEPS + step]), walkers[i].facing);
+                    walkers[i] = { info.pos, info.direction };
+                }
+            }
+        });
+        total += walkers[0].position.first;
+
+        double flatSeconds = Bench::Time([&]() {
+            walkers = start;
+            for (int step = 0; step < N_STEPS; step++) {
+                for (int i = 0; i < N_WALKERS; i++) {
+                    NavigationInfo info = movementManager.Move(walkers[i].position, static_cast<Direction>(moves[i * N_STEPS + step]), walkers[i].facing);
+                    walkers[i] = { info.pos, info.direction };
+                }
+            }
+        });
+        std::vector<Walker> flatEnd = walkers;
+
+        // every walker at once, the way a tick of many agents goes
+        MovementBatch batch;
+        double batchSeconds = Bench::Time([&]() {
+            batch.Clear();
+            for (const Walker& walker : start) {
+                batch.Add(static_cast<uint32_t>(walker.position.first * width + walker.position.second), Direction::IDLE, walker.facing);
+            }
+            for (int step = 0; step < N_STEPS; step++) {
+                for (int i = 0; i < N_WALKERS; i++) {
+                    batch.moving[i] = moves[i * N_STEPS + step];
+                }
+                movementManager.MoveBatch(batch);
+                batch.cells.swap(batch.targets);
+                batch.facing.swap(batch.newFacing);
+            }
+        });
+
+        bool isSameBatch = true;
+        for (int i = 0; i < N_WALKERS; i++) {
+            isSameBatch = isSameBatch && batch.cells[i] == static_cast<uint32_t>(flatEnd[i].position.first * width + flatEnd[i].position.second)
+                && batch.facing[i] == static_cast<uint8_t>(flatEnd[i].facing);
+        }
+        BENCH_CHECK(isSameBatch);
+        Bench::Consume(total + flatEnd[0].position.second);
+
+        // the flat table of this grid, or nothing if it is shared or worked out from the index
+        size_t flatBytes = movementManager.GetLinks() != nullptr && !movementManager.IsShared() ? cellCount * sizeof(CellLink) : 0;
+        mapped.reset();
+
+        double nMoves = static_cast<double>(N_WALKERS) * N_STEPS;
+        Bench::Report("moves/s, per cell maps, " + suffix, nMoves / mappedSeconds, "1/s");
+        Bench::Report("moves/s, Move, " + suffix, nMoves / flatSeconds, "1/s");
+        Bench::Report("moves/s, MoveBatch, " + suffix, nMoves / batchSeconds, "1/s");
+        Bench::Report("bytes per cell, per cell maps (RSS), " + suffix, static_cast<double>(mappedBytes) / cellCount, "B");
+        Bench::Report("bytes per cell, CellLink table, " + suffix, static_cast<double>(flatBytes) / cellCount, "B");
+        Bench::Report("RSS of the per cell maps, " + suffix, ToMB(mappedBytes), "MB");
+    }
+}
+
+namespace Bench {
+    void RunMove() {
+        MovementManager cube(static_cast<uint8_t>(8));
+        Measure("cube of edge 8", cube);
+
+        // the biggest torus that still stores its links
+        MovementManager torus(static_cast<uint16_t>(256), static_cast<uint16_t>(256));
+        Measure("torus 256 x 256", torus);
+    }
+}
+#endif
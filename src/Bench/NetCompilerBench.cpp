@@ -0,0 +1,205 @@
+#ifdef DUCKFISHING_BENCH
+#include "Bench/Bench.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "Core/NetCompiler.h"
+#include "Core/RidableObject.h"
+#include "Network/Command.h"
+#include "Network/GameState.h"
+#include "Network/NetworkMessage.h"
+#include "Network/WorldSnapshot.h"
+
+// NetCompiler against the tables it has to reproduce, and the ways a compiled net travels.
+// DescribeCube(edge) has to compile to the CubeNet tables of edge 1 to 16. A net has to come back the same through
+// Serialize / Deserialize and the LoadOrCompile cache, and a ridable folded like a net has to stay one over
+// AddRidableObjectMessage and through a snapshot. A file with a link off the grid and a description of a grid
+// over MAX_CELL_COUNT have to be refused.
+namespace {
+    constexpr float MATRIX_TOLERANCE = 1e-5f;
+    constexpr int N_COMPILES = 200;
+    constexpr uint32_t NET_RIDABLE_ID = 1000;
+
+    bool IsSameLink(const CellLink& a, const CellLink& b) {
+        return std::memcmp(a.neighbours, b.neighbours, sizeof(a.neighbours)) == 0 && a.rotations == b.rotations;
+    }
+
+    bool IsSameNet(const CompiledNet& a, const CompiledNet& b) {
+        if (a.gridHeight != b.gridHeight || a.gridWidth != b.gridWidth || a.descriptionHash != b.descriptionHash
+            || a.links.size() != b.links.size() || a.matrices.size() != b.matrices.size()) {
+            return false;
+        }
+        for (size_t cell = 0; cell < a.links.size(); cell++) {
+            if (!IsSameLink(a.links[cell], b.links[cell]) || std::memcmp(a.matrices[cell].m, b.matrices[cell].m, sizeof(CellMatrix)) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    float CheckCube(uint8_t edge) {
+        CompiledNet net;
+        BENCH_CHECK(NetCompiler::Compile(NetCompiler::DescribeCube(edge), net));
+
+        const CellLink* links = CubeNet::GetLinks(edge);
+        const CellMatrix* matrices = CubeNet::GetMatrices(edge);
+        BENCH_CHECK(net.GetCellCount() == static_cast<size_t>(edge) * edge * 6);
+
+        bool isSameLinks = true;
+        float maxError = 0;
+        for (size_t cell = 0; cell < net.GetCellCount(); cell++) {
+            isSameLinks = isSameLinks && IsSameLink(net.links[cell], links[cell]);
+            for (int k = 0; k < 16; k++) {
+                maxError = std::max(maxError, std::fabs(net.matrices[cell].m[k] - matrices[cell].m[k]));
+            }
+        }
+        BENCH_CHECK(isSameLinks);
+        BENCH_CHECK(maxError <= MATRIX_TOLERANCE);
+        return maxError;
+    }
+
+    void CheckSerialize(const CompiledNet& net) {
+        std::vector<uint8_t> bytes = NetCompiler::Serialize(net);
+        CompiledNet read;
+        BENCH_CHECK(NetCompiler::Deserialize(bytes.data(), bytes.size(), read) && IsSameNet(net, read));
+
+        // cut short, or a neighbour one past the last cell
+        BENCH_CHECK(!NetCompiler::Deserialize(bytes.data(), bytes.size() - 1, read));
+
+        NetFormat::Header header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        uint32_t cellCount = static_cast<uint32_t>(net.GetCellCount());
+        uint32_t cell = cellCount / 2;
+        std::memcpy(bytes.data() + header.linkOffset + cell * sizeof(CellLink) + sizeof(uint32_t) * 2, &cellCount, sizeof(cellCount));
+
+        BENCH_CHECK(!NetCompiler::Deserialize(bytes.data(), bytes.size(), read));
+        BENCH_CHECK(read.links.empty() && read.matrices.empty());
+    }
+
+    void CheckDescription(const NetDescription& description) {
+        std::vector<uint8_t> bytes = NetCompiler::SerializeDescription(description);
+        NetDescription read;
+        BENCH_CHECK(NetCompiler::DeserializeDescription(bytes.data(), bytes.size(), read));
+        BENCH_CHECK(NetCompiler::Hash(read) == NetCompiler::Hash(description));
+
+        bytes.pop_back();
+        BENCH_CHECK(!NetCompiler::DeserializeDescription(bytes.data(), bytes.size(), read));
+        bytes.push_back(0);
+        bytes.push_back(0);
+        BENCH_CHECK(!NetCompiler::DeserializeDescription(bytes.data(), bytes.size(), read));
+
+        // a grid nobody can hold, refused before it is allocated
+        NetDescription huge = description;
+        huge.gridHeight = 65535;
+        huge.gridWidth = 65535;
+        bytes = NetCompiler::SerializeDescription(huge);
+        CompiledNet net;
+        BENCH_CHECK(!NetCompiler::DeserializeDescription(bytes.data(), bytes.size(), read));
+        BENCH_CHECK(!NetCompiler::Compile(huge, net) && net.links.empty());
+
+        NetDescription turned = description;
+        turned.gluings[0].foldDegrees += 1;
+        BENCH_CHECK(NetCompiler::IsSameDescription(description, description) && !NetCompiler::IsSameDescription(description, turned));
+    }
+
+    // compiled and written, then read back, then another shape on the same path compiles again
+    void CheckCache(const NetDescription& description, const NetDescription& other) {
+        std::string path = (std::filesystem::temp_directory_path() / "duckfishing_bench.net").string();
+        std::filesystem::remove(path);
+
+        std::shared_ptr<const CompiledNet> compiled = NetCompiler::LoadOrCompile(description, path);
+        BENCH_CHECK(compiled != nullptr && std::filesystem::exists(path));
+
+        std::shared_ptr<const CompiledNet> loaded = NetCompiler::LoadOrCompile(description, path);
+        BENCH_CHECK(loaded != nullptr && IsSameNet(*compiled, *loaded));
+        BENCH_CHECK(NetCompiler::Hash(loaded->description) == NetCompiler::Hash(description));
+
+        std::shared_ptr<const CompiledNet> recompiled = NetCompiler::LoadOrCompile(other, path);
+        BENCH_CHECK(recompiled != nullptr && recompiled->descriptionHash == NetCompiler::Hash(other));
+
+        std::filesystem::remove(path);
+    }
+
+    // the ridable of gameState is folded like description, with its tables shared through GetNet
+    bool IsNetRidable(GameState& gameState, const NetDescription& description) {
+        RidableObject* ridable = dynamic_cast<RidableObject*>(gameState.GetGameObject(NET_RIDABLE_ID));
+        return ridable != nullptr && ridable->GetNet() != nullptr
+            && ridable->GetNet()->descriptionHash == NetCompiler::Hash(description)
+            && ridable->GetMovementManager()->GetLinks() == ridable->GetNet()->links.data()
+            && ridable->GetNet() == gameState.GetNet(description);
+    }
+
+    void CheckReplication(const NetDescription& description) {
+        std::unique_ptr<GameState> host = std::make_unique<GameState>();
+        host->AddRidableObject(NET_RIDABLE_ID, 0, 0, description);
+        BENCH_CHECK(IsNetRidable(*host, description));
+
+        // over the network, like SubWorldStreamer::SendShell sends it
+        AddRidableObjectMessage message;
+        message.objID_ = NET_RIDABLE_ID;
+        message.gridHeight_ = description.gridHeight;
+        message.gridWidth = description.gridWidth;
+        message.net_ = NetCompiler::SerializeDescription(description);
+
+        std::vector<uint8_t> bytes = message.Serialize();
+        std::unique_ptr<INetworkMessage> received = MessageFactory::CreateMessage(bytes);
+        BENCH_CHECK(received != nullptr && received->GetSize() == bytes.size());
+
+        std::unique_ptr<GameState> client = std::make_unique<GameState>();
+        BENCH_CHECK(!GameMessageProcessor::RecordMessage(*received, client->GetCommandBuffer(), 0));
+        GameMessageProcessor::ProcessMessage(*received)->Execute(*client);
+        BENCH_CHECK(IsNetRidable(*client, description));
+
+        // saved and loaded
+        std::vector<uint8_t> snapshot = WorldSnapshot::Capture(*host);
+        std::unique_ptr<GameState> restored = std::make_unique<GameState>();
+        BENCH_CHECK(WorldSnapshot::Restore(*restored, snapshot.data(), snapshot.size()));
+        BENCH_CHECK(IsNetRidable(*restored, description));
+    }
+}
+
+namespace Bench {
+    void RunNetCompiler() {
+        float maxError = 0;
+        for (int edge = 1; edge <= CubeNet::MAX_PRECOMPUTED_EDGE; edge++) {
+            maxError = std::max(maxError, CheckCube(static_cast<uint8_t>(edge)));
+        }
+
+        NetDescription box = NetCompiler::DescribeBox(6, 4, 3);
+        NetDescription cube = NetCompiler::DescribeCube(16);
+
+        CompiledNet boxNet;
+        BENCH_CHECK(NetCompiler::Compile(box, boxNet));
+        CheckSerialize(boxNet);
+        CheckDescription(box);
+        CheckCache(box, cube);
+        CheckReplication(box);
+
+        // what the first ridable of a shape costs: compiled, or read from the cache
+        CompiledNet net;
+        double compileSeconds = Bench::Time([&]() {
+            for (int i = 0; i < N_COMPILES; i++) {
+                NetCompiler::Compile(cube, net);
+            }
+        });
+
+        std::vector<uint8_t> bytes = NetCompiler::Serialize(net);
+        double deserializeSeconds = Bench::Time([&]() {
+            for (int i = 0; i < N_COMPILES; i++) {
+                NetCompiler::Deserialize(bytes.data(), bytes.size(), net);
+            }
+        });
+        Bench::Consume(net.links[0].neighbours[0]);
+
+        Report("max matrix error against the CubeNet tables, edge 1 to 16", maxError, "");
+        Report("bytes of the description, box 6 x 4 x 3", static_cast<double>(NetCompiler::SerializeDescription(box).size()), "B");
+        Report("compile us, cube of edge 16", compileSeconds / N_COMPILES * 1e6, "us");
+        Report("deserialize us (checked), cube of edge 16", deserializeSeconds / N_COMPILES * 1e6, "us");
+    }
+}
+#endif
@@ -0,0 +1,95 @@
+#ifdef DUCKFISHING_BENCH
+#include "Bench/Bench.h"
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Core/ComponentStore.h"
+#include "Core/JobSystem.h"
+#include "Network/GameState.h"
+
+// GameState::UpdateGameState at 50k objects on 1 to 8 threads of the job system.
+// The world has to come out the same whatever the thread count: every row spun exactly once per tick.
+namespace {
+    constexpr uint32_t N_OBJECTS = 50000;
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+    constexpr int N_TICKS = 20;
+
+    std::unique_ptr<GameState> MakeWorld() {
+        std::unique_ptr<GameState> gameState = std::make_unique<GameState>();
+        gameState->GetComponentStore().Reserve(N_OBJECTS);
+
+        for (uint32_t i = 0; i < N_OBJECTS; i++) {
+            gameState->AddRidableObject(0, 0, 0, 2, 0);
+        }
+        // the spawns are published with the first tick, keep them out of the measurement
+        gameState->UpdateGameState(DELTA_TIME);
+        return gameState;
+    }
+
+    // the rotation of every object, in objectID order
+    std::vector<glm::quat> Rotations(GameState& gameState) {
+        ComponentStore& store = gameState.GetComponentStore();
+        std::vector<glm::quat> rotations;
+
+        std::vector<uint32_t> ids = store.objectIDs;
+        std::sort(ids.begin(), ids.end());
+        for (uint32_t id : ids) {
+            rotations.push_back(store.transforms[store.IndexOf(id)].GetRotationQuat());
+        }
+        return rotations;
+    }
+}
+
+namespace Bench {
+    void RunParallelUpdate() {
+        std::vector<glm::quat> reference;
+        double serialSeconds = 0;
+
+        for (size_t nThreads : { 1, 2, 4, 8 }) {
+            std::unique_ptr<GameState> gameState = MakeWorld();
+            JobSystem jobSystem(nThreads - 1);
+            gameState->SetJobSystem(&jobSystem);
+
+            double seconds = Time([&]() {
+                for (int tick = 0; tick < N_TICKS; tick++) {
+                    gameState->UpdateGameState(DELTA_TIME);
+                }
+            }, 1);
+
+            std::vector<glm::quat> rotations = Rotations(*gameState);
+            if (nThreads == 1) {
+                reference = rotations;
+                serialSeconds = seconds;
+            }
+            bool isSame = rotations.size() == reference.size();
+            for (size_t i = 0; isSame && i < rotations.size(); i++) {
+                isSame = rotations[i].w == reference[i].w && rotations[i].x == reference[i].x
+                    && rotations[i].y == reference[i].y && rotations[i].z == reference[i].z;
+            }
+            BENCH_CHECK(isSame);
+
+            if (nThreads == 1) {
+                // what the job system gets to split, the rest of the tick (journal, render view) stays on the game thread
+                ComponentStore& store = gameState->GetComponentStore();
+                double rowSeconds = Time([&]() {
+                    for (int tick = 0; tick < N_TICKS; tick++) {
+                        store.Spin(DELTA_TIME, glm::vec3(1, 1, 1));
+                        store.UpdateLocalMatrices();
+                    }
+                }, 1);
+                Report("share of the tick split over threads", rowSeconds / seconds * 100, "%");
+            }
+
+            gameState->SetJobSystem(nullptr);
+
+            std::string suffix = std::to_string(N_OBJECTS) + " objects, " + std::to_string(nThreads) + " threads";
+            Report("ticks/s, " + suffix, N_TICKS / seconds, "1/s");
+            Report("speedup over 1 thread, " + suffix, serialSeconds / seconds, "x");
+        }
+        Report("hardware threads", std::thread::hardware_concurrency(), "");
+    }
+}
+#endif
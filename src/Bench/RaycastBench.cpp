@@ -0,0 +1,144 @@
+#ifdef DUCKFISHING_BENCH
+#include "Bench/Bench.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "Core/JobSystem.h"
+#include "Core/RidableObject.h"
+#include "Network/GameState.h"
+
+// Rays/s of GameState::CastRays on cubes of edge 16 and tori, with a tenth or a hundredth of the cells taken.
+// The reference is what gameplay had before the raycast: MovementManager::Move step by step, facing the way it walks,
+// looking at the grid after every step. Both have to stop at the same cell, after the same steps, heading the same way.
+namespace {
+    constexpr int N_GRIDS = 8;
+    constexpr uint8_t CUBE_EDGE = 16;
+    constexpr size_t N_RAYS = 100000;
+    constexpr uint16_t MAX_DISTANCE = 64;
+
+    // the same ray with Move, the way it was done by hand
+    Ray StepByStep(RidableObject& ridable, const Ray& query) {
+        MovementManager* movementManager = ridable.GetMovementManager();
+        uint16_t width = ridable.GetGridWidth();
+
+        Ray ray = query;
+        ray.lastCell = ray.fromCell;
+        ray.heading = ray.direction;
+
+        Coord2d position = { static_cast<int>(ray.fromCell / width), static_cast<int>(ray.fromCell % width) };
+        for (uint16_t step = 1; step <= ray.maxDistance; step++) {
+            NavigationInfo info = movementManager->Move(position, ray.heading, ray.heading);
+            uint32_t cell = static_cast<uint32_t>(info.pos.first * width + info.pos.second);
+            ray.heading = info.direction;
+
+            if (cell == ray.fromCell) {
+                break;
+            }
+            if (ridable.GetGrid().Get(cell) != 0) {
+                ray.hitCell = cell;
+                ray.hitObjectID = ridable.GetGrid().Get(cell);
+                ray.distance = step;
+                break;
+            }
+
+            position = info.pos;
+            ray.lastCell = cell;
+            ray.distance = step;
+        }
+        return ray;
+    }
+
+    bool IsSameRay(const Ray& a, const Ray& b) {
+        return a.lastCell == b.lastCell && a.hitCell == b.hitCell && a.hitObjectID == b.hitObjectID
+            && a.distance == b.distance && a.heading == b.heading;
+    }
+
+    void Measure(const std::string& grids, uint16_t gridHeight, uint16_t gridWidth, size_t cellsPerObject) {
+        std::string suffix = grids + ", 1 in " + std::to_string(cellsPerObject) + " cells taken";
+        std::mt19937 random(46);
+        std::unique_ptr<GameState> gameState = std::make_unique<GameState>();
+
+        std::vector<uint32_t> ridableIDs;
+        for (int i = 0; i < N_GRIDS; i++) {
+            uint32_t id = static_cast<uint32_t>(1000 + i);
+            gameState->AddRidableObject(id, 0, 0, gridHeight, gridWidth);
+            ridableIDs.push_back(id);
+
+            RidableObject* ridable = dynamic_cast<RidableObject*>(gameState->GetGameObject(id));
+            size_t cellCount = ridable->GetCellCount();
+            for (size_t k = 0; k < cellCount / cellsPerObject; k++) {
+                ridable->SetObjIdAtCell(random() % cellCount, static_cast<uint32_t>(1 + k));
+            }
+        }
+
+        std::vector<GameState::RayQuery> queries(N_RAYS);
+        for (GameState::RayQuery& query : queries) {
+            query.ridableID = ridableIDs[random() % N_GRIDS];
+            RidableObject* ridable = dynamic_cast<RidableObject*>(gameState->GetGameObject(query.ridableID));
+            query.ray.fromCell = static_cast<uint32_t>(random() % ridable->GetCellCount());
+            query.ray.direction = static_cast<Direction>(random() % 4);
+            query.ray.maxDistance = MAX_DISTANCE;
+        }
+        std::vector<RidableObject*> ridables(N_RAYS);
+        for (size_t i = 0; i < N_RAYS; i++) {
+            ridables[i] = dynamic_cast<RidableObject*>(gameState->GetGameObject(queries[i].ridableID));
+        }
+
+        std::vector<Ray> stepped(N_RAYS);
+        double stepSeconds = Bench::Time([&]() {
+            for (size_t i = 0; i < N_RAYS; i++) {
+                stepped[i] = StepByStep(*ridables[i], queries[i].ray);
+            }
+        });
+
+        double castSeconds = Bench::Time([&]() {
+            gameState->CastRays(queries);
+        });
+
+        bool isSame = true;
+        uint64_t nHits = 0;
+        uint64_t nSteps = 0;
+        for (size_t i = 0; i < N_RAYS && isSame; i++) {
+            isSame = IsSameRay(queries[i].ray, stepped[i]);
+            nHits += queries[i].ray.hitCell != Ray::NO_HIT;
+            nSteps += queries[i].ray.distance;
+        }
+        BENCH_CHECK(isSame);
+
+        // the same queries over the job system
+        size_t nThreads = std::max<size_t>(2, std::thread::hardware_concurrency());
+        JobSystem jobSystem(nThreads - 1);
+        gameState->SetJobSystem(&jobSystem);
+        double parallelSeconds = Bench::Time([&]() {
+            gameState->CastRays(queries);
+        });
+        gameState->SetJobSystem(nullptr);
+
+        bool isSameParallel = true;
+        for (size_t i = 0; i < N_RAYS && isSameParallel; i++) {
+            isSameParallel = IsSameRay(queries[i].ray, stepped[i]);
+        }
+        BENCH_CHECK(isSameParallel);
+
+        Bench::Report("rays/s, Move step by step, " + suffix, N_RAYS / stepSeconds, "1/s");
+        Bench::Report("rays/s, CastRays, " + suffix, N_RAYS / castSeconds, "1/s");
+        Bench::Report("rays/s, CastRays on " + std::to_string(nThreads) + " threads, " + suffix, N_RAYS / parallelSeconds, "1/s");
+        Bench::Report("rays that hit, " + suffix, static_cast<double>(nHits) / N_RAYS * 100, "%");
+        Bench::Report("steps per ray, " + suffix, static_cast<double>(nSteps) / N_RAYS, "");
+    }
+}
+
+namespace Bench {
+    void RunRaycast() {
+        // a width of 0 makes a cube of that edge, see GameState::AddRidableObject
+        for (size_t cellsPerObject : { 10, 100 }) {
+            Measure("cubes of edge 16", CUBE_EDGE, 0, cellsPerObject);
+            Measure("tori 96 x 96", 96, 96, cellsPerObject);
+        }
+    }
+}
+#endif
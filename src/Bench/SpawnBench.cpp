@@ -0,0 +1,78 @@
+#ifdef DUCKFISHING_BENCH
+#include "Bench/Bench.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "Core/MemoryPool.h"
+#include "Network/GameState.h"
+
+// Spawn and despawn of a world of 10k cube objects, with the resident set size before, in between and after.
+// A room comes and goes three times: the pools keep their chunks while the room is alive and give them back when it ends,
+// so the later rooms must not end up bigger than the first.
+namespace {
+    constexpr uint32_t N_CUBES = 10000;
+    constexpr int N_ROOMS = 3;
+    // a room that fits into what the heap already had barely moves RSS, a page here or there is noise
+    constexpr double RSS_NOISE_BYTES = 1024.0 * 1024.0;
+
+    double ToMB(size_t bytes) {
+        return bytes / (1024.0 * 1024.0);
+    }
+
+    void Measure(uint8_t edge) {
+        std::string suffix = std::to_string(N_CUBES) + " cubes of edge " + std::to_string(edge);
+
+        size_t before = Bench::GetResidentBytes();
+        size_t firstSpawned = 0;
+        size_t lastSpawned = 0;
+        double spawnSeconds = 0;
+        double despawnSeconds = 0;
+
+        for (int room = 0; room < N_ROOMS; room++) {
+            std::unique_ptr<GameState> gameState = std::make_unique<GameState>();
+
+            Bench::Clock::time_point start = Bench::Clock::now();
+            for (uint32_t i = 0; i < N_CUBES; i++) {
+                gameState->AddRidableObject(0, 0, 0, edge, 0);
+            }
+            double seconds = Bench::SecondsSince(start);
+            spawnSeconds = room == 0 ? seconds : std::min(spawnSeconds, seconds);
+
+            BENCH_CHECK(gameState->GetComponentStore().Size() == N_CUBES);
+            lastSpawned = Bench::GetResidentBytes();
+            if (room == 0) {
+                firstSpawned = lastSpawned;
+            }
+
+            // the room ends. ~GameState tears everything down and releases the pools
+            start = Bench::Clock::now();
+            gameState.reset();
+            seconds = Bench::SecondsSince(start);
+            despawnSeconds = room == 0 ? seconds : std::min(despawnSeconds, seconds);
+        }
+        size_t after = Bench::GetResidentBytes();
+
+        // some slack, the heap under the pools and the columns doesn't come back in the same shape.
+        // signed, RSS may well end up below where it started when the heap already had the room
+        double firstGrowth = static_cast<double>(firstSpawned) - static_cast<double>(before);
+        double lastGrowth = static_cast<double>(lastSpawned) - static_cast<double>(before);
+        BENCH_CHECK(lastGrowth <= std::max(firstGrowth, 0.0) * 5 / 4 + RSS_NOISE_BYTES);
+
+        Bench::Report("spawn ms, " + suffix, spawnSeconds * 1000, "ms");
+        Bench::Report("despawn ms, " + suffix, despawnSeconds * 1000, "ms");
+        Bench::Report("RSS before, " + suffix, ToMB(before), "MB");
+        Bench::Report("RSS spawned, first room, " + suffix, ToMB(firstSpawned), "MB");
+        Bench::Report("RSS spawned, " + suffix, ToMB(lastSpawned), "MB");
+        Bench::Report("RSS after, " + suffix, ToMB(after), "MB");
+    }
+}
+
+namespace Bench {
+    void RunSpawn() {
+        for (uint8_t edge : { 2, 8 }) {
+            Measure(edge);
+        }
+    }
+}
+#endif
@@ -0,0 +1,117 @@
+#ifdef DUCKFISHING_BENCH
+#include "Bench/Bench.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/ComponentStore.h"
+#include "Core/GameObject.h"
+#include "Core/Transform.h"
+#include "Network/DeferredCommandBuffer.h"
+
+// Per tick update throughput at 10k and 100k objects.
+// Before the component store GameState walked an unordered_map of objects, each with its own heap Transform, and called Update(deltaTime).
+// Now the same spin and local matrices are one pass over the store's columns, with GameObject::Tick in between like GameState::UpdateGameState does.
+namespace {
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+    constexpr int N_TICKS = 20;
+
+    bool IsSameRotation(const glm::quat& a, const glm::quat& b) {
+        return a.w == b.w && a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+
+    void Measure(uint32_t nObjects) {
+        // before: hash map of objects with their own transforms
+        std::unordered_map<uint32_t, std::unique_ptr<GameObject>> mapped;
+        std::vector<glm::mat4> mappedMatrices(nObjects);
+
+        // after: the same objects bound to a store
+        ComponentStore store;
+        std::vector<std::unique_ptr<GameObject>> stored;
+        DeferredCommandBuffer deferred;
+
+        store.Reserve(nObjects);
+        for (uint32_t id = 1; id <= nObjects; id++) {
+            mapped[id] = std::make_unique<GameObject>(id, 0, 0);
+            mapped[id]->SetTransform(new Transform());
+            mapped[id]->ptrNodeTransform_->SetTranslation(glm::vec3(static_cast<float>(id), 0, 0));
+
+            stored.push_back(std::make_unique<GameObject>(id, 0, 0));
+            store.Add(id, stored.back().get());
+            stored.back()->componentStore_ = &store;
+            stored.back()->ptrNodeTransform_->SetTranslation(glm::vec3(static_cast<float>(id), 0, 0));
+        }
+
+        auto tickMapped = [&]() {
+            size_t i = 0;
+            for (auto& entry : mapped) {
+                entry.second->Update(DELTA_TIME);
+                mappedMatrices[i++] = entry.second->ptrNodeTransform_->GetTransformMatrix();
+            }
+        };
+
+        auto tickStored = [&]() {
+            store.Spin(DELTA_TIME, glm::vec3(1, 1, 1));
+            for (size_t i = 0; i < store.Size(); i++) {
+                deferred.SetIssuer(store.objectIDs[i]);
+                store.owners[i]->Tick(DELTA_TIME, deferred);
+            }
+            store.UpdateLocalMatrices();
+        };
+
+        // both spin the same way, and the objects still find their transforms in the store
+        tickMapped();
+        tickStored();
+        bool isSame = true;
+        for (const std::unique_ptr<GameObject>& object : stored) {
+            ComponentStore::Index index = store.IndexOf(object->GetID());
+            isSame = isSame && index != ComponentStore::INVALID_INDEX
+                && object->ptrNodeTransform_ == &store.transforms[index]
+                && IsSameRotation(store.transforms[index].GetRotationQuat(), mapped[object->GetID()]->ptrNodeTransform_->GetRotationQuat());
+        }
+        BENCH_CHECK(isSame);
+        BENCH_CHECK(store.Size() == nObjects);
+
+        double mappedSeconds = Bench::Time([&]() {
+            for (int tick = 0; tick < N_TICKS; tick++) {
+                tickMapped();
+            }
+        });
+        double storedSeconds = Bench::Time([&]() {
+            for (int tick = 0; tick < N_TICKS; tick++) {
+                tickStored();
+            }
+        });
+        Bench::Consume(static_cast<uint64_t>(mappedMatrices[0][3][0] + store.localMatrices[0][3][0]));
+
+        std::string suffix = std::to_string(nObjects) + " objects";
+        Bench::Report("unordered_map + heap transforms, objects/s, " + suffix, nObjects * N_TICKS / mappedSeconds, "1/s");
+        Bench::Report("component store, objects/s, " + suffix, nObjects * N_TICKS / storedSeconds, "1/s");
+
+        // removals move the last row into the hole, the moved objects have to follow
+        for (size_t i = 0; i < stored.size(); i += 3) {
+            stored[i].reset();
+        }
+        bool isBound = true;
+        for (const std::unique_ptr<GameObject>& object : stored) {
+            if (object) {
+                ComponentStore::Index index = store.IndexOf(object->GetID());
+                isBound = isBound && index != ComponentStore::INVALID_INDEX
+                    && object->ptrNodeTransform_ == &store.transforms[index]
+                    && store.transforms[index].GetTranslation().x == static_cast<float>(object->GetID());
+            }
+        }
+        BENCH_CHECK(isBound);
+        BENCH_CHECK(store.Size() == nObjects - (nObjects + 2) / 3);
+    }
+}
+
+namespace Bench {
+    void RunUpdate() {
+        for (uint32_t nObjects : { 10000u, 100000u }) {
+            Measure(nObjects);
+        }
+    }
+}
+#endif
@@ -1,7 +1,7 @@
-#include "../../include/Core/ApplicationConfig.h"
-
-
-// Initialize static members
-bool ApplicationConfig::quit = false;
-int ApplicationConfig::screenWidth = 1280;
+#include "../../include/Core/ApplicationConfig.h"
+
+
+// Initialize static members
+bool ApplicationConfig::quit = false;
+int ApplicationConfig::screenWidth = 1280;
 int ApplicationConfig::screenHeight = 960;
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include "Core/ComponentStore.h"
+#include "Core/GameObject.h"
+#include "Core/Transform.h"
+#include "Network/ChangeJournal.h"
+
+std::string ComponentStore::GetName() const { return "ComponentStore"; }
+
+void ComponentStore::log(LogLevel level, std::string text) {
+    LOG(level, GetName() + "::" + text);
+}
+
+ComponentStore::Index ComponentStore::Add(uint32_t objectID, GameObject* owner) {
+    if (Contains(objectID)) {
+        log(LOG_WARNING, "ObjID: " + std::to_string(objectID) + " is already stored. Replacing it");
+        Remove(objectID);
+    }
+
+    Index index = static_cast<Index>(objectIDs.size());
+    uint32_t slot = ObjectHandle::IndexOf(objectID);
+
+    if (slot >= sparse_.size()) {
+        sparse_.resize(static_cast<size_t>(slot) + 1, INVALID_INDEX);
+    }
+    sparse_[slot] = index;
+
+    // the transforms column may move when it grows.
+    // everybody pointing into it has to follow
+    const Transform* previousData = transforms.data();
+
+    // usually there is none yet and it is built right here.
+    // one given through SetTransform before the object was stored is copied in
+    if (owner->ptrNodeTransform_ != nullptr) {
+        transforms.push_back(*owner->ptrNodeTransform_);
+        delete owner->ptrNodeTransform_;
+    }
+    else {
+        transforms.emplace_back();
+    }
+
+    objectIDs.push_back(objectID);
+    owners.push_back(owner);
+    localMatrices.push_back(transforms.back().GetTransformMatrix());
+    meshIDs.push_back(owner->meshID_);
+    textureIDs.push_back(owner->textureID_);
+    parentIDs.push_back(owner->parentID_);
+    gridOwnerIDs.push_back(0);
+    gridCells.push_back(NO_CELL);
+
+    if (transforms.data() != previousData) {
+        RebindAllTransforms();
+    }
+    else {
+        RebindTransform(index);
+    }
+
+    return index;
+}
+
+void ComponentStore::Remove(uint32_t objectID) {
+    Index index = IndexOf(objectID);
+
+    if (index == INVALID_INDEX) {
+        log(LOG_WARNING, "ObjID: " + std::to_string(objectID) + " is not stored");
+        return;
+    }
+
+    // hand a private copy of the transform back to the leaving object
+    GameObject* owner = owners[index];
+    Transform* transform = new Transform(transforms[index]);
+
+    Erase(objectID);
+    owner->ptrNodeTransform_ = transform;
+}
+
+void ComponentStore::Erase(uint32_t objectID) {
+    Index index = IndexOf(objectID);
+
+    if (index == INVALID_INDEX) {
+        log(LOG_WARNING, "ObjID: " + std::to_string(objectID) + " is not stored");
+        return;
+    }
+
+    owners[index]->ptrNodeTransform_ = nullptr;
+
+    Index last = static_cast<Index>(objectIDs.size() - 1);
+
+    if (index != last) {
+        // fill the hole with the last row
+        objectIDs[index] = objectIDs[last];
+        owners[index] = owners[last];
+        transforms[index] = transforms[last];
+        localMatrices[index] = localMatrices[last];
+        meshIDs[index] = meshIDs[last];
+        textureIDs[index] = textureIDs[last];
+        parentIDs[index] = parentIDs[last];
+        gridOwnerIDs[index] = gridOwnerIDs[last];
+        gridCells[index] = gridCells[last];
+
+        sparse_[ObjectHandle::IndexOf(objectIDs[index])] = index;
+        RebindTransform(index);
+    }
+
+    objectIDs.pop_back();
+    owners.pop_back();
+    transforms.pop_back();
+    localMatrices.pop_back();
+    meshIDs.pop_back();
+    textureIDs.pop_back();
+    parentIDs.pop_back();
+    gridOwnerIDs.pop_back();
+    gridCells.pop_back();
+
+    sparse_[ObjectHandle::IndexOf(objectID)] = INVALID_INDEX;
+}
+
+void ComponentStore::Reserve(size_t capacity) {
+    const Transform* previousData = transforms.data();
+
+    objectIDs.reserve(capacity);
+    owners.reserve(capacity);
+    transforms.reserve(capacity);
+    localMatrices.reserve(capacity);
+    meshIDs.reserve(capacity);
+    textureIDs.reserve(capacity);
+    parentIDs.reserve(capacity);
+    gridOwnerIDs.reserve(capacity);
+    gridCells.reserve(capacity);
+
+    if (transforms.data() != previousData) {
+        RebindAllTransforms();
+    }
+}
+
+void ComponentStore::SetMeshID(uint32_t objectID, uint32_t meshID) {
+    Index index = IndexOf(objectID);
+    if (index != INVALID_INDEX) {
+        meshIDs[index] = meshID;
+    }
+}
+
+void ComponentStore::SetTextureID(uint32_t objectID, uint32_t textureID) {
+    Index index = IndexOf(objectID);
+    if (index != INVALID_INDEX) {
+        textureIDs[index] = textureID;
+    }
+}
+
+void ComponentStore::SetParentID(uint32_t objectID, uint32_t parentID) {
+    Index index = IndexOf(objectID);
+    if (index != INVALID_INDEX && parentIDs[index] != parentID) {
+        parentIDs[index] = parentID;
+
+        if (journal_ != nullptr) {
+            journal_->RecordReparent(objectID, parentID);
+        }
+    }
+}
+
+void ComponentStore::MarkTransformChanged(uint32_t objectID) {
+    if (journal_ != nullptr && Contains(objectID)) {
+        journal_->RecordTransform(objectID);
+    }
+}
+
+void ComponentStore::SetGridCell(uint32_t objectID, uint32_t gridOwnerID, uint32_t cell) {
+    Index index = IndexOf(objectID);
+    if (index != INVALID_INDEX) {
+        gridOwnerIDs[index] = gridOwnerID;
+        gridCells[index] = cell;
+    }
+}
+
+void ComponentStore::ClearGridCell(uint32_t objectID, uint32_t gridOwnerID) {
+    Index index = IndexOf(objectID);
+    if (index != INVALID_INDEX && gridOwnerIDs[index] == gridOwnerID) {
+        gridOwnerIDs[index] = 0;
+        gridCells[index] = NO_CELL;
+    }
+}
+
+void ComponentStore::Spin(float deltaTime, const glm::vec3& axis) {
+    // same for everybody, build it once
+    glm::quat additionalRotation = glm::angleAxis(deltaTime, glm::normalize(axis));
+
+    Spin(additionalRotation, 0, transforms.size());
+}
+
+void ComponentStore::Spin(const glm::quat& additionalRotation, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        transforms[i].SetRotationQuat(additionalRotation * transforms[i].GetRotationQuat());
+    }
+}
+
+void ComponentStore::UpdateLocalMatrices() {
+    UpdateLocalMatrices(0, transforms.size());
+}
+
+void ComponentStore::UpdateLocalMatrices(size_t begin, size_t end) {
+    // GetTransformMatrix only recomputes dirty transforms
+    for (size_t i = begin; i < end; i++) {
+        localMatrices[i] = transforms[i].GetTransformMatrix();
+    }
+}
+
+void ComponentStore::RebindTransform(Index index) {
+    owners[index]->ptrNodeTransform_ = &transforms[index];
+}
+
+void ComponentStore::RebindAllTransforms() {
+    for (Index i = 0; i < owners.size(); i++) {
+        RebindTransform(i);
+    }
+}
@@ -0,0 +1,40 @@
+#include "Core/GridTopology.h"
+
+#include <array>
+#include <utility>
+
+// the larger nets take more constexpr evaluation steps than MSVC allows by default,
+// this file is built with a raised /constexpr:steps (see the project)
+namespace {
+    template <uint8_t EDGE>
+    constexpr CubeNet::Table<EDGE> TABLE = CubeNet::Build<EDGE>();
+
+    struct Entry {
+        const CellLink* links;
+        const CellMatrix* matrices;
+    };
+
+    // ENTRIES[edge - 1]
+    template <uint8_t... EDGES>
+    constexpr std::array<Entry, sizeof...(EDGES)> MakeEntries(std::integer_sequence<uint8_t, EDGES...>) {
+        return { { { TABLE<EDGES + 1>.links, TABLE<EDGES + 1>.matrices }... } };
+    }
+
+    constexpr std::array<Entry, CubeNet::MAX_PRECOMPUTED_EDGE> ENTRIES = MakeEntries(std::make_integer_sequence<uint8_t, CubeNet::MAX_PRECOMPUTED_EDGE>());
+}
+
+namespace CubeNet {
+    const CellLink* GetLinks(uint8_t edge) {
+        if (edge == 0 || edge > MAX_PRECOMPUTED_EDGE) {
+            return nullptr;
+        }
+        return ENTRIES[edge - 1].links;
+    }
+
+    const CellMatrix* GetMatrices(uint8_t edge) {
+        if (edge == 0 || edge > MAX_PRECOMPUTED_EDGE) {
+            return nullptr;
+        }
+        return ENTRIES[edge - 1].matrices;
+    }
+}
@@ -1,292 +1,355 @@
-#include "Core/GridManager.h" 
-#include "Utils/LOG.h"
-
-int PositiveModulo(int x, int mod) {
-    return ((x) % mod + mod) % mod;
-}
-
-int ParallelTransporter::Direction2Int(Direction xDir) {
-	return static_cast<int>(xDir);
-}
-
-Direction ParallelTransporter::Int2Direction(int x) {
-	return static_cast<Direction>(PositiveModulo(x, 4)); // Ensure cyclic behavior for rotations
-}
-
-int ParallelTransporter::TurnLeft(int x) {
-	return PositiveModulo(x + 1, 4);
-}
-int ParallelTransporter::TurnRight(int x) {
-	return PositiveModulo(x - 1, 4);
-}
-int ParallelTransporter::Turn180(int x) {
-	return PositiveModulo(x + 2, 4);
-}
-int ParallelTransporter::StayStraight(int x) {
-	return x;
-}
-
-Int2RotationOnInt ParallelTransporter::int2Rotation = {
-    {0, StayStraight},
-    {1, TurnLeft},
-    {2, Turn180},
-    {3, TurnRight}
-};
-
-ParallelTransporter::ParallelTransporter() : isDefault(true) {
-	for (int i = 0; i < 4; i++) {
-		directionInt2RotationInt[i] = StayStraight;
-	}
-}
-
-ParallelTransporter::ParallelTransporter(Int2RotationOnInt x) {
-	directionInt2RotationInt = x;
-}
-
-void ParallelTransporter::SetDirectionInt2RotationInt(int directionInt, int rotationInt) {
-	directionInt2RotationInt[directionInt] = int2Rotation[rotationInt];
-	int2Int[directionInt] = rotationInt;
-}
-
-Direction ParallelTransporter::CalculateDireciton(Direction facingWhere, Direction goingWhere) {
-	int facingInt = Direction2Int(facingWhere);
-	int goingInt = Direction2Int(goingWhere);
-
-	// RotationsOnInt curRotation = directionInt2RotationInt[goingInt]; 
-	RotationsOnInt curRotation = directionInt2RotationInt.count(goingInt) ?
-		directionInt2RotationInt[goingInt] : StayStraight;
-
-	int resultingDirectionInt = curRotation(facingInt);
-
-	return Int2Direction(resultingDirectionInt);
-}
-
-
-
-
-void MovementManager::InitPlanarFigure(int startY, int startX, int size) {
-	this->InitTransporters(startY, startX, size);
-	// this->InitTransforms(startY, startX, size); 
-}
-
-void MovementManager::InitTransporters(int startY, int startX, int size) {
-	int curY = 0;
-	int curX = 0;
-	Direction curDirection = Direction::UP;
-	int curCurvatureFromLateralFace2BottomBase = 0;
-	int curCurvatureFromLateralFace2UpperBase = 0;
-
-
-	Action2Coord2d* curAction2Coord;
-	ParallelTransporter* curParallelTransporter;
-
-	int curIndex = 0;
-	for (int i = 0; i < 4; i++) {
-		curCurvatureFromLateralFace2BottomBase = ((-i) % 4 + 4) % 4;
-		curCurvatureFromLateralFace2UpperBase = i % 4;
-		for (int j = 0; j < size; j++) {
-
-
-			if (i == 0) {
-				curY = 0;
-				curX = j;
-				curDirection = Direction::UP;
-			}
-			else if (i == 1) {
-				curY = j;
-				curX = size - 1;
-				curDirection = Direction::RIGHT;
-			}
-			else if (i == 2) {
-				curY = size - 1;
-				curX = size - j - 1;
-				curDirection = Direction::DOWN;
-			}
-			else {
-				curY = size - j - 1;
-				curX = 0;
-				curDirection = Direction::LEFT;
-			}
-
-			curY = curY + startY;
-			curX = curX + startX + size * 5; // bottom starts at size * 5 
-
-			// remember 
-			// right -> 0 
-			// up -> 1 
-			// left -> 2 
-			// down -> 3
-
-			// bottom rim 
-			// latteral face 2 base 
-			curAction2Coord = grid2Transporter[startY + size - 1][startX + curIndex];
-			(*curAction2Coord)[Direction::DOWN] = { curY, curX };
-			curParallelTransporter = grid2ParallelTransporter[startY + size - 1][startX + curIndex];
-			curParallelTransporter->SetDirectionInt2RotationInt(3, curCurvatureFromLateralFace2BottomBase);
-			// base 2 latteral face 
-			curAction2Coord = grid2Transporter[curY][curX];
-			(*curAction2Coord)[curDirection] = { startY + size - 1, startX + curIndex };
-			curParallelTransporter = grid2ParallelTransporter[curY][curX];
-			curParallelTransporter->SetDirectionInt2RotationInt(static_cast<int>(curDirection), PositiveModulo(-curCurvatureFromLateralFace2BottomBase, 4));
-
-
-			if (i == 0) {
-				curY = size - 1;
-				curX = j;
-				curDirection = Direction::DOWN;
-			}
-			else if (i == 1) {
-				curY = size - j - 1;
-				curX = size - 1;
-				curDirection = Direction::RIGHT;
-			}
-			else if (i == 2) {
-				curY = 0;
-				curX = size - j - 1;
-				curDirection = Direction::UP;
-			}
-			else {
-				curY = j;
-				curX = 0;
-				curDirection = Direction::LEFT;
-			}
-
-			curY = curY + startY;
-			curX = curX + startX + size * 4; // bottom starts at size * 4 
-
-			// upper rim 
-			curAction2Coord = grid2Transporter[startY + 0][startX + curIndex];
-			(*curAction2Coord)[Direction::UP] = { curY, curX };
-			curParallelTransporter = grid2ParallelTransporter[startY + 0][startX + curIndex];
-			curParallelTransporter->SetDirectionInt2RotationInt(1, curCurvatureFromLateralFace2UpperBase);
-
-			curAction2Coord = grid2Transporter[curY][curX];
-			(*curAction2Coord)[curDirection] = { startY + 0, startX + curIndex };
-			curParallelTransporter = grid2ParallelTransporter[curY][curX];
-			curParallelTransporter->SetDirectionInt2RotationInt(static_cast<int>(curDirection), PositiveModulo(-curCurvatureFromLateralFace2UpperBase, 4));
-
-			// end
-			curIndex += 1;
-		}
-	}
-
-	// stitch up the latteral faces
-	for (int i = 0; i < size; i++) {
-		// left to right
-		curAction2Coord = grid2Transporter[startY + i][startX + 0];
-		(*curAction2Coord)[Direction::LEFT] = { startY + i, startX + size * 4 - 1 };
-
-
-		// right to left
-		curAction2Coord = grid2Transporter[startY + i][startX + size * 4 - 1];
-		(*curAction2Coord)[Direction::RIGHT] = { startY + i, startX + 0 };
-	}
-}
-
-
-void GridTransformManager::InitTransforms(int startY, int startX, int size) {
-	Transform* curTransform;
-
-	int facePieceSize = size; // Number of pieces per face
-	// float faceSize = facePieceSize * BLOCK_SIZE; // Physical size of one face of the cube
-
-	int curFaceIndex = 0;
-	float curZ = 0;
-	float curY = 0;
-	float curX = 0;
-
-	for (int i = 0; i < facePieceSize; i++) {
-		for (int j = 0; j < facePieceSize * 6; j++) {
-			curFaceIndex = j / facePieceSize; //
-
-			switch (curFaceIndex) {
-			case 0: //
-				curZ = i;
-				curY = 0;
-				curX = j % facePieceSize;
-
-				curY += -GROUND_OFFSET; 
-
-				break;
-			case 1:
-				curZ = i;
-				curY = j % facePieceSize;
-				curX = facePieceSize - 1;
-
-				curX += GROUND_OFFSET;
-
-				grid2Transform[i + startY][j + startX]->SetRotation(glm::radians(-90.0f), glm::vec3(0, 0, 1));
-				break;
-			case 2:
-				curZ = i;
-				curY = facePieceSize - 1;
-				curX = facePieceSize - (j % facePieceSize) - 1; 
-
-				curY += GROUND_OFFSET;
-
-				grid2Transform[i + startY][j + startX]->SetRotation(glm::radians(-180.0f), glm::vec3(0, 0, 1));
-				break;
-			case 3:
-				curZ = i;
-				curY = facePieceSize - (j % facePieceSize) - 1;
-				curX = 0;
-
-				curX += -GROUND_OFFSET;
-
-				grid2Transform[i + startY][j + startX]->SetRotation(glm::radians(-270.0f), glm::vec3(0, 0, 1));
-				break;
-			case 4: // top
-				curZ = 0;
-				curY = facePieceSize - i - 1;
-				curX = j % facePieceSize;
-
-				curZ += -GROUND_OFFSET;
-
-				grid2Transform[i + startY][j + startX]->SetRotation(glm::radians(-90.0f), glm::vec3(1, 0, 0));
-				break;
-			case 5: // bottom
-				curZ = facePieceSize - 1;
-				curY = i;
-				curX = j % facePieceSize;
-
-				curZ += GROUND_OFFSET;
-
-				grid2Transform[i + startY][j + startX]->SetRotation(glm::radians(90.0f), glm::vec3(1, 0, 0));
-				break;
-			}
-
-			curZ += -0.5;
-			curY += -0.5;
-			curX += -0.5;
-
-			curZ *= BLOCK_OFFSET;
-			curY *= -BLOCK_OFFSET;
-			curX *= BLOCK_OFFSET; 
-
-
-
-			grid2Transform[i + startY][j + startX]->SetScale(glm::vec3(BLOCK_SIZE));
-			grid2Transform[i + startY][j + startX]->SetTranslation(glm::vec3(curX, curY, curZ));
-		}
-	}
-}
-
-NavigationInfo MovementManager::Move(Coord2d position, Direction movingDirection, Direction facingDirection) {
-	int curY = position.first;
-	int curX = position.second;
-
-	LOG(LOG_INFO, "Attempting reference At: " + std::to_string(curY) + ", " + std::to_string(curX));
-
-	Action2Coord2d* curAction2Coord2d = grid2Transporter[curY][curX];
-	Coord2d targetCoord2d = (*curAction2Coord2d)[movingDirection];
-
-	ParallelTransporter* curParallelTransporter = grid2ParallelTransporter[curY][curX];
-	Direction newFacingDirection = curParallelTransporter->CalculateDireciton(facingDirection, movingDirection);
-
-	NavigationInfo newInfo = NavigationInfo();
-	newInfo.pos = targetCoord2d;  // sometimes 0. why?
-	newInfo.direction = newFacingDirection; 
-	newInfo.changeOfOrientation = curParallelTransporter->int2Int[static_cast<int>(movingDirection)];
-
-	return newInfo;
-}
\ No newline at end of file
+#include "Core/GridManager.h" 
+#include <algorithm>
+#include "Utils/LOG.h"
+
+int PositiveModulo(int x, int mod) {
+    return ((x) % mod + mod) % mod;
+}
+
+void MovementManager::InitializeTori() {
+	if (GetCellCount() > MAX_STORED_TORUS_CELLS) {
+		links_.clear();
+		links_.shrink_to_fit();
+		cells_ = nullptr;
+		return;
+	}
+
+	links_.resize(GetCellCount());
+	cells_ = links_.data();
+
+	GridTopology::LinkTorus(links_.data(), gridHeight_, gridWidth_);
+}
+
+void MovementManager::Detach() {
+	if (IsShared()) {
+		links_.assign(cells_, cells_ + GetCellCount());
+	}
+	else if (cells_ == nullptr) {
+		links_.resize(GetCellCount());
+		GridTopology::LinkTorus(links_.data(), gridHeight_, gridWidth_);
+	}
+	else {
+		return;
+	}
+
+	cells_ = links_.data();
+}
+
+void MovementManager::InitPlanarFigure(int startY, int startX, int size) {
+	this->InitTransporters(startY, startX, size);
+	// this->InitTransforms(startY, startX, size); 
+}
+
+void MovementManager::InitTransporters(int startY, int startX, int size) {
+	if (startY < 0 || startX < 0 || startY + size > gridHeight_ || startX + size * 6 > gridWidth_) {
+		log(LOG_ERROR, "A cube of size " + std::to_string(size) + " at " + std::to_string(startY) + ", " + std::to_string(startX)
+			+ " doesn't fit a grid of " + std::to_string(gridHeight_) + " x " + std::to_string(gridWidth_));
+		return;
+	}
+
+	Detach();
+
+	GridTopology::LinkCubeNet(links_.data(), gridWidth_, startY, startX, size);
+}
+
+void MovementManager::CastRay(Ray& ray, const ChunkedGrid<uint32_t>& occupancy) const {
+	ray.lastCell = ray.fromCell;
+	ray.hitCell = Ray::NO_HIT;
+	ray.hitObjectID = 0;
+	ray.isPortal = false;
+	ray.distance = 0;
+	ray.heading = ray.direction;
+
+	uint32_t directionInt = static_cast<uint32_t>(ray.direction);
+	size_t cellCount = GetCellCount();
+
+	if (directionInt > 3 || ray.fromCell >= cellCount || occupancy.GetCellCount() != cellCount) {
+		return;
+	}
+
+	uint32_t cell = ray.fromCell;
+
+	for (uint16_t step = 1; step <= ray.maxDistance; step++) {
+		CellLink link = GetLink(cell);
+		uint32_t next = link.neighbours[directionInt];
+
+		// across a seam the way ahead is turned, like the facing of a walker
+		directionInt = (directionInt + link.RotationOf(directionInt)) & 3;
+
+		if (next == ray.fromCell) {
+			// all the way around
+			break;
+		}
+
+		if (GetPortal(next) != nullptr) {
+			// a walker stepping here would be on another grid, so would the ray
+			ray.hitCell = next;
+			ray.isPortal = true;
+			ray.distance = step;
+			break;
+		}
+
+		uint32_t occupantID = occupancy.Get(next);
+		if (occupantID != 0) {
+			ray.hitCell = next;
+			ray.hitObjectID = occupantID;
+			ray.distance = step;
+			break;
+		}
+
+		cell = next;
+		ray.lastCell = cell;
+		ray.distance = step;
+	}
+
+	ray.heading = static_cast<Direction>(directionInt);
+}
+
+void MovementManager::CastRays(Ray* rays, size_t count, const ChunkedGrid<uint32_t>& occupancy) const {
+	for (size_t i = 0; i < count; i++) {
+		CastRay(rays[i], occupancy);
+	}
+}
+
+void GridTransformManager::Detach() {
+	if (IsShared()) {
+		ownMatrices_.assign(matrices_, matrices_ + GetCellCount());
+	}
+	else if (matrices_ == nullptr) {
+		ownMatrices_.assign(GetCellCount(), CellMatrix{ { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1 } });
+	}
+	else {
+		return;
+	}
+
+	matrices_ = ownMatrices_.data();
+}
+
+void GridTransformManager::InitTransforms(int startY, int startX, int size) {
+	if (startY < 0 || startX < 0 || startY + size > gridHeight_ || startX + size * 6 > gridWidth_) {
+		log(LOG_ERROR, "A cube of size " + std::to_string(size) + " doesn't fit a grid of "
+			+ std::to_string(gridHeight_) + " x " + std::to_string(gridWidth_));
+		return;
+	}
+
+	Detach();
+
+	for (int i = 0; i < size; i++) {
+		for (int j = 0; j < size * 6; j++) {
+			ownMatrices_[(i + startY) * gridWidth_ + (j + startX)] = GridTopology::CubeNetCellMatrix(size, i, j);
+		}
+	}
+
+	version_++;
+}
+
+NavigationInfo MovementManager::Move(Coord2d position, Direction movingDirection, Direction facingDirection) {
+	int curY = position.first;
+	int curX = position.second;
+
+	NavigationInfo newInfo = NavigationInfo();
+	newInfo.pos = position;
+	newInfo.direction = facingDirection;
+
+	int movingInt = static_cast<int>(movingDirection);
+
+	// IDLE, or off the grid: stay
+	if (movingInt > 3 || curY < 0 || curX < 0 || curY >= gridHeight_ || curX >= gridWidth_) {
+		return newInfo;
+	}
+
+	CellLink link = GetLink(CellIndex(curY, curX));
+	uint32_t target = link.neighbours[movingInt];
+	int rotation = link.RotationOf(movingInt);
+
+	if (const PortalLink* portal = GetPortal(target)) {
+		// through, one more lookup. the turn of the portal adds to the turn of the step
+		rotation += portal->rotation;
+
+		newInfo.pos = { static_cast<int>(portal->y), static_cast<int>(portal->x) };
+		newInfo.gridID = portal->gridID;
+	}
+	else {
+		newInfo.pos = { static_cast<int>(target / gridWidth_), static_cast<int>(target % gridWidth_) };
+	}
+
+	newInfo.direction = static_cast<Direction>((static_cast<int>(facingDirection) + rotation) & 3);
+	newInfo.changeOfOrientation = rotation & 3;
+
+	return newInfo;
+}
+
+void MovementManager::SetPortal(uint32_t cell, const PortalLink& link) {
+	if (cell >= GetCellCount()) {
+		log(LOG_ERROR, "SetPortal, cell " + std::to_string(cell) + " is not on a grid of " + std::to_string(GetCellCount()) + " cells");
+		return;
+	}
+
+	portals_[cell] = link;
+}
+
+void MovementManager::RemovePortal(uint32_t cell) {
+	portals_.erase(cell);
+}
+
+void MovementManager::MoveBatch(MovementBatch& batch) const {
+	size_t count = batch.Size();
+	uint32_t cellCount = static_cast<uint32_t>(GetCellCount());
+
+	batch.targets.resize(count);
+	batch.newFacing.resize(count);
+	batch.orientationChanges.resize(count);
+	batch.blocked.assign(count, 0);
+
+	const uint32_t* cells = batch.cells.data();
+	const uint8_t* moving = batch.moving.data();
+	const uint8_t* facing = batch.facing.data();
+	uint32_t* targets = batch.targets.data();
+	uint8_t* newFacing = batch.newFacing.data();
+	uint8_t* orientationChanges = batch.orientationChanges.data();
+
+	if (cells_ == nullptr) {
+		// a plain torus. nothing turns, the neighbour is worked out instead of looked up
+		uint32_t width = gridWidth_;
+		// cell / width as a multiplication, integer division doesn't vectorize. off by one at most, fixed below
+		double inverseWidth = width > 0 ? 1.0 / width : 0.0;
+		uint32_t lastRow = cellCount - width;
+
+		for (size_t i = 0; i < count; i++) {
+			uint32_t cell = cells[i];
+			uint32_t movingInt = moving[i];
+
+			bool stays = movingInt > 3 || cell >= cellCount;
+			cell = stays ? 0 : cell;
+
+			uint32_t y = static_cast<uint32_t>(static_cast<int64_t>(cell) * inverseWidth);
+			uint32_t x = cell - y * width;
+			x = x >= width ? x - width : x;
+
+			// the four neighbours side by side, indexed by direction like CellLink::neighbours
+			uint32_t neighbours[4];
+			neighbours[static_cast<int>(Direction::RIGHT)] = x + 1 == width ? cell + 1 - width : cell + 1;
+			neighbours[static_cast<int>(Direction::UP)] = cell < width ? cell + lastRow : cell - width;
+			neighbours[static_cast<int>(Direction::LEFT)] = x == 0 ? cell + width - 1 : cell - 1;
+			neighbours[static_cast<int>(Direction::DOWN)] = cell >= lastRow ? cell - lastRow : cell + width;
+
+			targets[i] = stays ? cells[i] : neighbours[movingInt & 3];
+			orientationChanges[i] = 0;
+			newFacing[i] = stays ? facing[i] : static_cast<uint8_t>(facing[i] & 3);
+		}
+		return;
+	}
+
+	const CellLink* links = cells_;
+
+	for (size_t i = 0; i < count; i++) {
+		uint32_t cell = cells[i];
+		uint32_t movingInt = moving[i];
+
+		// IDLE, or off the grid: stay. everybody reads a valid link, the result is picked afterwards
+		bool stays = movingInt > 3 || cell >= cellCount;
+		uint32_t directionInt = movingInt & 3;
+		const CellLink& link = links[stays ? 0 : cell];
+
+		uint32_t target = link.neighbours[directionInt];
+		uint8_t rotation = (link.rotations >> (2 * directionInt)) & 3;
+
+		targets[i] = stays ? cell : target;
+		orientationChanges[i] = stays ? 0 : rotation;
+		newFacing[i] = stays ? facing[i] : static_cast<uint8_t>((facing[i] + rotation) & 3);
+	}
+}
+
+namespace {
+	constexpr uint32_t NONE = UINT32_MAX;
+
+	// the walker of cell in a list sorted by cell, NONE if there is none
+	uint32_t FindWalker(const std::vector<std::pair<uint32_t, uint32_t>>& walkers, uint32_t cell) {
+		auto it = std::lower_bound(walkers.begin(), walkers.end(), std::make_pair(cell, 0u));
+		return it != walkers.end() && it->first == cell ? it->second : NONE;
+	}
+}
+
+void MovementManager::ResolveConflicts(MovementBatch& batch, const ChunkedGrid<uint32_t>& occupancy) const {
+	size_t count = batch.Size();
+	uint32_t cellCount = static_cast<uint32_t>(GetCellCount());
+
+	if (batch.targets.size() != count || occupancy.GetCellCount() != cellCount) {
+		LOG(LOG_ERROR, GetName() + "::ResolveConflicts without MoveBatch, or with the occupancy of another grid");
+		return;
+	}
+
+	const uint32_t* cells = batch.cells.data();
+	uint32_t* targets = batch.targets.data();
+
+	// who wants to go where, the first walker in the batch gets it. who stands where.
+	// sorted lists of the batch instead of tables of the grid, a big torus has millions of cells and a batch a few hundred walkers
+	batch.claims.clear();
+	batch.standing.clear();
+
+	for (size_t i = 0; i < count; i++) {
+		if (cells[i] < cellCount) {
+			batch.standing.emplace_back(cells[i], static_cast<uint32_t>(i));
+		}
+		if (targets[i] != cells[i]) {
+			batch.claims.emplace_back(targets[i], static_cast<uint32_t>(i));
+		}
+	}
+
+	auto isSameCell = [](const std::pair<uint32_t, uint32_t>& a, const std::pair<uint32_t, uint32_t>& b) {
+		return a.first == b.first;
+	};
+
+	// by cell, then by walker: the claim of a cell is the lowest index
+	std::sort(batch.claims.begin(), batch.claims.end());
+	batch.claims.erase(std::unique(batch.claims.begin(), batch.claims.end(), isSameCell), batch.claims.end());
+
+	// two walkers given the same cell: the later one stands there
+	std::sort(batch.standing.begin(), batch.standing.end());
+	batch.standing.erase(batch.standing.begin(), std::unique(batch.standing.rbegin(), batch.standing.rend(), isSameCell).base());
+
+	// walkers that stay where they are, whoever wanted their cell has to stay too
+	batch.refused.clear();
+
+	auto refuse = [&batch, targets, cells](size_t i) {
+		targets[i] = cells[i];
+		batch.newFacing[i] = batch.facing[i];
+		batch.orientationChanges[i] = 0;
+		batch.blocked[i] = 1;
+		batch.refused.push_back(static_cast<uint32_t>(i));
+	};
+
+	for (size_t i = 0; i < count; i++) {
+		uint32_t target = targets[i];
+
+		if (target == cells[i]) {
+			batch.refused.push_back(static_cast<uint32_t>(i));
+			continue;
+		}
+
+		uint32_t standing = FindWalker(batch.standing, target);
+
+		if (FindWalker(batch.claims, target) != i) {
+			refuse(i);
+		}
+		else if (standing == NONE && occupancy.Get(target) != 0) {
+			refuse(i);
+		}
+		else if (standing != NONE && targets[standing] == cells[i]) {
+			// they would walk through each other
+			refuse(i);
+		}
+	}
+
+	for (size_t k = 0; k < batch.refused.size(); k++) {
+		uint32_t cell = cells[batch.refused[k]];
+		if (cell >= cellCount) {
+			continue;
+		}
+
+		uint32_t follower = FindWalker(batch.claims, cell);
+		if (follower != NONE && targets[follower] != cells[follower]) {
+			refuse(follower);
+		}
+	}
+}
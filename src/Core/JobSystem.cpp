@@ -0,0 +1,101 @@
+#include "Core/JobSystem.h"
+
+std::string JobSystem::GetName() const { return "JobSystem"; }
+
+void JobSystem::log(LogLevel level, std::string text) {
+    LOG(level, GetName() + "::" + text);
+}
+
+JobSystem::JobSystem(size_t nWorkers) {
+    for (size_t i = 0; i < nWorkers + 1; i++) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+
+    for (size_t i = 1; i <= nWorkers; i++) {
+        workers_.emplace_back([this, i]() {
+            this->WorkerLoop(i);
+            });
+    }
+
+    log(LOG_INFO, "Started " + std::to_string(nWorkers) + " worker threads");
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_.store(true);
+    }
+    wake_.notify_all();
+
+    for (std::thread& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void JobSystem::Push(size_t queueIndex, const Job& job) {
+    {
+        std::lock_guard<std::mutex> lock(queues_[queueIndex]->mutex);
+        queues_[queueIndex]->jobs.push_back(job);
+    }
+    queuedJobs_.fetch_add(1, std::memory_order_release);
+}
+
+bool JobSystem::PopOwn(size_t threadIndex, Job& job) {
+    WorkQueue& queue = *queues_[threadIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.jobs.empty()) {
+        return false;
+    }
+
+    job = queue.jobs.back();
+    queue.jobs.pop_back();
+    return true;
+}
+
+bool JobSystem::Steal(size_t thiefIndex, Job& job) {
+    size_t nQueues = queues_.size();
+
+    // start at the neighbour so that thieves don't all pile onto queue 0
+    for (size_t offset = 1; offset < nQueues; offset++) {
+        WorkQueue& victim = *queues_[(thiefIndex + offset) % nQueues];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::TryRunOne(size_t threadIndex) {
+    Job job;
+
+    if (!PopOwn(threadIndex, job) && !Steal(threadIndex, job)) {
+        return false;
+    }
+
+    queuedJobs_.fetch_sub(1, std::memory_order_acq_rel);
+
+    job.run(job.context, job.begin, job.end, threadIndex);
+    job.remaining->fetch_sub(1, std::memory_order_acq_rel);
+
+    return true;
+}
+
+void JobSystem::WorkerLoop(size_t threadIndex) {
+    while (!stopping_.load(std::memory_order_acquire)) {
+        if (TryRunOne(threadIndex)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wake_.wait(lock, [this]() {
+            return stopping_.load(std::memory_order_acquire) || queuedJobs_.load(std::memory_order_acquire) != 0;
+            });
+    }
+}
@@ -0,0 +1,149 @@
+#include "Core/MemoryPool.h"
+
+#include <algorithm>
+#include <sstream>
+
+// FixedBlockPool -------------------------------------------------------
+
+FixedBlockPool::FixedBlockPool(size_t blockSize, size_t blocksPerChunk)
+    : blockSize_(std::max(blockSize, sizeof(FreeBlock))),
+    blocksPerChunk_(blocksPerChunk) {}
+
+FixedBlockPool::~FixedBlockPool() {
+    for (void* chunk : chunks_) {
+        ::operator delete(chunk);
+    }
+}
+
+void FixedBlockPool::AddChunk() {
+    char* chunk = static_cast<char*>(::operator new(blockSize_ * blocksPerChunk_));
+    chunks_.push_back(chunk);
+
+    // thread the new blocks onto the free list, first block on top
+    for (size_t i = blocksPerChunk_; i > 0; i--) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * blockSize_);
+        block->next = freeList_;
+        freeList_ = block;
+    }
+}
+
+void* FixedBlockPool::Allocate() {
+    if (freeList_ == nullptr) {
+        AddChunk();
+    }
+
+    FreeBlock* block = freeList_;
+    freeList_ = block->next;
+
+    liveBlocks_++;
+    peakBlocks_ = std::max(peakBlocks_, liveBlocks_);
+
+    return block;
+}
+
+void FixedBlockPool::Deallocate(void* ptr) {
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = freeList_;
+    freeList_ = block;
+
+    liveBlocks_--;
+}
+
+bool FixedBlockPool::ReleaseIfUnused() {
+    if (liveBlocks_ != 0) {
+        return false;
+    }
+
+    for (void* chunk : chunks_) {
+        ::operator delete(chunk);
+    }
+    chunks_.clear();
+    freeList_ = nullptr;
+
+    return true;
+}
+
+// PoolAllocator -------------------------------------------------------
+
+std::string PoolAllocator::GetName() const { return "PoolAllocator"; }
+
+void PoolAllocator::log(LogLevel level, std::string text) {
+    LOG(level, GetName() + "::" + text);
+}
+
+PoolAllocator& PoolAllocator::GetInstance() {
+    // never destroyed. pooled objects owned by other statics may still be deleted during exit
+    static PoolAllocator* instance = new PoolAllocator();
+    return *instance;
+}
+
+PoolAllocator::PoolAllocator() {}
+
+FixedBlockPool& PoolAllocator::PoolFor(size_t size) {
+    size_t sizeClass = SizeClassOf(size);
+
+    if (pools_[sizeClass] == nullptr) {
+        size_t blockSize = (sizeClass + 1) * GRANULARITY;
+        // roughly 64KB per chunk, but at least a handful of blocks
+        size_t blocksPerChunk = std::max<size_t>(64 * 1024 / blockSize, 16);
+
+        pools_[sizeClass] = new FixedBlockPool(blockSize, blocksPerChunk);
+    }
+    return *pools_[sizeClass];
+}
+
+void* PoolAllocator::Allocate(size_t size) {
+    if (size == 0 || size > MAX_POOLED_SIZE) {
+        return ::operator new(size);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    return PoolFor(size).Allocate();
+}
+
+void PoolAllocator::Deallocate(void* ptr, size_t size) {
+    if (ptr == nullptr) {
+        return;
+    }
+
+    if (size == 0 || size > MAX_POOLED_SIZE) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    PoolFor(size).Deallocate(ptr);
+}
+
+void PoolAllocator::ReleaseUnused() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    size_t released = 0;
+    for (FixedBlockPool* pool : pools_) {
+        if (pool != nullptr) {
+            size_t reserved = pool->GetReservedBytes();
+            if (pool->ReleaseIfUnused()) {
+                released += reserved;
+            }
+        }
+    }
+
+    log(LOG_INFO, "Released " + std::to_string(released / 1024) + "KB of pooled memory");
+}
+
+void PoolAllocator::LogStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::stringstream ss;
+    ss << "Pools (block size: live / peak, reserved KB)";
+
+    for (FixedBlockPool* pool : pools_) {
+        if (pool != nullptr) {
+            ss << "\n  " << pool->GetBlockSize() << "B: "
+                << pool->GetLiveBlocks() << " / " << pool->GetPeakBlocks()
+                << ", " << pool->GetReservedBytes() / 1024 << "KB";
+        }
+    }
+
+    log(LOG_INFO, ss.str());
+}
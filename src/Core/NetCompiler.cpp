@@ -0,0 +1,613 @@
+#include "Core/NetCompiler.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <utility>
+#include <glm/glm.hpp>
+
+#include "Utils/MappedFile.h"
+
+namespace {
+	// where a face is in space, in cells: the centre of its cell (0, 0), one cell along x, one cell along y
+	struct Frame {
+		glm::vec3 origin;
+		glm::vec3 u;
+		glm::vec3 v;
+	};
+
+	// the way walking in direction d goes on a face placed at frame (y is down on the grid)
+	glm::vec3 StepOf(const Frame& frame, int directionInt) {
+		switch (directionInt & 3) {
+		case 0: return frame.u;
+		case 1: return -frame.v;
+		case 2: return -frame.u;
+		default: return frame.v;
+		}
+	}
+
+	// the front of a face, towards where it is drawn from
+	glm::vec3 FrontOf(const Frame& frame) {
+		return glm::cross(frame.v, frame.u);
+	}
+
+	// RIGHT and LEFT run along the height of the face, UP and DOWN along its width
+	int EdgeLength(const NetFace& face, int edgeInt) {
+		return (edgeInt & 1) == 0 ? face.height : face.width;
+	}
+
+	// cell t of an edge, counted counterclockwise around the face, in grid coordinates
+	void EdgeCell(const NetFace& face, int edgeInt, int t, int& y, int& x) {
+		switch (edgeInt) {
+		case 0: y = face.height - 1 - t; x = face.width - 1; break;
+		case 1: y = 0; x = face.width - 1 - t; break;
+		case 2: y = t; x = 0; break;
+		default: y = face.height - 1; x = t; break;
+		}
+
+		y += face.y;
+		x += face.x;
+	}
+
+	// quarter turns have exact sines and cosines, a folded cube comes out exactly like CubeNetCellMatrix
+	void SinCos(float degrees, float& s, float& c) {
+		constexpr float COS[4] = { 1, 0, -1, 0 };
+		constexpr float SIN[4] = { 0, 1, 0, -1 };
+
+		float turns = degrees / 90.0f;
+		if (turns == std::floor(turns)) {
+			int turnsInt = GridTopology::PositiveModulo(static_cast<int>(turns), 4);
+			s = SIN[turnsInt];
+			c = COS[turnsInt];
+			return;
+		}
+
+		float radians = glm::radians(degrees);
+		s = std::sin(radians);
+		c = std::cos(radians);
+	}
+
+	// p turned around the unit vector axis (Rodrigues)
+	glm::vec3 Rotate(const glm::vec3& p, const glm::vec3& axis, float s, float c) {
+		return p * c + glm::cross(axis, p) * s + axis * (glm::dot(axis, p) * (1.0f - c));
+	}
+
+	// Places the face glued across toEdge to fromEdge of a face already placed at from.
+	// The shared edge is the axis of the fold, the new face starts out flat beyond it and is turned towards the back of from
+	Frame Hang(const Frame& from, const NetFace& fromFace, int fromEdge, const NetFace& toFace, int toEdge, float foldDegrees) {
+		glm::vec3 out = StepOf(from, fromEdge);
+		glm::vec3 along = StepOf(from, fromEdge + 1);
+
+		float s;
+		float c;
+		SinCos(foldDegrees, s, c);
+
+		// the way onto the new face, and as seen from it: off it across toEdge is back, along its edge is the other way
+		glm::vec3 in = Rotate(out, along, s, c);
+
+		glm::vec3 steps[4];
+		steps[toEdge & 3] = -in;
+		steps[(toEdge + 1) & 3] = -along;
+		steps[(toEdge + 2) & 3] = in;
+		steps[(toEdge + 3) & 3] = along;
+
+		Frame to;
+		to.u = steps[0];
+		to.v = steps[3];
+
+		// cell 0 of fromEdge meets the last cell of toEdge, half a cell to the edge and half a cell beyond it
+		int fromY, fromX;
+		EdgeCell(fromFace, fromEdge, 0, fromY, fromX);
+		int toY, toX;
+		EdgeCell(toFace, toEdge, EdgeLength(toFace, toEdge) - 1, toY, toX);
+
+		glm::vec3 fromCentre = from.origin + from.u * static_cast<float>(fromX - fromFace.x) + from.v * static_cast<float>(fromY - fromFace.y);
+		glm::vec3 toCentre = fromCentre + out * 0.5f + in * 0.5f;
+
+		to.origin = toCentre - to.u * static_cast<float>(toX - toFace.x) - to.v * static_cast<float>(toY - toFace.y);
+		return to;
+	}
+
+	// translate * rotate * scale(BLOCK_SIZE), x along the face, y out of its front, z down the face (like the cube's top face)
+	CellMatrix MatrixOf(const glm::vec3& centre, const glm::vec3& u, const glm::vec3& front, const glm::vec3& v) {
+		using GridTopology::BLOCK_OFFSET;
+		using GridTopology::BLOCK_SIZE;
+
+		return CellMatrix{ {
+			u.x * BLOCK_SIZE, u.y * BLOCK_SIZE, u.z * BLOCK_SIZE, 0,
+			front.x * BLOCK_SIZE, front.y * BLOCK_SIZE, front.z * BLOCK_SIZE, 0,
+			v.x * BLOCK_SIZE, v.y * BLOCK_SIZE, v.z * BLOCK_SIZE, 0,
+			centre.x * BLOCK_OFFSET, centre.y * BLOCK_OFFSET, centre.z * BLOCK_OFFSET, 1
+		} };
+	}
+
+	bool Fail(const std::string& text) {
+		LOG(LOG_ERROR, "NetCompiler::Compile " + text);
+		return false;
+	}
+
+	uint64_t AlignUp(uint64_t offset) {
+		return (offset + 7) & ~static_cast<uint64_t>(7);
+	}
+
+	template <typename T>
+	void Put(std::vector<uint8_t>& bytes, T value) {
+		size_t offset = bytes.size();
+		bytes.resize(offset + sizeof(T));
+		std::memcpy(bytes.data() + offset, &value, sizeof(T));
+	}
+
+	// false once it would read past the end
+	template <typename T>
+	bool Take(const uint8_t* data, size_t size, size_t& offset, T& value) {
+		if (size - offset < sizeof(T)) {
+			return false;
+		}
+		std::memcpy(&value, data + offset, sizeof(T));
+		offset += sizeof(T);
+		return true;
+	}
+}
+
+namespace NetCompiler {
+	bool Compile(const NetDescription& description, CompiledNet& net) {
+		size_t nFaces = description.faces.size();
+		uint16_t height = description.gridHeight;
+		uint16_t width = description.gridWidth;
+
+		if (height == 0 || width == 0) {
+			return Fail("empty grid");
+		}
+		if (static_cast<size_t>(height) * width > MAX_CELL_COUNT) {
+			return Fail("a grid of " + std::to_string(height) + " x " + std::to_string(width) + " is over " + std::to_string(MAX_CELL_COUNT) + " cells");
+		}
+		if (nFaces == 0 || nFaces > 256) {
+			return Fail(std::to_string(nFaces) + " faces, 1 to 256 can be glued");
+		}
+
+		// f: cell -> the face it belongs to. one face per cell
+		std::vector<int16_t> faceOf(static_cast<size_t>(height) * width, -1);
+
+		for (size_t f = 0; f < nFaces; f++) {
+			const NetFace& face = description.faces[f];
+
+			if (face.height == 0 || face.width == 0 || face.y + face.height > height || face.x + face.width > width) {
+				return Fail("face " + std::to_string(f) + " doesn't fit a grid of " + std::to_string(height) + " x " + std::to_string(width));
+			}
+
+			for (int y = face.y; y < face.y + face.height; y++) {
+				for (int x = face.x; x < face.x + face.width; x++) {
+					int16_t& owner = faceOf[GridTopology::CellIndex(width, y, x)];
+					if (owner != -1) {
+						return Fail("faces " + std::to_string(owner) + " and " + std::to_string(f) + " overlap");
+					}
+					owner = static_cast<int16_t>(f);
+				}
+			}
+		}
+
+		// f: face * 4 + edge -> glued already
+		std::vector<uint8_t> isGlued(nFaces * 4, 0);
+
+		for (size_t g = 0; g < description.gluings.size(); g++) {
+			const NetGluing& gluing = description.gluings[g];
+			int edgeA = static_cast<int>(gluing.edgeA);
+			int edgeB = static_cast<int>(gluing.edgeB);
+
+			if (gluing.faceA >= nFaces || gluing.faceB >= nFaces || edgeA > 3 || edgeB > 3) {
+				return Fail("gluing " + std::to_string(g) + " names a face or an edge that doesn't exist");
+			}
+			if (EdgeLength(description.faces[gluing.faceA], edgeA) != EdgeLength(description.faces[gluing.faceB], edgeB)) {
+				return Fail("gluing " + std::to_string(g) + " joins edges of different length");
+			}
+
+			uint8_t& a = isGlued[gluing.faceA * 4 + edgeA];
+			uint8_t& b = isGlued[gluing.faceB * 4 + edgeB];
+			if (a || b || &a == &b) {
+				return Fail("gluing " + std::to_string(g) + " glues an edge that is glued already");
+			}
+			a = 1;
+			b = 1;
+		}
+
+		net.gridHeight = height;
+		net.gridWidth = width;
+		net.descriptionHash = Hash(description);
+		net.description = description;
+
+		// the seams, like LinkCubeNet does them by hand. the rest of the grid stays a torus
+		net.links.assign(net.GetCellCount(), CellLink{});
+		GridTopology::LinkTorus(net.links.data(), height, width);
+
+		for (const NetGluing& gluing : description.gluings) {
+			const NetFace& faceA = description.faces[gluing.faceA];
+			const NetFace& faceB = description.faces[gluing.faceB];
+			int edgeA = static_cast<int>(gluing.edgeA);
+			int edgeB = static_cast<int>(gluing.edgeB);
+			int length = EdgeLength(faceA, edgeA);
+
+			// walking off across edgeA you face into faceB, away from edgeB
+			int rotationAB = GridTopology::PositiveModulo(edgeB + 2 - edgeA, 4);
+			int rotationBA = GridTopology::PositiveModulo(edgeA + 2 - edgeB, 4);
+
+			for (int t = 0; t < length; t++) {
+				int yA, xA, yB, xB;
+				EdgeCell(faceA, edgeA, t, yA, xA);
+				EdgeCell(faceB, edgeB, length - 1 - t, yB, xB);
+
+				GridTopology::Link(net.links.data(), width, yA, xA, gluing.edgeA, yB, xB, rotationAB);
+				GridTopology::Link(net.links.data(), width, yB, xB, gluing.edgeB, yA, xA, rotationBA);
+			}
+		}
+
+		// the shape in space, unfolded from faces[0] breadth first
+		std::vector<Frame> frames(nFaces);
+		std::vector<uint8_t> isPlaced(nFaces, 0);
+		std::vector<size_t> queue;
+		queue.reserve(nFaces);
+
+		frames[0] = Frame{ glm::vec3(description.origin[0], description.origin[1], description.origin[2]), glm::vec3(1, 0, 0), glm::vec3(0, 0, 1) };
+		isPlaced[0] = 1;
+		queue.push_back(0);
+
+		for (size_t next = 0; next < queue.size(); next++) {
+			size_t f = queue[next];
+
+			for (const NetGluing& gluing : description.gluings) {
+				bool isA = gluing.faceA == f;
+				size_t other = isA ? gluing.faceB : gluing.faceA;
+
+				if ((!isA && gluing.faceB != f) || isPlaced[other]) {
+					continue;
+				}
+
+				Direction fromEdge = isA ? gluing.edgeA : gluing.edgeB;
+				Direction toEdge = isA ? gluing.edgeB : gluing.edgeA;
+
+				frames[other] = Hang(frames[f], description.faces[f], static_cast<int>(fromEdge),
+					description.faces[other], static_cast<int>(toEdge), gluing.foldDegrees);
+				isPlaced[other] = 1;
+				queue.push_back(other);
+			}
+		}
+
+		if (queue.size() != nFaces) {
+			return Fail(std::to_string(nFaces - queue.size()) + " faces are not glued to face 0");
+		}
+
+		net.matrices.assign(net.GetCellCount(), CellMatrix{ { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1 } });
+
+		for (size_t f = 0; f < nFaces; f++) {
+			const NetFace& face = description.faces[f];
+			const Frame& frame = frames[f];
+			glm::vec3 front = FrontOf(frame);
+			glm::vec3 lift = front * description.inflate;
+
+			for (int y = 0; y < face.height; y++) {
+				for (int x = 0; x < face.width; x++) {
+					glm::vec3 centre = frame.origin + frame.u * static_cast<float>(x) + frame.v * static_cast<float>(y) + lift;
+					net.matrices[GridTopology::CellIndex(width, face.y + y, face.x + x)] = MatrixOf(centre, frame.u, front, frame.v);
+				}
+			}
+		}
+
+		return true;
+	}
+
+	uint64_t Hash(const NetDescription& description) {
+		// FNV-1a
+		uint64_t hash = 14695981039346656037ull;
+		auto mix = [&hash](const void* data, size_t size) {
+			const uint8_t* bytes = static_cast<const uint8_t*>(data);
+			for (size_t i = 0; i < size; i++) {
+				hash = (hash ^ bytes[i]) * 1099511628211ull;
+			}
+		};
+
+		mix(&NetFormat::VERSION, sizeof(NetFormat::VERSION));
+		mix(&GridTopology::BLOCK_SIZE, sizeof(float));
+		mix(&GridTopology::BLOCK_OFFSET, sizeof(float));
+
+		mix(&description.gridHeight, sizeof(description.gridHeight));
+		mix(&description.gridWidth, sizeof(description.gridWidth));
+
+		for (const NetFace& face : description.faces) {
+			mix(&face.y, sizeof(face.y));
+			mix(&face.x, sizeof(face.x));
+			mix(&face.height, sizeof(face.height));
+			mix(&face.width, sizeof(face.width));
+		}
+
+		for (const NetGluing& gluing : description.gluings) {
+			uint8_t edgeA = static_cast<uint8_t>(gluing.edgeA);
+			uint8_t edgeB = static_cast<uint8_t>(gluing.edgeB);
+
+			mix(&gluing.faceA, sizeof(gluing.faceA));
+			mix(&edgeA, sizeof(edgeA));
+			mix(&gluing.faceB, sizeof(gluing.faceB));
+			mix(&edgeB, sizeof(edgeB));
+			mix(&gluing.foldDegrees, sizeof(gluing.foldDegrees));
+		}
+
+		mix(description.origin, sizeof(description.origin));
+		mix(&description.inflate, sizeof(description.inflate));
+
+		return hash;
+	}
+
+	std::vector<uint8_t> Serialize(const CompiledNet& net) {
+		using NetFormat::Header;
+
+		uint64_t linkBytes = net.links.size() * sizeof(CellLink);
+		uint64_t matrixBytes = net.matrices.size() * sizeof(CellMatrix);
+
+		Header header = {};
+		std::memcpy(header.magic, NetFormat::MAGIC, sizeof(NetFormat::MAGIC));
+		header.version = NetFormat::VERSION;
+		header.gridHeight = net.gridHeight;
+		header.gridWidth = net.gridWidth;
+		header.descriptionHash = net.descriptionHash;
+		header.linkSize = sizeof(CellLink);
+		header.matrixSize = sizeof(CellMatrix);
+		header.linkOffset = AlignUp(sizeof(Header));
+		header.matrixOffset = AlignUp(header.linkOffset + linkBytes);
+		header.fileSize = header.matrixOffset + matrixBytes;
+
+		std::vector<uint8_t> bytes(header.fileSize, 0);
+		std::memcpy(bytes.data(), &header, sizeof(Header));
+
+		if (linkBytes > 0) {
+			std::memcpy(bytes.data() + header.linkOffset, net.links.data(), linkBytes);
+		}
+		if (matrixBytes > 0) {
+			std::memcpy(bytes.data() + header.matrixOffset, net.matrices.data(), matrixBytes);
+		}
+
+		return bytes;
+	}
+
+	bool Deserialize(const uint8_t* data, size_t size, CompiledNet& net) {
+		using NetFormat::Header;
+
+		if (size < sizeof(Header)) {
+			LOG(LOG_ERROR, "NetCompiler::Deserialize too small");
+			return false;
+		}
+
+		Header header;
+		std::memcpy(&header, data, sizeof(Header));
+
+		if (std::memcmp(header.magic, NetFormat::MAGIC, sizeof(NetFormat::MAGIC)) != 0) {
+			LOG(LOG_ERROR, "NetCompiler::Deserialize not a net");
+			return false;
+		}
+		if (header.version != NetFormat::VERSION || header.linkSize != sizeof(CellLink) || header.matrixSize != sizeof(CellMatrix)) {
+			LOG(LOG_WARNING, "NetCompiler::Deserialize version " + std::to_string(header.version) + " is not supported, expected " + std::to_string(NetFormat::VERSION));
+			return false;
+		}
+
+		uint64_t cellCount = static_cast<uint64_t>(header.gridHeight) * header.gridWidth;
+
+		if (header.fileSize != size
+			|| header.linkOffset + cellCount * sizeof(CellLink) > size
+			|| header.matrixOffset + cellCount * sizeof(CellMatrix) > size) {
+			LOG(LOG_ERROR, "NetCompiler::Deserialize truncated");
+			return false;
+		}
+
+		net.gridHeight = header.gridHeight;
+		net.gridWidth = header.gridWidth;
+		net.descriptionHash = header.descriptionHash;
+
+		net.links.resize(cellCount);
+		net.matrices.resize(cellCount);
+
+		if (cellCount > 0) {
+			std::memcpy(net.links.data(), data + header.linkOffset, cellCount * sizeof(CellLink));
+			std::memcpy(net.matrices.data(), data + header.matrixOffset, cellCount * sizeof(CellMatrix));
+		}
+
+		// Move follows these without looking, a link off the grid would walk out of every array indexed by cell
+		for (uint64_t cell = 0; cell < cellCount; cell++) {
+			for (uint32_t neighbour : net.links[cell].neighbours) {
+				if (neighbour >= cellCount) {
+					LOG(LOG_ERROR, "NetCompiler::Deserialize cell " + std::to_string(cell) + " links to " + std::to_string(neighbour)
+						+ ", the grid has " + std::to_string(cellCount) + " cells");
+					net = CompiledNet();
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	std::vector<uint8_t> SerializeDescription(const NetDescription& description) {
+		std::vector<uint8_t> bytes;
+		bytes.reserve(8 + description.faces.size() * sizeof(NetFace) + description.gluings.size() * 8 + 16);
+
+		Put<uint16_t>(bytes, description.gridHeight);
+		Put<uint16_t>(bytes, description.gridWidth);
+		Put<uint16_t>(bytes, static_cast<uint16_t>(description.faces.size()));
+		Put<uint16_t>(bytes, static_cast<uint16_t>(description.gluings.size()));
+
+		for (const NetFace& face : description.faces) {
+			Put<uint16_t>(bytes, face.y);
+			Put<uint16_t>(bytes, face.x);
+			Put<uint16_t>(bytes, face.height);
+			Put<uint16_t>(bytes, face.width);
+		}
+
+		for (const NetGluing& gluing : description.gluings) {
+			Put<uint8_t>(bytes, gluing.faceA);
+			Put<uint8_t>(bytes, static_cast<uint8_t>(gluing.edgeA));
+			Put<uint8_t>(bytes, gluing.faceB);
+			Put<uint8_t>(bytes, static_cast<uint8_t>(gluing.edgeB));
+			Put<float>(bytes, gluing.foldDegrees);
+		}
+
+		for (float coordinate : description.origin) {
+			Put<float>(bytes, coordinate);
+		}
+		Put<float>(bytes, description.inflate);
+
+		return bytes;
+	}
+
+	bool DeserializeDescription(const uint8_t* data, size_t size, NetDescription& description) {
+		size_t offset = 0;
+		uint16_t nFaces = 0;
+		uint16_t nGluings = 0;
+
+		NetDescription read;
+		bool isRead = Take(data, size, offset, read.gridHeight)
+			&& Take(data, size, offset, read.gridWidth)
+			&& Take(data, size, offset, nFaces)
+			&& Take(data, size, offset, nGluings);
+
+		read.faces.resize(isRead ? nFaces : 0);
+		for (NetFace& face : read.faces) {
+			isRead = isRead && Take(data, size, offset, face.y) && Take(data, size, offset, face.x)
+				&& Take(data, size, offset, face.height) && Take(data, size, offset, face.width);
+		}
+
+		read.gluings.resize(isRead ? nGluings : 0);
+		for (NetGluing& gluing : read.gluings) {
+			uint8_t edgeA = 0;
+			uint8_t edgeB = 0;
+			isRead = isRead && Take(data, size, offset, gluing.faceA) && Take(data, size, offset, edgeA)
+				&& Take(data, size, offset, gluing.faceB) && Take(data, size, offset, edgeB)
+				&& Take(data, size, offset, gluing.foldDegrees);
+			gluing.edgeA = static_cast<Direction>(edgeA);
+			gluing.edgeB = static_cast<Direction>(edgeB);
+		}
+
+		for (float& coordinate : read.origin) {
+			isRead = isRead && Take(data, size, offset, coordinate);
+		}
+		isRead = isRead && Take(data, size, offset, read.inflate);
+
+		// whether the faces and gluings make sense is for Compile to say
+		if (!isRead || offset != size) {
+			LOG(LOG_ERROR, "NetCompiler::DeserializeDescription " + std::to_string(size) + " bytes are not a description");
+			return false;
+		}
+		if (static_cast<size_t>(read.gridHeight) * read.gridWidth > MAX_CELL_COUNT) {
+			LOG(LOG_ERROR, "NetCompiler::DeserializeDescription a grid of " + std::to_string(read.gridHeight) + " x " + std::to_string(read.gridWidth) + " is too big");
+			return false;
+		}
+
+		description = std::move(read);
+		return true;
+	}
+
+	bool IsSameDescription(const NetDescription& a, const NetDescription& b) {
+		return SerializeDescription(a) == SerializeDescription(b);
+	}
+
+	bool Save(const CompiledNet& net, const std::string& path) {
+		std::vector<uint8_t> bytes = Serialize(net);
+		std::string tempPath = path + ".tmp";
+
+		FILE* file = std::fopen(tempPath.c_str(), "wb");
+		if (file == nullptr) {
+			LOG(LOG_ERROR, "NetCompiler::Save cannot write " + tempPath);
+			return false;
+		}
+
+		bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+		written = (std::fclose(file) == 0) && written;
+
+		// replaced in one step, whoever loads at the same time sees the old file or the new one
+		std::error_code error;
+		if (written) {
+			std::filesystem::rename(tempPath, path, error);
+		}
+
+		if (!written || error) {
+			std::remove(tempPath.c_str());
+			LOG(LOG_ERROR, "NetCompiler::Save cannot write " + path);
+			return false;
+		}
+		return true;
+	}
+
+	bool Load(const std::string& path, CompiledNet& net) {
+		MappedFile file;
+
+		if (!file.Open(path)) {
+			return false;
+		}
+
+		return Deserialize(file.GetData(), file.GetSize(), net);
+	}
+
+	std::shared_ptr<const CompiledNet> LoadOrCompile(const NetDescription& description, const std::string& cachePath) {
+		auto net = std::make_shared<CompiledNet>();
+		uint64_t hash = Hash(description);
+
+		std::error_code error;
+		bool isCached = !cachePath.empty() && std::filesystem::exists(cachePath, error);
+
+		if (isCached && Load(cachePath, *net) && net->descriptionHash == hash) {
+			net->description = description;
+			return net;
+		}
+
+		if (!Compile(description, *net)) {
+			return nullptr;
+		}
+
+		if (!cachePath.empty()) {
+			Save(*net, cachePath);
+		}
+
+		LOG(LOG_INFO, "NetCompiler::LoadOrCompile compiled a net of " + std::to_string(description.faces.size()) + " faces"
+			+ (cachePath.empty() ? std::string() : " into " + cachePath));
+		return net;
+	}
+
+	NetDescription DescribeBox(uint16_t length, uint16_t width, uint16_t height) {
+		NetDescription description;
+
+		// lateral faces length, width, length, width wide and height high, then the top and the bottom, length x width
+		uint16_t lateralWidths[4] = { length, width, length, width };
+		uint16_t x = 0;
+
+		description.gridHeight = height > width ? height : width;
+
+		for (int i = 0; i < 4; i++) {
+			description.faces.push_back(NetFace{ 0, x, height, lateralWidths[i] });
+			x = static_cast<uint16_t>(x + lateralWidths[i]);
+		}
+
+		description.faces.push_back(NetFace{ 0, x, width, length });
+		description.faces.push_back(NetFace{ 0, static_cast<uint16_t>(x + length), width, length });
+		description.gridWidth = static_cast<uint16_t>(x + 2 * length);
+
+		// the seams of LinkCubeNet: the sides in a ring, their upper edges around the top, their lower edges around the bottom
+		constexpr uint8_t TOP = 4;
+		constexpr uint8_t BOTTOM = 5;
+		constexpr Direction TOP_EDGES[4] = { Direction::DOWN, Direction::RIGHT, Direction::UP, Direction::LEFT };
+		constexpr Direction BOTTOM_EDGES[4] = { Direction::UP, Direction::RIGHT, Direction::DOWN, Direction::LEFT };
+
+		for (uint8_t i = 0; i < 4; i++) {
+			description.gluings.push_back(NetGluing{ i, Direction::RIGHT, static_cast<uint8_t>((i + 1) % 4), Direction::LEFT, 90.0f });
+			description.gluings.push_back(NetGluing{ i, Direction::UP, TOP, TOP_EDGES[i], 90.0f });
+			description.gluings.push_back(NetGluing{ i, Direction::DOWN, BOTTOM, BOTTOM_EDGES[i], 90.0f });
+		}
+
+		// like PlaceCubeNetCell: the first side on top, its cells GROUND_OFFSET above the surface
+		description.inflate = GridTopology::GROUND_OFFSET - 0.5f;
+		description.origin[0] = -0.5f;
+		description.origin[1] = GridTopology::GROUND_OFFSET + 0.5f - description.inflate;
+		description.origin[2] = -0.5f;
+
+		return description;
+	}
+
+	NetDescription DescribeCube(uint16_t edge) {
+		return DescribeBox(edge, edge, edge);
+	}
+}
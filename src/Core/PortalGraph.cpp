@@ -0,0 +1,137 @@
+#include "Core/PortalGraph.h"
+
+#include <algorithm>
+
+std::string PortalGraph::GetName() const { return "PortalGraph"; }
+
+void PortalGraph::log(LogLevel level, std::string text) {
+    LOG(level, GetName() + "::" + text);
+}
+
+std::vector<Portal>::const_iterator PortalGraph::LowerBound(uint32_t gridID, uint32_t cell) const {
+    return std::lower_bound(portals_.begin(), portals_.end(), std::make_pair(gridID, cell),
+        [](const Portal& portal, const std::pair<uint32_t, uint32_t>& key) {
+            return portal.fromGridID != key.first ? portal.fromGridID < key.first : portal.fromCell < key.second;
+        });
+}
+
+void PortalGraph::Add(const Portal& portal) {
+    auto it = LowerBound(portal.fromGridID, portal.fromCell);
+    size_t index = static_cast<size_t>(it - portals_.begin());
+
+    if (it != portals_.end() && it->fromGridID == portal.fromGridID && it->fromCell == portal.fromCell) {
+        portals_[index] = portal;
+        return;
+    }
+
+    portals_.insert(portals_.begin() + index, portal);
+}
+
+bool PortalGraph::Remove(uint32_t fromGridID, uint32_t fromCell) {
+    auto it = LowerBound(fromGridID, fromCell);
+
+    if (it == portals_.end() || it->fromGridID != fromGridID || it->fromCell != fromCell) {
+        return false;
+    }
+
+    portals_.erase(it);
+    return true;
+}
+
+void PortalGraph::RemoveGrid(uint32_t gridID, std::vector<Portal>& removed) {
+    auto isGone = [gridID](const Portal& portal) {
+        return portal.fromGridID == gridID || portal.toGridID == gridID;
+    };
+
+    for (const Portal& portal : portals_) {
+        if (isGone(portal)) {
+            removed.push_back(portal);
+        }
+    }
+
+    portals_.erase(std::remove_if(portals_.begin(), portals_.end(), isGone), portals_.end());
+}
+
+void PortalGraph::Clear() {
+    portals_.clear();
+}
+
+PortalGraph::Range PortalGraph::From(uint32_t gridID) const {
+    auto first = LowerBound(gridID, 0);
+    auto last = first;
+
+    while (last != portals_.end() && last->fromGridID == gridID) {
+        ++last;
+    }
+
+    return Range{ portals_.data() + (first - portals_.begin()), portals_.data() + (last - portals_.begin()) };
+}
+
+const Portal* PortalGraph::Find(uint32_t fromGridID, uint32_t fromCell) const {
+    auto it = LowerBound(fromGridID, fromCell);
+
+    if (it == portals_.end() || it->fromGridID != fromGridID || it->fromCell != fromCell) {
+        return nullptr;
+    }
+    return &*it;
+}
+
+bool PortalGraph::FindRoute(uint32_t fromGridID, uint32_t toGridID, std::vector<Portal>& route) {
+    constexpr uint32_t START = UINT32_MAX;
+
+    route.clear();
+
+    if (fromGridID == toGridID) {
+        return true;
+    }
+
+    reachedBy_.clear();
+    frontier_.clear();
+
+    reachedBy_[fromGridID] = START;
+    frontier_.push_back(fromGridID);
+
+    bool isFound = false;
+
+    while (!frontier_.empty() && !isFound) {
+        nextFrontier_.clear();
+
+        for (uint32_t gridID : frontier_) {
+            Range out = From(gridID);
+
+            for (const Portal& portal : out) {
+                if (reachedBy_.count(portal.toGridID) != 0) {
+                    continue;
+                }
+
+                reachedBy_[portal.toGridID] = static_cast<uint32_t>(&portal - portals_.data());
+                nextFrontier_.push_back(portal.toGridID);
+
+                if (portal.toGridID == toGridID) {
+                    isFound = true;
+                    break;
+                }
+            }
+
+            if (isFound) {
+                break;
+            }
+        }
+
+        frontier_.swap(nextFrontier_);
+    }
+
+    if (!isFound) {
+        return false;
+    }
+
+    // back from the target, then turned around
+    for (uint32_t gridID = toGridID; gridID != fromGridID; ) {
+        const Portal& portal = portals_[reachedBy_[gridID]];
+        route.push_back(portal);
+        gridID = portal.fromGridID;
+    }
+    std::reverse(route.begin(), route.end());
+
+    return true;
+}
@@ -1,273 +1,378 @@
-#include "Core/RidableObject.h"
-
-std::string RidableObject::GetName() const {
-	return "RidableObject";
-}
-
-uint8_t RidableObject::GetTypeID() { return 1; }
-
-RidableObject::RidableObject()
-	: GameObject(),
-	gridHeight_(0), gridWidth_(0) {
-	Initialize();
-
-	movementManager_ = std::unique_ptr<MovementManager>(new MovementManager());
-	gridTransformManager_ = std::unique_ptr<GridTransformManager>(new GridTransformManager());
-}
-
-RidableObject::RidableObject(uint32_t objID, uint32_t meshID, uint32_t textureID, uint8_t cubeEdgeLength)
-	: GameObject(objID, meshID, textureID),
-	gridHeight_(cubeEdgeLength), gridWidth_(cubeEdgeLength * 6) {
-	Initialize();
-
-	movementManager_ = std::unique_ptr<MovementManager>(new MovementManager(cubeEdgeLength));
-	gridTransformManager_ = std::unique_ptr<GridTransformManager>(new GridTransformManager(cubeEdgeLength));
-}
-
-RidableObject::RidableObject(uint32_t objID, uint32_t meshID, uint32_t textureID, uint8_t gridHeight, uint8_t gridWidth)
-	: GameObject(objID, meshID, textureID),
-	gridHeight_(gridHeight), gridWidth_(gridWidth) {
-	Initialize();
-
-	movementManager_ = std::unique_ptr<MovementManager>(new MovementManager(gridHeight, gridWidth));
-	gridTransformManager_ = std::unique_ptr<GridTransformManager>(new GridTransformManager(gridHeight, gridWidth));
-}
-
-void RidableObject::Initialize() {
-	log_info();
-
-	log(LOG_INFO, "Resetting Grid Size");
-	grid_.resize(gridHeight_ * gridWidth_, 0);
-}
-
-MovementManager* RidableObject::GetMovementManager() {
-	return movementManager_.get();
-}
-
-Coord2d RidableObject::GetPosition(uint32_t objID) {
-	std::vector<uint32_t>::iterator it = std::find(grid_.begin(), grid_.end(), objID);
-
-	uint8_t index;
-
-	if (it == grid_.end()) {
-		log(LOG_ERROR, "Could Not find Obj of id: " + std::to_string(objID) + " in here");
-	}
-
-	index = it - grid_.begin();
-
-	return index_on_vector_to_coord2d(index);
-}
-
-bool RidableObject::IsPositionOccupied(Coord2d pos) {
-	uint8_t index = coord2d_to_index_on_vector(pos);
-
-	if (IsInBounds(index)) {
-		// Occupied <=> not empty 
-		return (grid_[index] != 0);
-	}
-	else {
-
-		return true;
-	}
-}
-
-uint32_t RidableObject::GetObjectIDAt(Coord2d pos) {
-	uint8_t index = coord2d_to_index_on_vector(pos);
-
-	if (IsInBounds(index)) {
-		return grid_[index];
-	}
-	else {
-		return 0;
-	}
-}
-
-void RidableObject::SetObjIdAtPos(Coord2d pos, uint32_t objID) {
-
-	uint8_t index = coord2d_to_index_on_vector(pos);
-
-	SetObjIdAtPos(index, objID); 
-} 
-
-void RidableObject::SetObjIdAtPos(uint8_t pos_index, uint32_t objID) {
-	if (IsInBounds(pos_index)) {
-		grid_[pos_index] = objID;
-
-		log(LOG_INFO, "Set ObjID: " + std::to_string(objID) + " at pos: " + std::to_string(pos_index));
-		return;
-	}
-	else {
-		// do nothing if out of bounds 
-		return;
-	}
-}
-
-bool RidableObject::IsInBounds(int index) {
-	if (index >= 0 && index < gridHeight_ * gridWidth_) {
-		log(LOG_INFO,
-			"Index:" + std::to_string(index)
-			+ " of length: "
-			+ std::to_string(gridHeight_ * gridWidth_));
-		return true; 
-	}
-	else {
-		log(LOG_WARNING, 
-			"Index:" + std::to_string(index) 
-			+ " is out of bounds of length: " 
-			+ std::to_string(gridHeight_ * gridWidth_));
-		return false; 
-	}
-}
-
-void RidableObject::SwapObjOnGrid(Coord2d a, Coord2d b) {
-	int idx_a = this->coord2d_to_index_on_vector(a);
-	int idx_b = this->coord2d_to_index_on_vector(b);
-
-	if (IsInBounds(idx_a) || IsInBounds(idx_b)) {
-		log(LOG_ERROR, "Index Error");
-		return;
-	}
-
-	uint32_t temp = grid_[idx_a];
-
-	grid_[idx_a] = grid_[idx_b];
-	grid_[idx_b] = temp;
-
-	return;
-}
-
-uint8_t RidableObject::coord2d_to_index_on_vector(Coord2d pos) {
-	return pos.first * gridWidth_ + pos.second;
-}
-
-Coord2d RidableObject::index_on_vector_to_coord2d(uint8_t pos) {
-	int y = pos / gridWidth_;
-	int x = pos % gridWidth_;
-
-	return { y, x };
-}
-
-void RidableObject::AddChildObjectToGridAtPosition(uint32_t childID, Coord2d pos) {
-	uint8_t curIndex = coord2d_to_index_on_vector(pos);
-
-	// add child to grid 
-	grid_[curIndex] = childID;
-
-	// registration of 'this' instance as the parent is dealt by Commands 
-
-	return;
-}
-
-bool RidableObject::RemoveChildAtGrid(uint32_t childID) {
-
-	for (int i = 0; i < grid_.size(); i++) {
-		if (grid_[i] == childID) {
-			grid_[i] = 0;
-
-			return true;
-		}
-	}
-
-	log(LOG_WARNING, "Cannot find childID. The ID maybe wrong.");
-	return false;
-}
-
-bool RidableObject::SetParentObjectAndExit(uint32_t newParentID) {
-	log(LOG_INFO, "Setting ParentObject");
-
-	if (parentID_ == 0) {
-		// previously had no parent  
-
-		// find empty spot and place exit to parent there
-		for (int i = 0; i < grid_.size(); i++) {
-			if (grid_[i] == 0) {
-				log(LOG_INFO, "Creating Exit at index: " + std::to_string(i));
-				grid_[i] = newParentID;
-
-				parentID_ = newParentID;
-
-				return true;
-			}
-		}
-
-		log(LOG_ERROR, "  There should be room to place an Exit to the Parent Object Grid. ");
-		return false;
-	}
-	else {
-		// find position of exit towards preivous parent and replace it with newParent ID 
-
-		// find empty spot and place exit to parent there
-		for (int i = 0; i < grid_.size(); i++) {
-			if (grid_[i] == parentID_) {
-				log(LOG_INFO, "Replacing Parent at index: " + std::to_string(i));
-				grid_[i] = newParentID;
-
-				parentID_ = newParentID;
-
-				return true;
-			}
-		}
-
-		log(LOG_WARNING, "Wasn't able to find previous parent on grid. Retrying after assuming there was no parent set after all");
-		parentID_ = 0;
-
-		bool success = SetParentObjectAndExit(newParentID);
-
-		return success;
-	}
-}
-
-
-// server & client
-
-uint8_t PlayableObject::GetTypeID() {
-	return 2;
-}
-
-void PlayableObject::TakeAction(Direction direction) {
-	int curDirectionInt = 0;
-
-	switch (direction) {
-	case(Direction::RIGHT):
-		curDirectionInt += 3; // turn right
-		curDirectionInt += static_cast<int>(direction);
-		curDirectionInt = curDirectionInt % 4;
-		direction = static_cast<Direction>(curDirectionInt);
-		break;
-	case(Direction::UP):
-		RequestWalk();
-		break;
-	case(Direction::LEFT):
-		curDirectionInt += 1; // turn right
-		curDirectionInt += static_cast<int>(direction);
-		curDirectionInt = curDirectionInt % 4;
-		direction = static_cast<Direction>(curDirectionInt);
-		break;
-	case(Direction::DOWN):
-		curDirectionInt += 2; // turn around
-		curDirectionInt += static_cast<int>(direction);
-		curDirectionInt = curDirectionInt % 4;
-		direction = static_cast<Direction>(curDirectionInt);
-		break;
-	case(Direction::IDLE):
-		LOG(LOG_INFO, "Publishing Item from Player");
-
-		DropItem();
-	}
-}
-
-void PlayableObject::DropItem()
-{
-}
-
-void PlayableObject::RequestWalk()
-{
-}
-
-void PlayableObject::Walk()
-{
-}
-
-void PlayableObject::PickUpItem(Item* item)
-{
+#include "Core/RidableObject.h"
+#include "Core/ComponentStore.h"
+#include "Network/ChangeJournal.h"
+
+std::string RidableObject::GetName() const {
+	return "RidableObject";
+}
+
+uint8_t RidableObject::GetTypeID() { return 1; }
+
+RidableObject::RidableObject()
+	: GameObject(),
+	gridHeight_(0), gridWidth_(0) {
+	Initialize();
+
+	movementManager_ = std::unique_ptr<MovementManager>(new MovementManager());
+	gridTransformManager_ = std::unique_ptr<GridTransformManager>(new GridTransformManager());
+}
+
+RidableObject::RidableObject(uint32_t objID, uint32_t meshID, uint32_t textureID, uint8_t cubeEdgeLength)
+	: GameObject(objID, meshID, textureID),
+	gridHeight_(cubeEdgeLength), gridWidth_(cubeEdgeLength * 6), isCubeNet_(true) {
+	Initialize();
+
+	movementManager_ = std::unique_ptr<MovementManager>(new MovementManager(cubeEdgeLength));
+	gridTransformManager_ = std::unique_ptr<GridTransformManager>(new GridTransformManager(cubeEdgeLength));
+}
+
+RidableObject::RidableObject(uint32_t objID, uint32_t meshID, uint32_t textureID, uint16_t gridHeight, uint16_t gridWidth)
+	: GameObject(objID, meshID, textureID),
+	gridHeight_(gridHeight), gridWidth_(gridWidth) {
+	Initialize();
+
+	movementManager_ = std::unique_ptr<MovementManager>(new MovementManager(gridHeight, gridWidth));
+	gridTransformManager_ = std::unique_ptr<GridTransformManager>(new GridTransformManager(gridHeight, gridWidth));
+}
+
+RidableObject::RidableObject(uint32_t objID, uint32_t meshID, uint32_t textureID, std::shared_ptr<const CompiledNet> net)
+	: GameObject(objID, meshID, textureID),
+	gridHeight_(net->gridHeight), gridWidth_(net->gridWidth), net_(net) {
+	Initialize();
+
+	movementManager_ = std::unique_ptr<MovementManager>(new MovementManager(net));
+	gridTransformManager_ = std::unique_ptr<GridTransformManager>(new GridTransformManager(std::move(net)));
+}
+
+void RidableObject::Initialize() {
+	log_info();
+
+	log(LOG_INFO, "Resetting Grid Size");
+	grid_.Reset(gridHeight_, gridWidth_, 0);
+}
+
+void RidableObject::SetObjIdAtCell(uint32_t cell, uint32_t objID) {
+	if (cell >= grid_.GetCellCount()) {
+		log(LOG_WARNING, "SetObjIdAtCell, cell " + std::to_string(cell) + " is out of bounds");
+		return;
+	}
+
+	WriteCell(cell, objID);
+}
+
+void RidableObject::ClearGrid() {
+	// every occupied cell has its entry, and WriteCell takes it out while we go
+	std::vector<uint32_t> cells;
+	cells.reserve(cellOfObject_.size());
+	for (const auto& entry : cellOfObject_) {
+		cells.push_back(entry.second);
+	}
+
+	for (uint32_t cell : cells) {
+		WriteCell(cell, 0);
+	}
+}
+
+MovementManager* RidableObject::GetMovementManager() {
+	return movementManager_.get();
+}
+
+Coord2d RidableObject::GetPosition(uint32_t objID) {
+	uint32_t index = FindCell(objID);
+
+	if (index == NO_CELL) {
+		log(LOG_ERROR, "Could Not find Obj of id: " + std::to_string(objID) + " in here");
+		return { -1, -1 };
+	}
+
+	return index_on_vector_to_coord2d(index);
+}
+
+bool RidableObject::IsGridIndexConsistent() {
+	size_t nOccupied = 0;
+	bool isConsistent = true;
+
+	grid_.ForEach([this, &nOccupied, &isConsistent](uint32_t cell, uint32_t objID) {
+		nOccupied++;
+
+		if (isConsistent && FindCell(objID) != cell) {
+			log(LOG_ERROR, "Grid index out of line at cell " + std::to_string(cell) + " holding " + std::to_string(objID));
+			isConsistent = false;
+		}
+	});
+
+	if (!isConsistent) {
+		return false;
+	}
+
+	if (nOccupied != cellOfObject_.size()) {
+		log(LOG_ERROR, "Grid index has " + std::to_string(cellOfObject_.size()) + " entries for " + std::to_string(nOccupied) + " occupied cells");
+		return false;
+	}
+
+	return true;
+}
+
+bool RidableObject::IsPositionOccupied(Coord2d pos) {
+	uint32_t index = coord2d_to_index_on_vector(pos);
+
+	if (IsInBounds(index)) {
+		// Occupied <=> not empty, one bit
+		return grid_.IsOccupied(index);
+	}
+	else {
+
+		return true;
+	}
+}
+
+uint32_t RidableObject::GetObjectIDAt(Coord2d pos) {
+	uint32_t index = coord2d_to_index_on_vector(pos);
+
+	if (IsInBounds(index)) {
+		return grid_.Get(index);
+	}
+	else {
+		return 0;
+	}
+}
+
+void RidableObject::SetObjIdAtPos(Coord2d pos, uint32_t objID) {
+
+	uint32_t index = coord2d_to_index_on_vector(pos);
+
+	SetObjIdAtPos(index, objID); 
+} 
+
+void RidableObject::SetObjIdAtPos(uint32_t pos_index, uint32_t objID) {
+	if (IsInBounds(pos_index)) {
+		WriteCell(pos_index, objID);
+
+		log(LOG_INFO, "Set ObjID: " + std::to_string(objID) + " at pos: " + std::to_string(pos_index));
+		return;
+	}
+	else {
+		// do nothing if out of bounds 
+		return;
+	}
+}
+
+bool RidableObject::IsInBounds(int64_t index) {
+	if (index >= 0 && static_cast<uint64_t>(index) < grid_.GetCellCount()) {
+		// quiet, every lookup on the grid comes through here
+		return true; 
+	}
+	else {
+		log(LOG_WARNING, 
+			"Index:" + std::to_string(index) 
+			+ " is out of bounds of length: " 
+			+ std::to_string(gridHeight_ * gridWidth_));
+		return false; 
+	}
+}
+
+void RidableObject::SwapObjOnGrid(Coord2d a, Coord2d b) {
+	uint32_t idx_a = this->coord2d_to_index_on_vector(a);
+	uint32_t idx_b = this->coord2d_to_index_on_vector(b);
+
+	if (!IsInBounds(idx_a) || !IsInBounds(idx_b)) {
+		log(LOG_ERROR, "Index Error");
+		return;
+	}
+
+	uint32_t idA = grid_.Get(idx_a);
+	uint32_t idB = grid_.Get(idx_b);
+
+	// b moves over to a (and leaves b empty), then a's previous occupant takes b
+	WriteCell(idx_a, idB);
+	WriteCell(idx_b, idA);
+
+	return;
+}
+
+uint32_t RidableObject::coord2d_to_index_on_vector(Coord2d pos) {
+	if (pos.first < 0 || pos.second < 0 || pos.first >= gridHeight_ || pos.second >= gridWidth_) {
+		// out of bounds for IsInBounds
+		return RidableObject::NO_CELL;
+	}
+	return static_cast<uint32_t>(pos.first) * gridWidth_ + pos.second;
+}
+
+Coord2d RidableObject::index_on_vector_to_coord2d(uint32_t pos) {
+	int y = pos / gridWidth_;
+	int x = pos % gridWidth_;
+
+	return { y, x };
+}
+
+void RidableObject::AddChildObjectToGridAtPosition(uint32_t childID, Coord2d pos) {
+	uint32_t curIndex = coord2d_to_index_on_vector(pos);
+
+	if (curIndex >= grid_.GetCellCount()) {
+		log(LOG_WARNING, "AddChildObjectToGridAtPosition, position is out of bounds");
+		return;
+	}
+
+	// add child to grid 
+	WriteCell(curIndex, childID);
+
+	// registration of 'this' instance as the parent is dealt by Commands 
+
+	return;
+}
+
+bool RidableObject::RemoveChildAtGrid(uint32_t childID) {
+	uint32_t index = FindCell(childID);
+
+	if (index == NO_CELL) {
+		log(LOG_WARNING, "Cannot find childID. The ID maybe wrong.");
+		return false;
+	}
+
+	WriteCell(index, 0);
+	return true;
+}
+
+bool RidableObject::SetParentObjectAndExit(uint32_t newParentID) {
+	log(LOG_INFO, "Setting ParentObject");
+
+	if (parentID_ == 0) {
+		// previously had no parent  
+
+		// find empty spot and place exit to parent there
+		uint32_t freeCell = FindFreeCell();
+		if (freeCell != NO_CELL) {
+			log(LOG_INFO, "Creating Exit at index: " + std::to_string(freeCell));
+
+			// parent first, so that the exit is not taken for somebody standing on us
+			SetParentID(newParentID);
+			WriteCell(freeCell, newParentID);
+
+			return true;
+		}
+
+		log(LOG_ERROR, "  There should be room to place an Exit to the Parent Object Grid. ");
+		return false;
+	}
+	else {
+		// find position of exit towards preivous parent and replace it with newParent ID 
+		uint32_t exitCell = GetExitCell();
+
+		if (exitCell != NO_CELL) {
+			log(LOG_INFO, "Replacing Parent at index: " + std::to_string(exitCell));
+
+			SetParentID(newParentID);
+			WriteCell(exitCell, newParentID);
+
+			return true;
+		}
+
+		log(LOG_WARNING, "Wasn't able to find previous parent on grid. Retrying after assuming there was no parent set after all");
+		SetParentID(0);
+
+		bool success = SetParentObjectAndExit(newParentID);
+
+		return success;
+	}
+}
+
+void RidableObject::WriteCell(uint32_t cell, uint32_t objID) {
+	uint32_t previousID = grid_.Get(cell);
+
+	if (previousID == objID) {
+		return;
+	}
+
+	if (objID != 0) {
+		// an object stands in one cell at a time, leave the old one first
+		uint32_t currentCell = FindCell(objID);
+
+		if (currentCell != NO_CELL) {
+			grid_.Set(currentCell, 0);
+			cellOfObject_.erase(objID);
+			OnCellChanged(currentCell, objID, 0);
+		}
+	}
+
+	if (previousID != 0) {
+		cellOfObject_.erase(previousID);
+	}
+	if (objID != 0) {
+		cellOfObject_[objID] = cell;
+	}
+
+	grid_.Set(cell, objID);
+	OnCellChanged(cell, previousID, objID);
+}
+
+void RidableObject::OnCellChanged(uint32_t cell, uint32_t previousID, uint32_t newID) {
+	if (componentStore_ == nullptr) {
+		return;
+	}
+
+	if (ChangeJournal* journal = componentStore_->GetJournal()) {
+		journal->RecordGridSlot(GetID(), cell, newID);
+	}
+
+	// the exit to our parent is not standing on us
+	if (previousID != 0 && previousID != parentID_) {
+		componentStore_->ClearGridCell(previousID, GetID());
+	}
+	if (newID != 0 && newID != parentID_) {
+		componentStore_->SetGridCell(newID, GetID(), cell);
+	}
+}
+
+// server & client
+
+uint8_t PlayableObject::GetTypeID() {
+	return TYPE_ID;
+}
+
+void PlayableObject::TakeAction(Direction direction) {
+	int curDirectionInt = 0;
+
+	switch (direction) {
+	case(Direction::RIGHT):
+		curDirectionInt += 3; // turn right
+		curDirectionInt += static_cast<int>(direction);
+		curDirectionInt = curDirectionInt % 4;
+		direction = static_cast<Direction>(curDirectionInt);
+		break;
+	case(Direction::UP):
+		RequestWalk();
+		break;
+	case(Direction::LEFT):
+		curDirectionInt += 1; // turn right
+		curDirectionInt += static_cast<int>(direction);
+		curDirectionInt = curDirectionInt % 4;
+		direction = static_cast<Direction>(curDirectionInt);
+		break;
+	case(Direction::DOWN):
+		curDirectionInt += 2; // turn around
+		curDirectionInt += static_cast<int>(direction);
+		curDirectionInt = curDirectionInt % 4;
+		direction = static_cast<Direction>(curDirectionInt);
+		break;
+	case(Direction::IDLE):
+		LOG(LOG_INFO, "Publishing Item from Player");
+
+		DropItem();
+	}
+}
+
+void PlayableObject::DropItem()
+{
+}
+
+void PlayableObject::RequestWalk()
+{
+}
+
+void PlayableObject::Walk()
+{
+}
+
+void PlayableObject::PickUpItem(Item* item)
+{
 }
\ No newline at end of file
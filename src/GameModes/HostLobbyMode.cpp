@@ -1,93 +1,125 @@
-#include "GameModes/HostLobbyMode.h"
-#include "Network/NetworkMessage.h"
-#include "GameModes/HostLobbyMode.h"
-
-HostLobbyMode::HostLobbyMode(GameEngine* engine) : GameMode(engine) {}
-
-void HostLobbyMode::Enter() {
-    unsigned short tcp_port = 10429; 
-    unsigned short udp_port = 20429;
-
-
-    LOG(LOG_INFO, "HostLobbyMode::Initializing Gameserver");
-    // Initialize the server when entering host mode
-    server = std::make_unique<GameServer>(*(gameEngine->GetIOContext()), tcp_port, udp_port);
-
-    LOG(LOG_INFO, "HostLobbyMode::Run IO Context on IO Thread"); 
-
-    gameEngine->RunIOContextOnIOThread();  
-
-
-    {
-        this->TestRendering(); 
-    }
-}
-
-void HostLobbyMode::Update() {
-    // Check for new connections
-    // server->Update();
-
-    // If player clicks "Start Game" and we have players connected
-    if (/* start game button clicked */ false && !connectedPlayers.empty()) {
-        // Switch to PlayingMode
-        gameEngine->GetModeController()->SwitchMode(GameModeType::PLAYING);
-    }
-
-    
-}
-
-void HostLobbyMode::Update(float delta_time)
-{
-    server->GetGameState()->UpdateGameState(delta_time);
-}
-
-void HostLobbyMode::Draw() {
-    // Draw the lobby UI
-    // You'll need to implement actual rendering
-    // Show connected players
-    // Show "Start Game" button when ready
-
-    this->server->GetGameState()->Draw();
-}
-
-void HostLobbyMode::Exit() {
-    // Clean up server when leaving
-    server.reset();
-    connectedPlayers.clear();
-}
-
-void HostLobbyMode::TestRendering()
-{        
-    // test purpose 
-
-    EventDispatcher& dispatcher = EventDispatcher::GetInstance();
-
-    AddRidableObjectMessage* cur_aro_msg; 
-    RideOnRidableObjectMessage* cur_ror_msg; 
-
-    std::vector<uint8_t> data; 
-
-    // spawn 8 objects 
-    for (uint8_t i = 0; i < 25; i++) {
-        cur_aro_msg= new AddRidableObjectMessage(); 
-        cur_aro_msg->gridHeight_ = 2;  
-
-        data = cur_aro_msg->Serialize();  
-        delete cur_aro_msg; 
-
-        dispatcher.Publish(data);  
-    }
-
-    //----------------------------------------------------------
-    cur_ror_msg = new RideOnRidableObjectMessage(); 
-    cur_ror_msg->vehicleID = 1;
-    for (uint8_t i = 2; i < 26; i++) {
-        cur_ror_msg->riderID = i;
-        cur_ror_msg->rideAt = i - 2;
-        data = cur_ror_msg->Serialize();
-
-        dispatcher.Publish(data);
-    }
-
-    
-}
+#include "GameModes/HostLobbyMode.h"
+#include "Network/NetworkMessage.h"
+#include "GameModes/HostLobbyMode.h"
+
+HostLobbyMode::HostLobbyMode(GameEngine* engine) : GameMode(engine) {}
+
+void HostLobbyMode::Enter() {
+    unsigned short tcp_port = 10429; 
+    unsigned short udp_port = 20429;
+
+
+    LOG(LOG_INFO, "HostLobbyMode::Initializing Gameserver");
+    // Initialize the server when entering host mode
+    server = std::make_unique<GameServer>(*(gameEngine->GetIOContext()), tcp_port, udp_port);
+    server->GetGameState()->SetJobSystem(gameEngine->GetJobSystem());
+
+    LOG(LOG_INFO, "HostLobbyMode::Run IO Context on IO Thread"); 
+
+    gameEngine->RunIOContextOnIOThread();  
+
+
+    GameState* gameState = server->GetGameState();
+
+    if (LockstepConfig::PEERS_PER_MATCH > 0) {
+        // every peer builds the same start world itself (JoinLobbyMode::BuildTestScene). no snapshot, the clients don't have it
+        this->TestRendering();
+        gameState->ExecuteCommands();
+
+        // the host is a peer as well. the clients become peers as they join, see GameState::CreateAndRegisterPlayerObject
+        gameState->CreateAndRegisterPlayerObject(LockstepConfig::HOST_PEER_ID);
+        gameState->EnableLockstep(LockstepConfig::HOST_PEER_ID, gameState->GetPlayerObject(LockstepConfig::HOST_PEER_ID)->GetID());
+        return;
+    }
+
+    // before anybody joins, every client streams from the start. around its player object, see GameState::CreateAndRegisterPlayerObject
+    if (StreamingConfig::IS_ENABLED) {
+        gameState->EnableSubWorldStreaming();
+    }
+
+    // pick up the world where the last host left it, otherwise the test scene
+    if (!gameState->LoadSnapshot(SnapshotFormat::DEFAULT_PATH)) {
+        this->TestRendering(); 
+    }
+}
+
+void HostLobbyMode::Update() {
+    // Check for new connections
+    // server->Update();
+
+    // If player clicks "Start Game" and we have players connected
+    if (/* start game button clicked */ false && !connectedPlayers.empty()) {
+        // Switch to PlayingMode
+        gameEngine->GetModeController()->SwitchMode(GameModeType::PLAYING);
+    }
+
+    
+}
+
+void HostLobbyMode::Update(float delta_time)
+{
+    GameState* gameState = server->GetGameState();
+
+    // in lockstep the simulation runs at its own fixed rate, whenever everybody's inputs are in
+    LockstepController* lockstep = gameState->GetLockstep();
+    if (lockstep != nullptr) {
+        // everybody is in. nobody else gets in, the clients get the peer table and the ticks start
+        if (!lockstep->IsStarted() && lockstep->GetPeerCount() >= LockstepConfig::PEERS_PER_MATCH) {
+            server->stop_accepting_connections();
+            lockstep->Start();
+        }
+
+        lockstep->Advance(delta_time);
+    }
+    else {
+        gameState->UpdateGameState(delta_time);
+    }
+}
+
+void HostLobbyMode::Draw() {
+    // Draw the lobby UI
+    // You'll need to implement actual rendering
+    // Show connected players
+    // Show "Start Game" button when ready
+
+    this->server->GetGameState()->Draw();
+}
+
+void HostLobbyMode::Exit() {
+    // Clean up server when leaving
+    server->GetGameState()->SaveSnapshot(SnapshotFormat::DEFAULT_PATH);
+    server->GetGameState()->WaitForSnapshot();
+
+    server.reset();
+    connectedPlayers.clear();
+}
+
+void HostLobbyMode::TestRendering()
+{        
+    // test purpose 
+
+    EventBus<AddRidableObjectMessage>& addRidableBus = EventBus<AddRidableObjectMessage>::GetInstance();
+    EventBus<RideOnRidableObjectMessage>& rideOnRidableBus = EventBus<RideOnRidableObjectMessage>::GetInstance();
+
+    AddRidableObjectMessage cur_aro_msg; 
+    RideOnRidableObjectMessage cur_ror_msg; 
+
+    // spawn 8 objects 
+    for (uint8_t i = 0; i < 25; i++) {
+        cur_aro_msg = AddRidableObjectMessage(); 
+        cur_aro_msg.gridHeight_ = 2;  
+
+        addRidableBus.Publish(cur_aro_msg);  
+    }
+
+    //----------------------------------------------------------
+    cur_ror_msg.vehicleID = 1;
+    for (uint8_t i = 2; i < 26; i++) {
+        cur_ror_msg.riderID = i;
+        cur_ror_msg.rideAt = i - 2;
+
+        rideOnRidableBus.Publish(cur_ror_msg);
+    }
+
+    
+}
@@ -1,30 +1,30 @@
-#include "GameModes/HostPlayingMode.h"
-
-HostPlayingMode::HostPlayingMode(GameEngine* engine)
-	: GameMode(engine)
-{
-}
-
-HostPlayingMode::~HostPlayingMode()
-{
-}
-
-void HostPlayingMode::Enter()
-{
-}
-
-void HostPlayingMode::Update()
-{
-}
-
-void HostPlayingMode::Update(float delta_time)
-{
-}
-
-void HostPlayingMode::Draw()
-{
-}
-
-void HostPlayingMode::Exit()
-{
-}
+#include "GameModes/HostPlayingMode.h"
+
+HostPlayingMode::HostPlayingMode(GameEngine* engine)
+	: GameMode(engine)
+{
+}
+
+HostPlayingMode::~HostPlayingMode()
+{
+}
+
+void HostPlayingMode::Enter()
+{
+}
+
+void HostPlayingMode::Update()
+{
+}
+
+void HostPlayingMode::Update(float delta_time)
+{
+}
+
+void HostPlayingMode::Draw()
+{
+}
+
+void HostPlayingMode::Exit()
+{
+}
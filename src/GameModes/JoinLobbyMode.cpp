@@ -1,37 +1,77 @@
-#include "GameModes/JoinLobbyMode.h"
-#include "Core/GameEngine.h"
-
-JoinLobbyMode::JoinLobbyMode(GameEngine* engine) : GameMode(engine), isConnected(false) {}
-
-void JoinLobbyMode::Enter() {
-
-    // You might want to show a UI for entering server address
-    serverAddress = "127.0.0.1";  // Default to localhost for testing 
-
-    unsigned short tcp_port = 10429;
-    unsigned short udp_port = 20429; 
-    
-    // Initialize client when entering join mode
-    client = std::make_unique<GameClient>(gameEngine->GetIOContext(), tcp_port, udp_port); 
-
-    client->connect(gameEngine->GetIOContext(), serverAddress);
-
-    gameEngine->RunIOContextOnIOThread(); 
-}
-
-void JoinLobbyMode::Update() {
-
-}
-
-void JoinLobbyMode::Update(float delta_time)
-{
-}
-
-void JoinLobbyMode::Draw() {
-
-}
-
-void JoinLobbyMode::Exit() {
-    client.reset();
-    isConnected = false;
-}
+#include "GameModes/JoinLobbyMode.h"
+#include "Core/GameEngine.h"
+#include "Network/GameState.h"
+#include "Network/NetworkMessage.h"
+
+JoinLobbyMode::JoinLobbyMode(GameEngine* engine) : GameMode(engine), isConnected(false) {}
+
+void JoinLobbyMode::Enter() {
+
+    // You might want to show a UI for entering server address
+    serverAddress = "127.0.0.1";  // Default to localhost for testing 
+
+    unsigned short tcp_port = 10429;
+    unsigned short udp_port = 20429; 
+    
+    // Initialize client when entering join mode
+    client = std::make_unique<GameClient>(gameEngine->GetIOContext(), tcp_port, udp_port); 
+
+    // the host builds the same one. the match starts with the host's peer table, see LockstepPeersCommand
+    if (LockstepConfig::PEERS_PER_MATCH > 0) {
+        this->BuildTestScene();
+    }
+
+    client->connect(gameEngine->GetIOContext(), serverAddress);
+
+    gameEngine->RunIOContextOnIOThread(); 
+}
+
+void JoinLobbyMode::Update() {
+
+}
+
+void JoinLobbyMode::Update(float delta_time)
+{
+    GameState* gameState = client->GetGameState();
+
+    LockstepController* lockstep = gameState->GetLockstep();
+    if (lockstep != nullptr) {
+        lockstep->Advance(delta_time);
+    }
+    else {
+        gameState->DrawGameState();
+    }
+}
+
+void JoinLobbyMode::Draw() {
+    client->GetGameState()->Draw();
+}
+
+void JoinLobbyMode::Exit() {
+    client.reset();
+    isConnected = false;
+}
+
+void JoinLobbyMode::BuildTestScene()
+{
+    // HostLobbyMode::TestRendering, applied right away instead of going through the server
+    GameState* gameState = client->GetGameState();
+
+    AddRidableObjectMessage cur_aro_msg;
+    RideOnRidableObjectMessage cur_ror_msg;
+
+    for (uint8_t i = 0; i < 25; i++) {
+        cur_aro_msg = AddRidableObjectMessage();
+        cur_aro_msg.gridHeight_ = 2;
+
+        GameMessageProcessor::ProcessMessage(cur_aro_msg)->Execute(*gameState);
+    }
+
+    cur_ror_msg.vehicleID = 1;
+    for (uint8_t i = 2; i < 26; i++) {
+        cur_ror_msg.riderID = i;
+        cur_ror_msg.rideAt = i - 2;
+
+        GameMessageProcessor::ProcessMessage(cur_ror_msg)->Execute(*gameState);
+    }
+}
@@ -1,39 +1,39 @@
-#include "GameModes/JoinPlayingMode.h"
-
-JoinPlayingMode::JoinPlayingMode(GameEngine* engine)
-	:GameMode(engine)
-{
-
-
-	
-
-}
-
-JoinPlayingMode::~JoinPlayingMode()
-{
-
-}
-
-void JoinPlayingMode::Enter()
-{
-
-}
-
-void JoinPlayingMode::Update()
-{
-
-}
-
-void JoinPlayingMode::Update(float delta_time)
-{
-}
-
-void JoinPlayingMode::Draw()
-{
-
-}
-
-void JoinPlayingMode::Exit()
-{
-
-}
+#include "GameModes/JoinPlayingMode.h"
+
+JoinPlayingMode::JoinPlayingMode(GameEngine* engine)
+	:GameMode(engine)
+{
+
+
+	
+
+}
+
+JoinPlayingMode::~JoinPlayingMode()
+{
+
+}
+
+void JoinPlayingMode::Enter()
+{
+
+}
+
+void JoinPlayingMode::Update()
+{
+
+}
+
+void JoinPlayingMode::Update(float delta_time)
+{
+}
+
+void JoinPlayingMode::Draw()
+{
+
+}
+
+void JoinPlayingMode::Exit()
+{
+
+}
@@ -0,0 +1,97 @@
+#include "Network/ChangeJournal.h"
+#include "Core/SlotMap.h"
+
+#include <algorithm>
+#include <sstream>
+
+std::string ChangeJournal::GetName() const { return "ChangeJournal"; }
+
+void ChangeJournal::log(LogLevel level, std::string text) {
+    LOG(level, GetName() + "::" + text);
+}
+
+void ChangeJournal::Append(ChangeType type, uint8_t typeID, uint32_t objectID, uint32_t cell, uint32_t other, bool fromNetwork) {
+    ChangeRecord record;
+    record.type = type;
+    record.flags = (fromNetwork || fromNetworkDepth_ > 0) ? FROM_NETWORK : 0;
+    record.typeID = typeID;
+    record.objectID = objectID;
+    record.cell = cell;
+    record.other = other;
+
+    records_.push_back(record);
+    totals_[static_cast<size_t>(type)]++;
+}
+
+void ChangeJournal::RecordSpawn(uint32_t objectID, uint8_t typeID, bool fromNetwork) {
+    Append(ChangeType::SPAWN, typeID, objectID, 0, 0, fromNetwork);
+}
+
+void ChangeJournal::RecordRemove(uint32_t objectID, uint8_t typeID, bool fromNetwork) {
+    Append(ChangeType::REMOVE, typeID, objectID, 0, 0, fromNetwork);
+}
+
+void ChangeJournal::RecordReparent(uint32_t objectID, uint32_t parentID) {
+    Append(ChangeType::REPARENT, 0, objectID, 0, parentID, false);
+}
+
+void ChangeJournal::RecordGridSlot(uint32_t gridOwnerID, uint32_t cell, uint32_t occupantID) {
+    Append(ChangeType::GRID_SLOT, 0, gridOwnerID, cell, occupantID, false);
+}
+
+void ChangeJournal::RecordTransform(uint32_t objectID) {
+    uint32_t slot = ObjectHandle::IndexOf(objectID);
+
+    if (slot >= transformRecordedAt_.size()) {
+        transformRecordedAt_.resize(slot + 1, 0);
+    }
+
+    // the consumers read the final transform anyway, once per tick is enough
+    if (transformRecordedAt_[slot] == tick_ + 1) {
+        return;
+    }
+    transformRecordedAt_[slot] = tick_ + 1;
+
+    Append(ChangeType::TRANSFORM, 0, objectID, 0, 0, false);
+}
+
+void ChangeJournal::Subscribe(const std::string& name, Consumer consumer) {
+    ListenerStats* stats = ListenerProfiler::GetInstance().Register("ChangeJournal/" + name);
+    consumers_.push_back({ std::move(consumer), stats });
+}
+
+void ChangeJournal::Publish() {
+    published_.swap(records_);
+    records_.clear();
+
+    publishedTick_ = tick_;
+    tick_++;
+
+    peakRecordsPerTick_ = std::max(peakRecordsPerTick_, published_.size());
+
+    if (!published_.empty()) {
+        for (ConsumerEntry& entry : consumers_) {
+            ScopedListenerTimer timer(entry.stats);
+            entry.consumer(*this);
+        }
+    }
+
+    published_.clear();
+}
+
+void ChangeJournal::Clear() {
+    records_.clear();
+}
+
+void ChangeJournal::LogStats() {
+    static const char* typeNames[] = { "spawn", "remove", "reparent", "grid slot", "transform" };
+
+    std::stringstream ss;
+    ss << "Changes over " << tick_ << " ticks (peak " << peakRecordsPerTick_ << " per tick):";
+
+    for (size_t i = 0; i < totals_.size(); i++) {
+        ss << " " << typeNames[i] << " " << totals_[i];
+    }
+
+    log(LOG_INFO, ss.str());
+}
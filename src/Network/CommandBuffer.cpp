@@ -0,0 +1,137 @@
+#include "Network/CommandBuffer.h"
+
+#include "Network/Command.h"
+#include "Network/GameState.h"
+#include "Network/ChangeJournal.h"
+
+namespace {
+    template <typename Record>
+    Record Read(const uint8_t* payload) {
+        Record record;
+        std::memcpy(&record, payload, sizeof(Record));
+        return record;
+    }
+
+    // the command classes do the work, they just live on the stack now
+    void Dispatch(CommandType type, const uint8_t* payload, GameState& gameState) {
+        switch (type) {
+        case CommandType::PLAYER_INPUT: {
+            PlayerInputRecord record = Read<PlayerInputRecord>(payload);
+            PlayerInputCommand(record.direction, record.playerID).Execute(gameState);
+            break;
+        }
+        case CommandType::ADD_GAMEOBJECT: {
+            AddGameObjectRecord record = Read<AddGameObjectRecord>(payload);
+            AddGameObjectCommand(record.typeID, record.objectID).Execute(gameState);
+            break;
+        }
+        case CommandType::REMOVE_GAMEOBJECT: {
+            RemoveGameObjectRecord record = Read<RemoveGameObjectRecord>(payload);
+            RemoveGameObjectCommand(record.objectID).Execute(gameState);
+            break;
+        }
+        case CommandType::GAMEOBJECT_POSITION: {
+            GameObjectPositionRecord record = Read<GameObjectPositionRecord>(payload);
+            GameObjectPositionCommand(record.y, record.x, record.objectID).Execute(gameState);
+            break;
+        }
+        case CommandType::GAMEOBJECT_PARENT: {
+            GameObjectParentRecord record = Read<GameObjectParentRecord>(payload);
+            GameObjectParentCommand(record.parentID, record.objectID).Execute(gameState);
+            break;
+        }
+        case CommandType::ADD_RIDABLE_OBJECT: {
+            AddRidableObjectRecord record = Read<AddRidableObjectRecord>(payload);
+            AddRidableObjectCommand(record.objectID, record.meshID, record.textureID, record.gridHeight, record.gridWidth).Execute(gameState);
+            break;
+        }
+        case CommandType::WALK_ON_RIDABLE_OBJECT: {
+            WalkOnRidableObjectRecord record = Read<WalkOnRidableObjectRecord>(payload);
+            WalkOnRidableObjectCommand(record.walkerID, record.direction).Execute(gameState);
+            break;
+        }
+        case CommandType::RIDE_ON_RIDABLE_OBJECT: {
+            RideOnRidableObjectRecord record = Read<RideOnRidableObjectRecord>(payload);
+            RideOnRidableObjectCommand(record.vehicleID, record.riderID, record.rideAt).Execute(gameState);
+            break;
+        }
+        case CommandType::GRID_SLOT: {
+            GridSlotRecord record = Read<GridSlotRecord>(payload);
+            GridSlotCommand(record.ownerID, record.cell, record.occupantID).Execute(gameState);
+            break;
+        }
+        case CommandType::SUBWORLD_RELEASE: {
+            SubWorldReleaseRecord record = Read<SubWorldReleaseRecord>(payload);
+            SubWorldReleaseCommand(record.ownerID).Execute(gameState);
+            break;
+        }
+        case CommandType::CREATE_PORTAL: {
+            CreatePortalRecord record = Read<CreatePortalRecord>(payload);
+            CreatePortalCommand(record.ridableID, record.y, record.x, record.toRidableID, record.toY, record.toX, record.rotation).Execute(gameState);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+std::string CommandBuffer::GetName() const { return "CommandBuffer"; }
+
+void CommandBuffer::log(LogLevel level, std::string text) {
+    LOG(level, GetName() + "::" + text);
+}
+
+void CommandBuffer::Append(CommandType type, uint8_t flags, const void* payload, size_t size) {
+    CommandHeader header;
+    header.type = type;
+    header.flags = flags;
+    header.size = static_cast<uint16_t>(size);
+    header.issuer = issuer_;
+
+    size_t offset = bytes_.size();
+    // zero filled, no stale bytes in the padding
+    bytes_.resize(offset + RecordSize(size), 0);
+
+    std::memcpy(bytes_.data() + offset, &header, sizeof(CommandHeader));
+    std::memcpy(bytes_.data() + offset + sizeof(CommandHeader), payload, size);
+
+    count_++;
+}
+
+void CommandBuffer::Execute(GameState& gameState) {
+    if (bytes_.empty()) {
+        return;
+    }
+
+    // a command may push again (a walk ending on a portal, ...), that goes into the next Execute
+    executing_.swap(bytes_);
+    Reset();
+
+    // our own records, written by Append. Nothing to check
+    size_t offset = 0;
+    while (offset < executing_.size()) {
+        CommandHeader header;
+        std::memcpy(&header, executing_.data() + offset, sizeof(CommandHeader));
+
+        ExecuteRecord(header, executing_.data() + offset + sizeof(CommandHeader), gameState);
+        offset += RecordSize(header.size);
+    }
+    executing_.clear();
+}
+
+void CommandBuffer::Reset() {
+    bytes_.clear();
+    count_ = 0;
+    issuer_ = 0;
+}
+
+void CommandBuffer::ExecuteRecord(const CommandHeader& header, const uint8_t* payload, GameState& gameState) {
+    if (header.flags & FROM_NETWORK) {
+        ChangeJournal::FromNetworkScope fromNetwork(gameState.GetChangeJournal());
+        Dispatch(header.type, payload, gameState);
+    }
+    else {
+        Dispatch(header.type, payload, gameState);
+    }
+}
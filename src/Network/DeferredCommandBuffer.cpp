@@ -0,0 +1,49 @@
+#include "Network/DeferredCommandBuffer.h"
+
+#include <algorithm>
+
+namespace {
+    struct Entry {
+        uint32_t issuer;
+        uint32_t sequence;
+        CommandHeader header;
+        const uint8_t* payload;
+    };
+}
+
+void DeferredCommandBuffer::Merge(std::vector<DeferredCommandBuffer>& buffers, GameState& gameState) {
+    size_t total = 0;
+    for (DeferredCommandBuffer& buffer : buffers) {
+        total += buffer.Size();
+    }
+    if (total == 0) {
+        return;
+    }
+
+    // the records stay where they are, only these get sorted
+    std::vector<Entry> merged;
+    merged.reserve(total);
+
+    for (DeferredCommandBuffer& buffer : buffers) {
+        // an object is updated by one thread from start to end, so within one issuer this is issue order
+        uint32_t sequence = 0;
+        buffer.commands_.ForEach([&merged, &sequence](const CommandHeader& header, const uint8_t* payload) {
+            merged.push_back({ header.issuer, sequence++, header, payload });
+            });
+    }
+
+    std::sort(merged.begin(), merged.end(), [](const Entry& a, const Entry& b) {
+        if (a.issuer != b.issuer) {
+            return a.issuer < b.issuer;
+        }
+        return a.sequence < b.sequence;
+        });
+
+    for (const Entry& entry : merged) {
+        CommandBuffer::ExecuteRecord(entry.header, entry.payload, gameState);
+    }
+
+    for (DeferredCommandBuffer& buffer : buffers) {
+        buffer.commands_.Reset();
+    }
+}
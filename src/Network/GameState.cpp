@@ -1,360 +1,879 @@
-#include "Network/GameState.h" 
-#include "Network/NetworkMessage.h"
-
-#include "Core/GameObject.h" 
-#include "Core/RidableObject.h"
-
-std::string GameState::GetName() const { return "GameState"; }
-
-void GameState::log(LogLevel level, std::string text) {
-    LOG(level, GetName() + "::" + text);
-}
-
-uint32_t GameState::GenerateNewGameObjectId() {
-    return nextGameObjectId++;
-}
-
-void GameState::Draw() {
-    // Debug 
-    renderer_->DrawRespectTo(2, 1, 3);
-}
-
-// Grid Management 
-void GameState::FoldGridIntoCubeAt(int startY, int startX, int size, bool fromNetwork) {
-
-    if (gridTransformManager != nullptr) {
-        gridTransformManager->InitTransforms(startY, startX, size);
-    }
-    if (movementManager != nullptr) {
-        movementManager->InitPlanarFigure(startY, startX, size);
-    }
-}
-
-void GameState::CreatePortalOnGridAt(int yCoord, int xCoord, bool fromNetwork) {
-    // to do
-}
-
-void GameState::CreateAndRegisterPlayerObject(uint32_t player_id)
-{
-    
-
-    GameObject* newPlayer = new PlayableObject();  
-
-    uint32_t newID = GenerateNewGameObjectId();  
-
-    newPlayer->SetID(newID); 
-
-    log(LOG_INFO, "Creating Playerable Object for player id: " + std::to_string(player_id) + "  objID: " + std::to_string(newID));
-
-    // we could think of Using CreateGameObject. However, if the call of this method encompases all the functions, we don't have to pass GameObject Creation message 
-    gameObjects[newID] = std::unique_ptr<GameObject>(newPlayer);    
-    players[player_id] = dynamic_cast<PlayableObject*>(newPlayer);   
-
-    return; 
-}
-
-void GameState::CreateAndRegisterGameObject(uint8_t typeId, bool fromNetwork)
-{
-    // Create GameObject with factory 
-    std::unique_ptr<GameObject> newObject = factoryRegistry[typeId]->Create();  
-
-    uint32_t newID = GenerateNewGameObjectId();  
-
-    newObject->SetID(newID);
-
-    log(LOG_INFO, "Generated GameObject id of typeId: " + std::to_string(typeId) + "  ObjID: " + std::to_string(newID));  
-
-    gameObjects[newID] = std::move(newObject);  
-    gameObjects[newID] = std::move(newObject);  
-    objectsByType.insert({typeId, newID});  
-
-    return;  
-}
-
-void GameState::CreateAndRegisterGameObjectWithID(uint32_t id, uint8_t typeId, bool fromNetwork) {
-    if (!fromNetwork) {
-        // propagate update to server
-    }
-
-    std::unique_ptr<GameObject> newGameObject;
-    newGameObject = factoryRegistry[typeId]->Create();
-
-    newGameObject->SetID(id);
-
-    gameObjects[id] = std::move(newGameObject);
-
-    // Add the object to the objectsByType map
-    objectsByType.insert({ typeId, id });
-
-    return;
-}
-
-void GameState::AddRidableObject(uint32_t objID, uint32_t meshID, uint32_t textureID, uint8_t gridHeight, uint8_t gridWidth)
-{
-    if (objID == 0) {
-        // when 0, allocate a new ID
-        objID = GenerateNewGameObjectId();
-    }
-
-    std::unique_ptr<RidableObject> newRidableObject; 
-
-    if (gridWidth != 0) {
-        newRidableObject = std::make_unique<RidableObject>(objID, meshID, textureID, gridHeight, gridWidth);
-    }
-    else {
-        newRidableObject = std::make_unique<RidableObject>(objID, meshID, textureID, gridHeight);
-    }
-
-    gameObjects[objID] = std::move(newRidableObject);
-
-    log(LOG_INFO, "Generated Ridable of ID: " + std::to_string(objID));
-}
-
-void GameState::RemoveGameObjectOfID(uint32_t id, bool fromNetwork) {
-    if (!fromNetwork) {
-        // propagate update to server
-    }
-
-    // Find and erase the GameObject from the gameObjects map
-    auto it = gameObjects.find(id);
-    if (it != gameObjects.end()) {
-        gameObjects.erase(it);
-
-        // Remove the object from the objectsByType map
-        auto range = objectsByType.equal_range(it->second->GetTypeID());
-
-        for (auto it2 = range.first; it2 != range.second; ++it2) {
-            if (it2->second == id) {
-                objectsByType.erase(it2);
-                break;
-            }
-        }
-    }
-}
-
-GameObject* GameState::GetGameObject(uint32_t id) {
-
-    auto it = gameObjects.find(id);
-    if (it != gameObjects.end()) {
-        return it->second.get();  // Returns raw pointer without transferring ownership
-    }
-    // Log an error 
-    return nullptr;
-}
-
-// Hierarchical Operations
-void GameState::SetParent(uint32_t childId, uint32_t parentId, bool fromNetwork) {
-    // to do 
-    
-    //if (!fromNetwork) {
-    //    // propagate update to server
-    //}
-
-    //GameObject* pChild = gameObjects[childId].get();
-    //GameObject* pParent = gameObjects[parentId].get();
-
-    //pChild->SetParent(pParent);
-    //pParent->AddChild(pChild);
-}
-
-// Version 1: Safer map access and cleaner dynamic_cast
-void GameState::UpdateGameObjectPosition(uint32_t id, int y, int x, bool fromNetwork) { 
-    // to do 
-    //if (!fromNetwork) {
-    //    // propagate update to server
-    //}
-
-    //auto it = gameObjects.find(id);
-    //if (it != gameObjects.end()) {
-    //    if (auto* gridObject = dynamic_cast<GameObjectOnGrid*>(it->second.get())) {
-    //        gridObject->SetCoordinates(y, x);
-    //    }
-    //}
-}
-
-std::vector<GameObject*> GameState::GetObjectsByType(uint8_t typeId) {
-    std::vector<GameObject*> objects;
-
-    // Find all objects with the given typeId in the objectsByType map
-    auto range = objectsByType.equal_range(typeId);
-    for (auto it = range.first; it != range.second; ++it) {
-        // Get the GameObject pointer from the gameObjects map
-        auto gameObjectIt = gameObjects.find(it->second);
-        if (gameObjectIt != gameObjects.end()) {
-            objects.push_back(gameObjectIt->second.get());
-        }
-    }
-
-    return objects;
-} 
-
-bool GameState::IsValidGameObject(uint32_t id) const {
-    return true; 
-}
-
-// BroadCast from Server  
-void GameState::RegisterAndBroadcastNewGameObject(GameObject* newGameObject) {
-    uint32_t newID = GenerateNewGameObjectId(); 
-    uint8_t objTypeID = 0; 
-
-    // turn raw pointer unique  
-    std::unique_ptr<GameObject> pGameObject(newGameObject);
-    // set ID of gameObject 
-    newGameObject->SetID(newID);
-    gameObjects[newID] = std::move(pGameObject);
-    // to do: add to objects by type. This is not currently possible. 
-
-    // Create Message 
-    INetworkMessage* curMessage = new AddGameObjectMessage(objTypeID, newID);
-
-    // Broadcast message through server  
-    server->broadcast_message(curMessage);
-
-    // Message is turned into data and sent through the server it is safe to delete 
-    delete curMessage;
-}
-
-void GameState::BroadcastGameObjectRemoval(uint32_t id) {
-    INetworkMessage* curMessage = new RemoveGameObjectMessage(id);
-
-    server->broadcast_message(curMessage);
-
-    delete curMessage;
-}
-
-// GameObjects don't set 
-//void GameState::BroadcastGameObjectPosition(GameObject* gameObject) {
-//    if (auto gridObject = dynamic_cast<GameObjectOnGrid*>(gameObject)) {
-//        INetworkMessage* curMessage = new GameObjectPositionMessage(
-//            gridObject->yCoord,
-//            gridObject->xCoord,
-//            gridObject->GetID()
-//        );
-//
-//        server->broadcast_message(curMessage);
-//
-//        delete curMessage;
-//    }
-//    else {
-//        // this gameObject has no position
-//    }
-//}
-
-void GameState::BroadcastGameObjectParenting(uint32_t parentID, uint32_t objID) {
-    INetworkMessage* curMessage = new GameObjectParentObjectMessage(parentID, objID);
-
-    server->broadcast_message(curMessage);
-
-    delete curMessage;
-}
-
-std::unique_ptr<INetworkMessage> GameState::CaptureGameState() {
-
-    // to do : create a child class of INetworkMessages that has all the infromation of current state of the game. 
-    return std::move(std::unique_ptr<INetworkMessage>(new PlayerInputMessage()));
-}
-
-// send from client 
-
-void GameState::SendPlayerInput(Direction direction) {
-    uint32_t playerID = 0;
-
-    INetworkMessage* curMessage = new PlayerInputMessage(
-        direction, playerID
-    );
-
-    client->send_message(curMessage, true);
-
-    delete curMessage;
-}
-
-// We don't set parents this way
-//// Hierarchical Operations
-//void GameState::SetParent(uint32_t childId, uint32_t parentId, bool fromNetwork) {
-//    if (!fromNetwork) {
-//        // propagate update to server
-//    }
-//
-//    GameObject* pChild = gameObjects[childId].get();
-//    GameObject* pParent = gameObjects[parentId].get();
-//
-//    pChild->SetParent(pParent);
-//    pParent->AddChild(pChild);
-//}
-
-// No more Object On Grid
-//// Version 1: Safer map access and cleaner dynamic_cast
-//void GameState::UpdateGameObjectPosition(uint32_t id, int y, int x, bool fromNetwork) {
-//    if (!fromNetwork) {
-//        // propagate update to server
-//    }
-//
-//    auto it = gameObjects.find(id);
-//    if (it != gameObjects.end()) {
-//        if (auto* gridObject = dynamic_cast<GameObjectOnGrid*>(it->second.get())) {
-//            gridObject->SetCoordinates(y, x);
-//        }
-//    }
-//}
-
-void GameState::PlayerTakeAction(uint32_t playerId, Direction input, bool fromNetwork) {
-    if (!fromNetwork) {
-        // propagate update to server
-    }
-    
-    auto it = players.find(playerId);  
-
-    if (it == players.end()) {
-        log(LOG_INFO, "Player id: " + std::to_string(playerId) + " is invalid");  
-    }
-    else {
-        // take action
-        log(LOG_INFO, "Player id: " + std::to_string(playerId) + " taking action : " + direction2String[input]);
-        players[playerId]->TakeAction(input);
-        return;
-    }
-
-}
-
-// No more Factory Component objects 
-//FactoryComponentObject* GameState::GetStructureAtCoord(int y, int x)
-//{
-//    uint32_t id = structureGrid[y * gridWidth + x];
-//    
-//    return dynamic_cast<FactoryComponentObject*>(gameObjects[id].get());
-//}
-
-GroundType GameState::GetGroundTypeAtCoord(int y, int x)
-{
-    return groundTypeGrid[y * gridWidth + x];
-}
-
-// No More Dropped Item
-//DroppedItemObject* GameState::GetDroppedItemAtCoord(int y, int x)
-//{
-//    uint32_t id = structureGrid[y * gridWidth + x];
-//
-//    return dynamic_cast<DroppedItemObject*>(gameObjects[id].get());
-//}
-
-void GameState::DropItemAt(int y, int x, Item* item)
-{
-    // Publish Creation of new dropped Item.  
-
-    // Publish position change of (y, x) 
-
-    // Pushlish parent-child relation of droppedItem-item
-}
-
-void GameState::DrawGameState()
-{
-}
-
-void GameState::UpdateGameState(float deltaTime) {
-    GameObject* curGameObject;
-    for (auto& pObject : gameObjects) {
-        curGameObject = pObject.second.get();
-
-        curGameObject->Update(deltaTime);
-    }
+#include "Network/GameState.h" 
+#include "Network/NetworkMessage.h"
+
+#include "Core/GameObject.h" 
+#include "Core/RidableObject.h"
+#include "Core/JobSystem.h"
+
+std::string GameState::GetName() const { return "GameState"; }
+
+void GameState::log(LogLevel level, std::string text) {
+    LOG(level, GetName() + "::" + text);
+}
+
+GameState::~GameState() {
+    // the camera in the renderer is a pooled GameObject as well
+    renderer_.reset();
+
+    gameObjects.Clear();
+    players.clear();
+    playableObjects.clear();
+    objectsByType.clear();
+
+    movementManager.reset();
+    gridTransformManager.reset();
+
+    changeJournal_.LogStats();
+
+    if (pathfinder_) {
+        pathfinder_->LogStats();
+    }
+
+    PoolAllocator::GetInstance().LogStats();
+    PoolAllocator::GetInstance().ReleaseUnused();
+}
+
+void GameState::InitializeChangeJournal() {
+    componentStore_.SetJournal(&changeJournal_);
+
+    if (isServerSide && server != nullptr) {
+        changeJournal_.Subscribe("GameState::ReplicateChanges", [this](const ChangeJournal& journal) {
+            this->ReplicateChanges(journal);
+            });
+
+        changeJournal_.Subscribe("GameState::MarkChangedSinceSave", [this](const ChangeJournal&) {
+            this->changedSinceSave_ = true;
+            });
+    }
+}
+
+void GameState::PublishChanges() {
+    changeJournal_.Publish();
+}
+
+bool GameState::SaveSnapshot(const std::string& path) {
+    if (!snapshot_.SaveAsync(*this, path)) {
+        return false;
+    }
+
+    changedSinceSave_ = false;
+    timeSinceSave_ = 0;
+    return true;
+}
+
+bool GameState::LoadSnapshot(const std::string& path) {
+    // don't read what is still being written
+    snapshot_.WaitForSave();
+
+    return snapshot_.Load(*this, path);
+}
+
+void GameState::WaitForSnapshot() {
+    snapshot_.WaitForSave();
+}
+
+void GameState::ReplicateChanges(const ChangeJournal& journal) {
+    if (streamer_) {
+        // per client, by the streamer
+        return;
+    }
+
+    for (const ChangeRecord& record : journal.GetRecords()) {
+        if (record.flags & ChangeJournal::FROM_NETWORK) {
+            // the clients got the message that caused it
+            continue;
+        }
+
+        switch (record.type) {
+        case ChangeType::SPAWN:
+            BroadcastGameObjectSpawn(record.typeID, record.objectID);
+            break;
+        case ChangeType::REMOVE:
+            BroadcastGameObjectRemoval(record.objectID);
+            break;
+        case ChangeType::REPARENT:
+            BroadcastGameObjectParenting(record.other, record.objectID);
+            break;
+        default:
+            // no messages for grid slots and transforms yet.
+            // so far they only change through commands whose messages are forwarded as they are
+            break;
+        }
+    }
+}
+
+uint32_t GameState::GenerateNewGameObjectId() {
+    uint32_t newID = gameObjects.Allocate();
+
+    if (newID == ObjectHandle::NONE) {
+        log(LOG_ERROR, "Ran out of game object slots");
+    }
+    return newID;
+}
+
+void GameState::Draw() {
+    // Debug 
+    renderer_->DrawRespectTo(2, 1, 3);
+}
+
+// Grid Management 
+void GameState::FoldGridIntoCubeAt(int startY, int startX, int size, bool fromNetwork) {
+
+    if (gridTransformManager != nullptr) {
+        gridTransformManager->InitTransforms(startY, startX, size);
+    }
+    if (movementManager != nullptr) {
+        movementManager->InitPlanarFigure(startY, startX, size);
+    }
+}
+
+bool GameState::CreatePortalOnGridAt(uint32_t ridableID, int yCoord, int xCoord, uint32_t toRidableID, int toY, int toX, uint8_t rotation, bool fromNetwork) {
+    RidableObject* from = dynamic_cast<RidableObject*>(GetGameObject(ridableID));
+    RidableObject* to = dynamic_cast<RidableObject*>(GetGameObject(toRidableID));
+
+    if (from == nullptr || to == nullptr || from->GetMovementManager() == nullptr || to->GetMovementManager() == nullptr) {
+        log(LOG_ERROR, "A portal needs two ridables, got " + std::to_string(ridableID) + " and " + std::to_string(toRidableID));
+        return false;
+    }
+
+    auto isOnGrid = [](RidableObject* ridable, int y, int x) {
+        return y >= 0 && x >= 0 && y < ridable->GetGridHeight() && x < ridable->GetGridWidth();
+    };
+
+    if (!isOnGrid(from, yCoord, xCoord) || !isOnGrid(to, toY, toX)) {
+        log(LOG_ERROR, "A portal end is off its grid: " + std::to_string(yCoord) + ", " + std::to_string(xCoord)
+            + " -> " + std::to_string(toY) + ", " + std::to_string(toX));
+        return false;
+    }
+
+    uint32_t cell = from->coord2d_to_index_on_vector({ yCoord, xCoord });
+    uint32_t toCell = to->coord2d_to_index_on_vector({ toY, toX });
+
+    if (ridableID == toRidableID && cell == toCell) {
+        log(LOG_ERROR, "A portal from a cell to itself");
+        return false;
+    }
+
+    UnlinkPortal(ridableID, cell);
+    UnlinkPortal(toRidableID, toCell);
+
+    LinkPortal(from, cell, to, toCell, rotation & 3);
+    LinkPortal(to, toCell, from, cell, (4 - rotation) & 3);
+
+    // the paths over both grids and what is close to whom changed
+    if (pathfinder_) {
+        pathfinder_->Invalidate(ridableID);
+        pathfinder_->Invalidate(toRidableID);
+    }
+    if (streamer_) {
+        streamer_->OnPortalChanged(ridableID, toRidableID);
+    }
+    changedSinceSave_ = true;
+
+    if (!fromNetwork && isServerSide && server != nullptr) {
+        BroadcastPortal(ridableID, yCoord, xCoord, toRidableID, toY, toX, rotation & 3);
+    }
+
+    log(LOG_INFO, "Portal " + std::to_string(ridableID) + "::" + std::to_string(cell)
+        + " <-> " + std::to_string(toRidableID) + "::" + std::to_string(toCell));
+    return true;
+}
+
+void GameState::LinkPortal(RidableObject* from, uint32_t fromCell, RidableObject* to, uint32_t toCell, uint8_t rotation) {
+    Coord2d toPos = to->index_on_vector_to_coord2d(toCell);
+
+    PortalLink link;
+    link.gridID = to->GetID();
+    link.cell = toCell;
+    link.y = static_cast<uint16_t>(toPos.first);
+    link.x = static_cast<uint16_t>(toPos.second);
+    link.rotation = rotation;
+
+    from->GetMovementManager()->SetPortal(fromCell, link);
+    portalGraph_.Add(Portal{ from->GetID(), fromCell, to->GetID(), toCell, rotation });
+}
+
+void GameState::UnlinkPortal(uint32_t gridID, uint32_t cell) {
+    const Portal* portal = portalGraph_.Find(gridID, cell);
+    if (portal == nullptr) {
+        return;
+    }
+
+    Portal removed = *portal;
+    portalGraph_.Remove(gridID, cell);
+
+    if (RidableObject* ridable = dynamic_cast<RidableObject*>(GetGameObject(gridID))) {
+        ridable->GetMovementManager()->RemovePortal(cell);
+    }
+
+    // the way back, if it still is one
+    const Portal* back = portalGraph_.Find(removed.toGridID, removed.toCell);
+    if (back != nullptr && back->toGridID == gridID && back->toCell == cell) {
+        portalGraph_.Remove(removed.toGridID, removed.toCell);
+
+        if (RidableObject* other = dynamic_cast<RidableObject*>(GetGameObject(removed.toGridID))) {
+            other->GetMovementManager()->RemovePortal(removed.toCell);
+        }
+        if (pathfinder_) {
+            pathfinder_->Invalidate(removed.toGridID);
+        }
+    }
+}
+
+void GameState::UnlinkPortalsOf(uint32_t gridID) {
+    if (portalGraph_.GetCount() == 0) {
+        return;
+    }
+
+    std::vector<Portal> removed;
+    portalGraph_.RemoveGrid(gridID, removed);
+
+    // the grid of gridID goes with its MovementManager, only the ends on the other grids are left
+    for (const Portal& portal : removed) {
+        if (portal.fromGridID == gridID) {
+            continue;
+        }
+        if (RidableObject* other = dynamic_cast<RidableObject*>(GetGameObject(portal.fromGridID))) {
+            other->GetMovementManager()->RemovePortal(portal.fromCell);
+        }
+        if (pathfinder_) {
+            pathfinder_->Invalidate(portal.fromGridID);
+        }
+    }
+}
+
+void GameState::CreateAndRegisterPlayerObject(uint32_t player_id)
+{
+    // nobody could send a late peer the state of a running match, and a player the others don't have is a desync
+    if (lockstep_ && isServerSide && lockstep_->IsStarted()) {
+        log(LOG_WARNING, "Lockstep match running, no player object for player id: " + std::to_string(player_id));
+        return;
+    }
+
+    CreateAndRegisterPlayerObjectWithID(player_id, GenerateNewGameObjectId());
+}
+
+void GameState::CreateAndRegisterPlayerObjectWithID(uint32_t player_id, uint32_t newID)
+{
+    GameObject* newPlayer = new PlayableObject();  
+
+    newPlayer->SetID(newID); 
+
+    log(LOG_INFO, "Creating Playerable Object for player id: " + std::to_string(player_id) + "  objID: " + std::to_string(newID));
+
+    // we could think of Using CreateGameObject. However, if the call of this method encompases all the functions, we don't have to pass GameObject Creation message 
+    // (clients don't get player objects replicated, hence fromNetwork)
+    InsertGameObject(newID, std::unique_ptr<GameObject>(newPlayer), true);    
+    players[player_id] = dynamic_cast<PlayableObject*>(newPlayer);   
+
+    if (streamer_) {
+        streamer_->AddClient(player_id, newID);
+    }
+
+    // the host's table. the clients learn theirs from it
+    if (lockstep_ && isServerSide) {
+        lockstep_->AddPeer(player_id, newID, lockstep_->GetTick() + LockstepConfig::INPUT_DELAY);
+    }
+
+    return; 
+}
+
+void GameState::RemovePlayerObject(uint32_t player_id) {
+    auto it = players.find(player_id);
+    if (it == players.end()) {
+        return;
+    }
+    uint32_t objectID = it->second->GetID();
+    players.erase(it);
+
+    if (streamer_) {
+        streamer_->RemoveClient(player_id);
+    }
+
+    // a lockstep peer's walker is part of everybody's simulation, it stays where it is
+    if (!lockstep_) {
+        RemoveGameObjectOfID(objectID, true);
+    }
+
+    log(LOG_INFO, "Removed player id: " + std::to_string(player_id) + "  objID: " + std::to_string(objectID));
+}
+
+PlayableObject* GameState::GetPlayerObject(uint32_t player_id) {
+    auto it = players.find(player_id);
+    return it == players.end() ? nullptr : it->second;
+}
+
+void GameState::CreateAndRegisterGameObject(uint8_t typeId, bool fromNetwork)
+{
+    // Create GameObject with factory 
+    std::unique_ptr<GameObject> newObject = factoryRegistry[typeId]->Create();  
+
+    uint32_t newID = GenerateNewGameObjectId();  
+
+    newObject->SetID(newID);
+
+    log(LOG_INFO, "Generated GameObject id of typeId: " + std::to_string(typeId) + "  ObjID: " + std::to_string(newID));  
+
+    InsertGameObject(newID, std::move(newObject), fromNetwork);  
+    objectsByType.insert({typeId, newID});  
+
+    return;  
+}
+
+void GameState::CreateAndRegisterGameObjectWithID(uint32_t id, uint8_t typeId, bool fromNetwork) {
+    if (!fromNetwork) {
+        // propagate update to server
+    }
+
+    std::unique_ptr<GameObject> newGameObject;
+    newGameObject = factoryRegistry[typeId]->Create();
+
+    newGameObject->SetID(id);
+
+    InsertGameObject(id, std::move(newGameObject), fromNetwork);
+
+    // Add the object to the objectsByType map
+    objectsByType.insert({ typeId, id });
+
+    return;
+}
+
+void GameState::AddRidableObject(uint32_t objID, uint32_t meshID, uint32_t textureID, uint16_t gridHeight, uint16_t gridWidth)
+{
+    if (gridWidth == 0 && gridHeight > UINT8_MAX) {
+        log(LOG_ERROR, "A cube net of edge " + std::to_string(gridHeight) + " is too big, the edge fits 8 bits");
+        return;
+    }
+
+    if (objID == 0) {
+        // when 0, allocate a new ID
+        objID = GenerateNewGameObjectId();
+    }
+
+    std::unique_ptr<RidableObject> newRidableObject; 
+
+    if (gridWidth != 0) {
+        newRidableObject = std::make_unique<RidableObject>(objID, meshID, textureID, gridHeight, gridWidth);
+    }
+    else {
+        newRidableObject = std::make_unique<RidableObject>(objID, meshID, textureID, static_cast<uint8_t>(gridHeight));
+    }
+
+    // comes from AddRidableObjectCommand. when that message is forwarded, the journal is told so by GameServer
+    InsertGameObject(objID, std::move(newRidableObject), false);
+
+    log(LOG_INFO, "Generated Ridable of ID: " + std::to_string(objID));
+}
+
+void GameState::AddRidableObject(uint32_t objID, uint32_t meshID, uint32_t textureID, const NetDescription& description)
+{
+    std::shared_ptr<const CompiledNet> net = GetNet(description);
+    if (net == nullptr) {
+        log(LOG_ERROR, "The net of ridable " + std::to_string(objID) + " doesn't compile, not added");
+        return;
+    }
+
+    if (objID == 0) {
+        objID = GenerateNewGameObjectId();
+    }
+
+    InsertGameObject(objID, std::make_unique<RidableObject>(objID, meshID, textureID, std::move(net)), false);
+
+    log(LOG_INFO, "Generated Ridable of ID: " + std::to_string(objID) + " folded like a net");
+}
+
+std::shared_ptr<const CompiledNet> GameState::GetNet(const NetDescription& description) {
+    uint64_t hash = NetCompiler::Hash(description);
+
+    // the hash only picks the entry, another shape of the same hash is compiled on its own and not kept
+    auto found = nets_.find(hash);
+    if (found != nets_.end()) {
+        if (NetCompiler::IsSameDescription(found->second->description, description)) {
+            return found->second;
+        }
+        log(LOG_WARNING, "Two nets hash to " + std::to_string(hash) + ", the second one is not shared");
+        return NetCompiler::LoadOrCompile(description, "");
+    }
+
+    std::shared_ptr<const CompiledNet> net = NetCompiler::LoadOrCompile(description, "");
+    if (net != nullptr) {
+        nets_[hash] = net;
+    }
+    return net;
+}
+
+void GameState::RemoveGameObjectOfID(uint32_t id, bool fromNetwork) {
+    if (!fromNetwork) {
+        // propagate update to server
+    }
+
+    // Find and erase the GameObject from the gameObjects map
+    GameObject* gameObject = GetGameObject(id);
+    if (gameObject != nullptr) {
+        uint8_t typeId = gameObject->GetTypeID();
+
+        UnlinkPortalsOf(id);
+
+        // the object leaves the component store in its destructor. 
+        // the slot's generation moves on, so every copy of id is stale from here
+        gameObjects.Remove(id);
+
+        changeJournal_.RecordRemove(id, typeId, fromNetwork);
+
+        // Remove the object from the objectsByType map
+        auto range = objectsByType.equal_range(typeId);
+
+        for (auto it2 = range.first; it2 != range.second; ++it2) {
+            if (it2->second == id) {
+                objectsByType.erase(it2);
+                break;
+            }
+        }
+    }
+}
+
+GameObject* GameState::InsertGameObject(uint32_t id, std::unique_ptr<GameObject> gameObject, bool fromNetwork) {
+    GameObject* ptrGameObject = gameObject.get();
+
+    if (id == ObjectHandle::NONE) {
+        log(LOG_ERROR, "Cannot insert a game object without an id");
+        return nullptr;
+    }
+
+    // whoever holds the slot right now (same id, or an older generation the server already recycled) has to go first
+    uint32_t previousID = gameObjects.HandleAt(ObjectHandle::IndexOf(id));
+    if (previousID != ObjectHandle::NONE && GetGameObject(previousID) != nullptr) {
+        RemoveGameObjectOfID(previousID, true);
+    }
+
+    componentStore_.Add(id, ptrGameObject);
+    ptrGameObject->componentStore_ = &componentStore_;
+
+    gameObjects.InsertAt(id, std::move(gameObject));
+
+    changeJournal_.RecordSpawn(id, ptrGameObject->GetTypeID(), fromNetwork);
+
+    return ptrGameObject;
+}
+
+GameObject* GameState::GetGameObject(uint32_t id) {
+    // array index + generation check. stale ids end up as nullptr
+    std::unique_ptr<GameObject>* slot = gameObjects.Get(id);
+
+    if (slot != nullptr) {
+        return slot->get();  // Returns raw pointer without transferring ownership
+    }
+    return nullptr;
+}
+
+// Hierarchical Operations
+void GameState::SetParent(uint32_t childId, uint32_t parentId, bool fromNetwork) {
+    // to do 
+    
+    //if (!fromNetwork) {
+    //    // propagate update to server
+    //}
+
+    //GameObject* pChild = gameObjects[childId].get();
+    //GameObject* pParent = gameObjects[parentId].get();
+
+    //pChild->SetParent(pParent);
+    //pParent->AddChild(pChild);
+}
+
+// Version 1: Safer map access and cleaner dynamic_cast
+void GameState::UpdateGameObjectPosition(uint32_t id, int y, int x, bool fromNetwork) { 
+    // to do 
+    //if (!fromNetwork) {
+    //    // propagate update to server
+    //}
+
+    //auto it = gameObjects.find(id);
+    //if (it != gameObjects.end()) {
+    //    if (auto* gridObject = dynamic_cast<GameObjectOnGrid*>(it->second.get())) {
+    //        gridObject->SetCoordinates(y, x);
+    //    }
+    //}
+}
+
+std::vector<GameObject*> GameState::GetObjectsByType(uint8_t typeId) {
+    std::vector<GameObject*> objects;
+
+    // Find all objects with the given typeId in the objectsByType map
+    auto range = objectsByType.equal_range(typeId);
+    for (auto it = range.first; it != range.second; ++it) {
+        // Get the GameObject pointer from the gameObjects map
+        GameObject* gameObject = GetGameObject(it->second);
+        if (gameObject != nullptr) {
+            objects.push_back(gameObject);
+        }
+    }
+
+    return objects;
+} 
+
+bool GameState::IsValidGameObject(uint32_t id) const {
+    const std::unique_ptr<GameObject>* slot = gameObjects.Get(id);
+
+    // a reserved id has no object yet
+    return slot != nullptr && *slot != nullptr;
+}
+
+// BroadCast from Server  
+void GameState::RegisterAndBroadcastNewGameObject(GameObject* newGameObject) {
+    uint32_t newID = GenerateNewGameObjectId(); 
+
+    // turn raw pointer unique  
+    std::unique_ptr<GameObject> pGameObject(newGameObject);
+    // set ID of gameObject 
+    newGameObject->SetID(newID);
+    // the spawn is journaled and broadcast at the end of the tick
+    InsertGameObject(newID, std::move(pGameObject), false);
+    // to do: add to objects by type. This is not currently possible. 
+}
+
+void GameState::BroadcastGameObjectSpawn(uint8_t typeID, uint32_t id) {
+    // Create Message 
+    INetworkMessage* curMessage = new AddGameObjectMessage(typeID, id);
+
+    // Broadcast message through server  
+    server->broadcast_message(curMessage);
+
+    // Message is turned into data and sent through the server it is safe to delete 
+    delete curMessage;
+}
+
+void GameState::BroadcastGameObjectRemoval(uint32_t id) {
+    INetworkMessage* curMessage = new RemoveGameObjectMessage(id);
+
+    server->broadcast_message(curMessage);
+
+    delete curMessage;
+}
+
+// GameObjects don't set 
+//void GameState::BroadcastGameObjectPosition(GameObject* gameObject) {
+//    if (auto gridObject = dynamic_cast<GameObjectOnGrid*>(gameObject)) {
+//        INetworkMessage* curMessage = new GameObjectPositionMessage(
+//            gridObject->yCoord,
+//            gridObject->xCoord,
+//            gridObject->GetID()
+//        );
+//
+//        server->broadcast_message(curMessage);
+//
+//        delete curMessage;
+//    }
+//    else {
+//        // this gameObject has no position
+//    }
+//}
+
+void GameState::BroadcastGameObjectParenting(uint32_t parentID, uint32_t objID) {
+    INetworkMessage* curMessage = new GameObjectParentObjectMessage(parentID, objID);
+
+    server->broadcast_message(curMessage);
+
+    delete curMessage;
+}
+
+void GameState::BroadcastPortal(uint32_t ridableID, int yCoord, int xCoord, uint32_t toRidableID, int toY, int toX, uint8_t rotation) {
+    INetworkMessage* curMessage = new PortalMessage(ridableID, static_cast<uint16_t>(yCoord), static_cast<uint16_t>(xCoord),
+        toRidableID, static_cast<uint16_t>(toY), static_cast<uint16_t>(toX), rotation);
+
+    server->broadcast_message(curMessage);
+
+    delete curMessage;
+}
+
+std::unique_ptr<INetworkMessage> GameState::CaptureGameState() {
+
+    // to do : create a child class of INetworkMessages that has all the infromation of current state of the game. 
+    return std::move(std::unique_ptr<INetworkMessage>(new PlayerInputMessage()));
+}
+
+// send from client 
+
+void GameState::SendPlayerInput(Direction direction) {
+    uint32_t playerID = 0;
+
+    INetworkMessage* curMessage = new PlayerInputMessage(
+        direction, playerID
+    );
+
+    client->send_message(curMessage, true);
+
+    delete curMessage;
+}
+
+// We don't set parents this way
+//// Hierarchical Operations
+//void GameState::SetParent(uint32_t childId, uint32_t parentId, bool fromNetwork) {
+//    if (!fromNetwork) {
+//        // propagate update to server
+//    }
+//
+//    GameObject* pChild = gameObjects[childId].get();
+//    GameObject* pParent = gameObjects[parentId].get();
+//
+//    pChild->SetParent(pParent);
+//    pParent->AddChild(pChild);
+//}
+
+// No more Object On Grid
+//// Version 1: Safer map access and cleaner dynamic_cast
+//void GameState::UpdateGameObjectPosition(uint32_t id, int y, int x, bool fromNetwork) {
+//    if (!fromNetwork) {
+//        // propagate update to server
+//    }
+//
+//    auto it = gameObjects.find(id);
+//    if (it != gameObjects.end()) {
+//        if (auto* gridObject = dynamic_cast<GameObjectOnGrid*>(it->second.get())) {
+//            gridObject->SetCoordinates(y, x);
+//        }
+//    }
+//}
+
+void GameState::PlayerTakeAction(uint32_t playerId, Direction input, bool fromNetwork) {
+    if (!fromNetwork) {
+        // propagate update to server
+    }
+    
+    auto it = players.find(playerId);  
+
+    if (it == players.end()) {
+        log(LOG_INFO, "Player id: " + std::to_string(playerId) + " is invalid");  
+    }
+    else {
+        // take action
+        log(LOG_INFO, "Player id: " + std::to_string(playerId) + " taking action : " + direction2String[input]);
+        players[playerId]->TakeAction(input);
+        return;
+    }
+
+}
+
+// No more Factory Component objects 
+//FactoryComponentObject* GameState::GetStructureAtCoord(int y, int x)
+//{
+//    uint32_t id = structureGrid[y * gridWidth + x];
+//    
+//    return dynamic_cast<FactoryComponentObject*>(gameObjects[id].get());
+//}
+
+GroundType GameState::GetGroundTypeAtCoord(int y, int x)
+{
+    return groundTypeGrid.Get(static_cast<uint32_t>(y), static_cast<uint32_t>(x));
+}
+
+// No More Dropped Item
+//DroppedItemObject* GameState::GetDroppedItemAtCoord(int y, int x)
+//{
+//    uint32_t id = structureGrid[y * gridWidth + x];
+//
+//    return dynamic_cast<DroppedItemObject*>(gameObjects[id].get());
+//}
+
+void GameState::DropItemAt(int y, int x, Item* item)
+{
+    // Publish Creation of new dropped Item.  
+
+    // Publish position change of (y, x) 
+
+    // Pushlish parent-child relation of droppedItem-item
+}
+
+void GameState::ExecuteCommands() {
+    commands_.Execute(*this);
+}
+
+void GameState::DrawGameState()
+{
+    ExecuteCommands();
+
+    // the client has no UpdateGameState, its tick ends here
+    PublishChanges();
+    PublishRenderView();
+}
+
+SubWorldStreamer* GameState::EnableSubWorldStreaming(uint8_t subscribeDistance) {
+    if (!isServerSide || server == nullptr) {
+        log(LOG_ERROR, "Only the server streams sub worlds");
+        return nullptr;
+    }
+    if (streamer_) {
+        return streamer_.get();
+    }
+
+    streamer_ = std::make_unique<SubWorldStreamer>(*this, [this](uint32_t clientID, const INetworkMessage& message) {
+        this->server->send_reliable_message_to_client(clientID, &message);
+        }, subscribeDistance);
+
+    log(LOG_INFO, "Streaming sub worlds, subscribe distance " + std::to_string(subscribeDistance));
+    return streamer_.get();
+}
+
+Pathfinder* GameState::GetPathfinder() {
+    if (!pathfinder_) {
+        pathfinder_ = std::make_unique<Pathfinder>(*this);
+    }
+    return pathfinder_.get();
+}
+
+void GameState::CastRays(std::vector<RayQuery>& queries) {
+    // read only, every thread looks the grids up itself
+    auto castRays = [this, &queries](size_t begin, size_t end, size_t) {
+        uint32_t lastID = ObjectHandle::NONE;
+        RidableObject* ridable = nullptr;
+
+        for (size_t i = begin; i < end; i++) {
+            RayQuery& query = queries[i];
+
+            // perception queries come grouped by grid more often than not
+            if (query.ridableID != lastID) {
+                const std::unique_ptr<GameObject>* gameObject = gameObjects.Get(query.ridableID);
+                ridable = gameObject != nullptr ? dynamic_cast<RidableObject*>(gameObject->get()) : nullptr;
+                lastID = query.ridableID;
+            }
+
+            if (ridable == nullptr) {
+                Ray& ray = query.ray;
+                ray.lastCell = ray.fromCell;
+                ray.hitCell = Ray::NO_HIT;
+                ray.hitObjectID = 0;
+                ray.isPortal = false;
+                ray.distance = 0;
+                ray.heading = ray.direction;
+                continue;
+            }
+
+            ridable->GetMovementManager()->CastRay(query.ray, ridable->GetGrid());
+        }
+    };
+
+    if (jobSystem_ != nullptr) {
+        jobSystem_->ParallelFor(queries.size(), RAYCAST_CHUNK_SIZE, castRays);
+    }
+    else {
+        castRays(0, queries.size(), 0);
+    }
+}
+
+LockstepController* GameState::EnableLockstep(uint32_t localPeerID, uint32_t localWalkerID) {
+    if (lockstep_) {
+        log(LOG_WARNING, "Already in lockstep");
+        return lockstep_.get();
+    }
+
+    // whatever is still pending belongs to the state every peer starts from
+    PublishChanges();
+
+    lockstep_ = std::make_unique<LockstepController>(*this, localPeerID, localWalkerID);
+    return lockstep_.get();
+}
+
+void GameState::PublishRenderView() {
+    RenderView& view = renderViews_.GetBackBuffer();
+    view.Clear();
+
+    view.tick = renderViewTick_++;
+
+    const ComponentStore& store = componentStore_;
+    size_t nObjects = store.Size();
+
+    view.objectIDs.assign(store.objectIDs.begin(), store.objectIDs.end());
+    view.localMatrices.assign(store.localMatrices.begin(), store.localMatrices.end());
+    view.meshIDs.assign(store.meshIDs.begin(), store.meshIDs.end());
+    view.textureIDs.assign(store.textureIDs.begin(), store.textureIDs.end());
+    view.parentIDs.assign(store.parentIDs.begin(), store.parentIDs.end());
+
+    if (view.rowOfSlot.size() < gameObjects.SlotCount()) {
+        view.rowOfSlot.resize(gameObjects.SlotCount(), RenderView::NO_ROW);
+    }
+
+    view.cellBegin.resize(nObjects);
+    view.cellCount.resize(nObjects);
+
+    for (size_t row = 0; row < nObjects; row++) {
+        view.rowOfSlot[ObjectHandle::IndexOf(store.objectIDs[row])] = static_cast<uint32_t>(row);
+
+        view.cellBegin[row] = static_cast<uint32_t>(view.cellObjectIDs.size());
+        view.cellCount[row] = 0;
+
+        RidableObject* ridable = dynamic_cast<RidableObject*>(store.owners[row]);
+        if (ridable == nullptr) {
+            continue;
+        }
+
+        // the occupied cells only, in cell order. the matrices are copied as they are, nullptr: a flat grid
+        const CellMatrix* matrices = ridable->GetGridTransformManager()->GetMatrices();
+
+        ridable->GetGrid().ForEach([&view, matrices](uint32_t cell, uint32_t occupantID) {
+            view.cellIndices.push_back(cell);
+            view.cellObjectIDs.push_back(occupantID);
+            view.cellMatrices.push_back(matrices != nullptr ? glm::make_mat4(matrices[cell].m) : glm::mat4(1));
+        });
+
+        view.cellCount[row] = static_cast<uint32_t>(view.cellObjectIDs.size()) - view.cellBegin[row];
+    }
+
+    renderViews_.Publish();
+}
+
+void GameState::SetJobSystem(JobSystem* jobSystem) {
+    jobSystem_ = jobSystem;
+
+    size_t nThreads = jobSystem_ ? jobSystem_->GetThreadCount() : 1;
+    deferredCommands_.clear();
+    deferredCommands_.resize(nThreads);
+}
+
+void GameState::UpdateGameState(float deltaTime) {
+    if (deferredCommands_.empty()) {
+        deferredCommands_.resize(1);
+    }
+
+    // what the network sent since the last tick, in the order it arrived
+    ExecuteCommands();
+
+    // same for everybody, build it once
+    glm::quat spin = glm::angleAxis(deltaTime, glm::normalize(glm::vec3(1, 1, 1)));
+
+    // systems walk the dense columns of the store instead of the hash map, one chunk of rows at a time. 
+    // the spin is what GameObject::Update(deltaTime) did to each object one at a time
+    auto updateRows = [this, deltaTime, &spin](size_t begin, size_t end, size_t threadIndex) {
+        DeferredCommandBuffer& deferred = deferredCommands_[threadIndex];
+
+        componentStore_.Spin(spin, begin, end);
+
+        for (size_t i = begin; i < end; i++) {
+            deferred.SetIssuer(componentStore_.objectIDs[i]);
+            componentStore_.owners[i]->Tick(deltaTime, deferred);
+        }
+
+        componentStore_.UpdateLocalMatrices(begin, end);
+    };
+
+    if (jobSystem_ != nullptr) {
+        jobSystem_->ParallelFor(componentStore_.Size(), UPDATE_CHUNK_SIZE, updateRows);
+    }
+    else {
+        updateRows(0, componentStore_.Size(), 0);
+    }
+
+    // sync point. everybody is done, now the cross object writes
+    DeferredCommandBuffer::Merge(deferredCommands_, *this);
+
+    PublishChanges();
+    PublishRenderView();
+
+    if (streamer_) {
+        streamer_->Update();
+    }
+
+    timeSinceSave_ += deltaTime;
+    if (isServerSide && changedSinceSave_ && timeSinceSave_ >= AUTOSAVE_INTERVAL && !snapshot_.IsSaving()) {
+        SaveSnapshot(SnapshotFormat::DEFAULT_PATH);
+    }
 }
\ No newline at end of file
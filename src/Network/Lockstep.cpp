@@ -0,0 +1,472 @@
+#include "Network/Lockstep.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "Network/GameState.h"
+#include "Network/NetworkMessage.h"
+#include "Network/Command.h"
+#include "Core/SlotMap.h"
+
+std::string DesyncReport::ToString() const {
+    std::stringstream ss;
+    ss << "Desync at tick " << tick << " with peer " << remotePeerID
+        << ": state hash " << std::hex << localHash << " (local) vs " << remoteHash << " (remote)" << std::dec;
+
+    if (objectID == ObjectHandle::NONE) {
+        ss << ", first differing object not known yet";
+    }
+    else {
+        ss << ", first differing object " << objectID
+            << " (slot " << ObjectHandle::IndexOf(objectID) << ", generation " << ObjectHandle::GenerationOf(objectID) << ")"
+            << std::hex << ": " << localObjectHash << " (local) vs " << remoteObjectHash << " (remote)" << std::dec;
+
+        if (localObjectHash == 0) {
+            ss << ", missing here";
+        }
+        else if (remoteObjectHash == 0) {
+            ss << ", missing there";
+        }
+    }
+
+    return ss.str();
+}
+
+std::string LockstepController::GetName() const { return "LockstepController"; }
+
+void LockstepController::log(LogLevel level, std::string text) {
+    LOG(level, GetName() + "::" + text);
+}
+
+LockstepController::LockstepController(GameState& gameState, uint32_t localPeerID, uint32_t localWalkerID)
+    : gameState_(gameState), localPeerID_(localPeerID), localWalkerID_(localWalkerID)
+{
+    AddPeer(localPeerID, localWalkerID, LockstepConfig::INPUT_DELAY);
+
+    hasher_.Attach(gameState);
+
+    log(LOG_INFO, "Peer " + std::to_string(localPeerID) + " walking " + std::to_string(localWalkerID) + ", hash " + std::to_string(hasher_.GetHash()));
+}
+
+bool LockstepController::AddPeer(uint32_t peerID, uint32_t walkerID, uint64_t firstTick) {
+    if (isStarted_) {
+        log(LOG_WARNING, "Peer " + std::to_string(peerID) + " turned away, the match already started");
+        return false;
+    }
+
+    // the first entry wins, the host's table doesn't change under a peer
+    if (peers_.emplace(peerID, Peer{ walkerID, firstTick }).second) {
+        log(LOG_INFO, "Peer " + std::to_string(peerID) + " walking " + std::to_string(walkerID) + " from tick " + std::to_string(firstTick));
+    }
+    return true;
+}
+
+void LockstepController::Start() {
+    if (isStarted_) {
+        return;
+    }
+    isStarted_ = true;
+
+    log(LOG_INFO, "Match started with " + std::to_string(peers_.size()) + " peers");
+
+    if (gameState_.isServerSide) {
+        SendPeers();
+    }
+}
+
+void LockstepController::SetLocalInput(Direction direction) {
+    pendingInput_ = direction;
+}
+
+void LockstepController::Advance(float deltaTime) {
+    if (!isStarted_ || isDesynced_) {
+        return;
+    }
+
+    accumulator_ += deltaTime;
+
+    int ticks = 0;
+    while (accumulator_ >= LockstepConfig::TICK_DURATION && ticks < LockstepConfig::MAX_TICKS_PER_ADVANCE) {
+        if (!IsTickReady(tick_)) {
+            // waiting for somebody. repeat ours in case they are waiting for us, and the table in case they never got it
+            SendLocalInputs();
+            if (gameState_.isServerSide) {
+                SendPeers();
+            }
+
+            // don't pile up time while stalled, it would come out as a burst of ticks later
+            accumulator_ = LockstepConfig::TICK_DURATION;
+            return;
+        }
+
+        Step();
+        accumulator_ -= LockstepConfig::TICK_DURATION;
+        ticks++;
+    }
+
+    if (ticks == LockstepConfig::MAX_TICKS_PER_ADVANCE) {
+        accumulator_ = std::min(accumulator_, LockstepConfig::TICK_DURATION);
+    }
+}
+
+bool LockstepController::IsTickReady(uint64_t tick) const {
+    auto it = inputs_.find(tick);
+
+    for (const auto& [peerID, peer] : peers_) {
+        // before its first tick nobody could have sampled an input in time
+        if (tick < peer.firstTick) {
+            continue;
+        }
+        if (it == inputs_.end() || it->second.find(peerID) == it->second.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LockstepController::Step() {
+    {
+        // every peer applies the same inputs itself, nothing of it is replicated
+        ChangeJournal::FromNetworkScope lockstepScope(gameState_.GetChangeJournal());
+
+        // peerID order, the same on every machine
+        for (const auto& [peerID, direction] : inputs_[tick_]) {
+            if (direction == Direction::IDLE) {
+                continue;
+            }
+
+            WalkOnRidableObjectCommand walk(peers_.at(peerID).walkerID, direction);
+            walk.Execute(gameState_);
+        }
+
+        gameState_.UpdateGameState(LockstepConfig::TICK_DURATION);
+    }
+
+    inputs_.erase(tick_);
+    tick_++;
+
+    // what is sampled now is applied INPUT_DELAY ticks later
+    ScheduleLocalInput(tick_ + LockstepConfig::INPUT_DELAY - 1);
+    SendLocalInputs();
+
+    if (tick_ % LockstepConfig::HASH_INTERVAL == 0) {
+        TakeCheckpoint();
+    }
+}
+
+void LockstepController::ScheduleLocalInput(uint64_t tick) {
+    Direction direction = pendingInput_;
+    pendingInput_ = Direction::IDLE;
+
+    inputs_[tick][localPeerID_] = direction;
+
+    recentLocalInputs_.push_back(direction);
+    if (recentLocalInputs_.size() > LockstepConfig::INPUT_REDUNDANCY) {
+        recentLocalInputs_.erase(recentLocalInputs_.begin());
+    }
+    newestLocalInputTick_ = tick;
+}
+
+void LockstepController::SendLocalInputs() {
+    LockstepInputMessage message;
+    message.peerID = localPeerID_;
+    message.walkerID = localWalkerID_;
+    message.newestTick = newestLocalInputTick_;
+    message.directions = recentLocalInputs_;
+
+    Send(message);
+}
+
+void LockstepController::ReceiveInputs(uint32_t peerID, uint32_t walkerID, uint64_t newestTick, const std::vector<Direction>& directions) {
+    if (peerID == localPeerID_) {
+        // our own, relayed back by the host
+        return;
+    }
+
+    auto peer = peers_.find(peerID);
+    if (peer == peers_.end()) {
+        log(LOG_WARNING, "Input of unknown peer " + std::to_string(peerID) + " dropped");
+        return;
+    }
+
+    // the walker is the table's. a peer that says otherwise is not relayed either
+    if (walkerID != peer->second.walkerID) {
+        log(LOG_WARNING, "Input of peer " + std::to_string(peerID) + " for walker " + std::to_string(walkerID) + " dropped, it walks " + std::to_string(peer->second.walkerID));
+        return;
+    }
+
+    if (directions.size() > newestTick + 1) {
+        log(LOG_WARNING, "Malformed input of peer " + std::to_string(peerID));
+        return;
+    }
+
+    if (gameState_.isServerSide) {
+        LockstepInputMessage relay;
+        relay.peerID = peerID;
+        relay.walkerID = walkerID;
+        relay.newestTick = newestTick;
+        relay.directions = directions;
+
+        Send(relay);
+    }
+
+    uint64_t firstTick = newestTick + 1 - directions.size();
+    for (size_t i = 0; i < directions.size(); i++) {
+        uint64_t tick = firstTick + i;
+
+        // already simulated (a repeat), or before the peer's first tick
+        if (tick < tick_ || tick < peer->second.firstTick) {
+            continue;
+        }
+
+        // the first copy wins, repeats carry the same input anyway
+        inputs_[tick].emplace(peerID, directions[i]);
+    }
+}
+
+void LockstepController::SendPeers() {
+    LockstepPeersMessage message;
+    for (const auto& [peerID, peer] : peers_) {
+        message.peerIDs.push_back(peerID);
+        message.walkerIDs.push_back(peer.walkerID);
+        message.firstTicks.push_back(peer.firstTick);
+    }
+
+    Send(message);
+}
+
+void LockstepController::ReceivePeers(const std::vector<uint32_t>& peerIDs, const std::vector<uint32_t>& walkerIDs, const std::vector<uint64_t>& firstTicks) {
+    if (gameState_.isServerSide) {
+        // nobody tells the host
+        return;
+    }
+
+    if (peerIDs.size() != walkerIDs.size() || peerIDs.size() != firstTicks.size()) {
+        log(LOG_WARNING, "Malformed peer table");
+        return;
+    }
+
+    // the host repeats the table, only new entries are news
+    for (size_t i = 0; i < peerIDs.size(); i++) {
+        if (peers_.find(peerIDs[i]) == peers_.end()) {
+            AddPeer(peerIDs[i], walkerIDs[i], firstTicks[i]);
+        }
+    }
+}
+
+void LockstepController::TakeCheckpoint() {
+    Checkpoint& checkpoint = checkpoints_[tick_];
+    checkpoint.hash = hasher_.Update();
+    checkpoint.manifest = hasher_.GetManifest();
+
+    while (checkpoints_.size() > LockstepConfig::CHECKPOINT_HISTORY) {
+        checkpoints_.erase(checkpoints_.begin());
+    }
+
+    StateHashMessage message;
+    message.peerID = localPeerID_;
+    message.tick = tick_;
+    message.hash = checkpoint.hash;
+    Send(message);
+
+    if (gameState_.isServerSide) {
+        SendPeers();
+    }
+
+    // peers that got here before us
+    auto pending = remoteHashes_.find(tick_);
+    if (pending != remoteHashes_.end()) {
+        for (const auto& [peerID, hash] : pending->second) {
+            CompareHash(peerID, tick_, hash);
+        }
+    }
+    remoteHashes_.erase(remoteHashes_.begin(), remoteHashes_.upper_bound(tick_));
+}
+
+void LockstepController::ReceiveHash(uint32_t peerID, uint64_t tick, uint64_t hash) {
+    if (peerID == localPeerID_) {
+        return;
+    }
+
+    if (gameState_.isServerSide) {
+        StateHashMessage relay;
+        relay.peerID = peerID;
+        relay.tick = tick;
+        relay.hash = hash;
+        Send(relay);
+    }
+
+    if (tick > tick_) {
+        // they are ahead, compared once we get there
+        remoteHashes_[tick][peerID] = hash;
+        return;
+    }
+
+    CompareHash(peerID, tick, hash);
+}
+
+void LockstepController::CompareHash(uint32_t peerID, uint64_t tick, uint64_t remoteHash) {
+    auto it = checkpoints_.find(tick);
+    if (it == checkpoints_.end()) {
+        log(LOG_WARNING, "Hash of peer " + std::to_string(peerID) + " for tick " + std::to_string(tick) + " arrived too late to compare");
+        return;
+    }
+
+    if (it->second.hash == remoteHash || isDesynced_) {
+        return;
+    }
+
+    isDesynced_ = true;
+
+    desyncReport_ = DesyncReport();
+    desyncReport_.tick = tick;
+    desyncReport_.remotePeerID = peerID;
+    desyncReport_.localHash = it->second.hash;
+    desyncReport_.remoteHash = remoteHash;
+    desyncReport_.objectID = ObjectHandle::NONE;
+
+    log(LOG_ERROR, desyncReport_.ToString());
+
+    // the other side compares them against its own and finds the object
+    SendManifest(tick);
+}
+
+void LockstepController::SendManifest(uint64_t tick) {
+    const std::vector<StateHasher::Entry>& manifest = checkpoints_[tick].manifest;
+
+    StateManifestMessage message;
+    message.peerID = localPeerID_;
+    message.tick = tick;
+    message.totalEntries = static_cast<uint32_t>(manifest.size());
+
+    for (size_t first = 0; first < manifest.size() || first == 0; first += LockstepConfig::MANIFEST_ENTRIES_PER_MESSAGE) {
+        size_t last = std::min(manifest.size(), first + LockstepConfig::MANIFEST_ENTRIES_PER_MESSAGE);
+
+        message.firstEntry = static_cast<uint32_t>(first);
+        message.objectIDs.clear();
+        message.objectHashes.clear();
+
+        for (size_t i = first; i < last; i++) {
+            message.objectIDs.push_back(manifest[i].objectID);
+            message.objectHashes.push_back(manifest[i].hash);
+        }
+
+        Send(message);
+
+        if (manifest.empty()) {
+            break;
+        }
+    }
+}
+
+void LockstepController::ReceiveManifest(uint32_t peerID, uint64_t tick, uint32_t firstEntry, uint32_t totalEntries,
+    const std::vector<uint32_t>& objectIDs, const std::vector<uint64_t>& objectHashes)
+{
+    if (peerID == localPeerID_) {
+        return;
+    }
+
+    if (gameState_.isServerSide) {
+        StateManifestMessage relay;
+        relay.peerID = peerID;
+        relay.tick = tick;
+        relay.firstEntry = firstEntry;
+        relay.totalEntries = totalEntries;
+        relay.objectIDs = objectIDs;
+        relay.objectHashes = objectHashes;
+        Send(relay);
+    }
+
+    auto it = checkpoints_.find(tick);
+    if (it == checkpoints_.end() || objectIDs.size() != objectHashes.size()) {
+        return;
+    }
+    const std::vector<StateHasher::Entry>& local = it->second.manifest;
+
+    // the ids this chunk is responsible for. the first chunk also covers everything below, the last everything above
+    bool isFirstChunk = firstEntry == 0;
+    bool isLastChunk = firstEntry + objectIDs.size() >= totalEntries;
+    uint32_t lowestID = (isFirstChunk || objectIDs.empty()) ? 0 : objectIDs.front();
+    uint32_t highestID = (isLastChunk || objectIDs.empty()) ? UINT32_MAX : objectIDs.back();
+
+    auto byID = [](const StateHasher::Entry& entry, uint32_t objectID) {
+        return entry.objectID < objectID;
+    };
+    auto localIt = std::lower_bound(local.begin(), local.end(), lowestID, byID);
+
+    // merge walk over both sorted lists, the first mismatch is the lowest differing id in this chunk
+    uint32_t differingID = ObjectHandle::NONE;
+    uint64_t localObjectHash = 0;
+    uint64_t remoteObjectHash = 0;
+
+    size_t remoteIndex = 0;
+    while ((localIt != local.end() && localIt->objectID <= highestID) || remoteIndex < objectIDs.size()) {
+        bool hasLocal = localIt != local.end() && localIt->objectID <= highestID;
+        bool hasRemote = remoteIndex < objectIDs.size();
+
+        if (hasLocal && hasRemote && localIt->objectID == objectIDs[remoteIndex]) {
+            if (localIt->hash != objectHashes[remoteIndex]) {
+                differingID = localIt->objectID;
+                localObjectHash = localIt->hash;
+                remoteObjectHash = objectHashes[remoteIndex];
+                break;
+            }
+            ++localIt;
+            remoteIndex++;
+        }
+        else if (hasLocal && (!hasRemote || localIt->objectID < objectIDs[remoteIndex])) {
+            // only here
+            differingID = localIt->objectID;
+            localObjectHash = localIt->hash;
+            break;
+        }
+        else {
+            // only there
+            differingID = objectIDs[remoteIndex];
+            remoteObjectHash = objectHashes[remoteIndex];
+            break;
+        }
+    }
+
+    if (differingID == ObjectHandle::NONE) {
+        return;
+    }
+
+    if (isDesynced_ && desyncReport_.tick != tick) {
+        // already stopped at another checkpoint
+        return;
+    }
+
+    // their hash message may have been lost, the manifest says enough
+    if (!isDesynced_) {
+        isDesynced_ = true;
+
+        desyncReport_ = DesyncReport();
+        desyncReport_.tick = tick;
+        desyncReport_.remotePeerID = peerID;
+        desyncReport_.localHash = it->second.hash;
+        desyncReport_.objectID = ObjectHandle::NONE;
+
+        SendManifest(tick);
+    }
+
+    // chunks arrive in any order, keep the lowest
+    if (desyncReport_.objectID != ObjectHandle::NONE && desyncReport_.objectID < differingID) {
+        return;
+    }
+
+    desyncReport_.objectID = differingID;
+    desyncReport_.localObjectHash = localObjectHash;
+    desyncReport_.remoteObjectHash = remoteObjectHash;
+
+    log(LOG_ERROR, desyncReport_.ToString());
+}
+
+void LockstepController::Send(INetworkMessage& message) {
+    if (gameState_.server != nullptr) {
+        gameState_.server->broadcast_message(&message);
+    }
+    else if (gameState_.client != nullptr) {
+        gameState_.client->send_message(&message, true);
+    }
+}
@@ -0,0 +1,381 @@
+#include "Network/Pathfinder.h"
+
+#include <algorithm>
+
+#include "Network/GameState.h"
+#include "Network/ChangeJournal.h"
+#include "Core/JobSystem.h"
+#include "Core/RidableObject.h"
+
+std::string Pathfinder::GetName() const { return "Pathfinder"; }
+
+void Pathfinder::log(LogLevel level, std::string text) {
+    LOG(level, GetName() + "::" + text);
+}
+
+Pathfinder::Pathfinder(GameState& gameState)
+    : gameState_(gameState) {
+    gameState.GetChangeJournal().Subscribe("Pathfinder::OnChanges", [this](const ChangeJournal& journal) {
+        this->OnChanges(journal);
+        });
+}
+
+Direction Pathfinder::NextStep(uint32_t ridableID, uint32_t fromCell, uint32_t targetCell, uint32_t* distance) {
+    if (distance != nullptr) {
+        *distance = UNREACHABLE;
+    }
+    queries_++;
+
+    RidableObject* ridable = nullptr;
+    Grid* grid = GetGrid(ridableID, ridable);
+    if (grid == nullptr || fromCell >= grid->cellCount) {
+        return Direction::IDLE;
+    }
+
+    bool needsBuild = false;
+    Field* field = GetField(*grid, targetCell, needsBuild);
+    if (field == nullptr) {
+        return Direction::IDLE;
+    }
+
+    if (needsBuild) {
+        if (queues_.empty()) {
+            queues_.resize(1);
+        }
+        BuildField(*grid, ridable->GetGrid(), targetCell, *field, queues_[0]);
+        field->version = grid->version;
+        fieldBuilds_++;
+    }
+
+    return StepDown(*grid, *field, fromCell, targetCell, distance);
+}
+
+Direction Pathfinder::NextStepAcross(uint32_t ridableID, uint32_t fromCell, uint32_t targetRidableID, uint32_t targetCell, uint32_t* distance) {
+    if (ridableID == targetRidableID) {
+        return NextStep(ridableID, fromCell, targetCell, distance);
+    }
+
+    if (!gameState_.GetPortalGraph().FindRoute(ridableID, targetRidableID, route_) || route_.empty()) {
+        if (distance != nullptr) {
+            *distance = UNREACHABLE;
+        }
+        return Direction::IDLE;
+    }
+
+    // only the first portal matters from here, the rest is for when we are through
+    return NextStep(ridableID, fromCell, route_.front().fromCell, distance);
+}
+
+bool Pathfinder::FindPath(uint32_t ridableID, uint32_t fromCell, uint32_t targetCell, std::vector<Direction>& path) {
+    path.clear();
+
+    uint32_t distance = UNREACHABLE;
+    Direction step = NextStep(ridableID, fromCell, targetCell, &distance);
+
+    if (fromCell == targetCell) {
+        return true;
+    }
+    if (step == Direction::IDLE) {
+        return false;
+    }
+
+    // NextStep just built what we need
+    const Grid& grid = grids_[ridableID];
+    const Field& field = grid.fields.at(targetCell);
+
+    uint32_t cell = fromCell;
+    path.reserve(distance);
+
+    while (cell != targetCell) {
+        step = StepDown(grid, field, cell, targetCell, nullptr);
+        if (step == Direction::IDLE) {
+            path.clear();
+            return false;
+        }
+
+        path.push_back(step);
+        cell = GetLink(grid, cell).neighbours[static_cast<int>(step)];
+    }
+
+    return true;
+}
+
+void Pathfinder::Solve(std::vector<Query>& queries) {
+    builds_.clear();
+    queryGrids_.assign(queries.size(), nullptr);
+    queryFields_.assign(queries.size(), nullptr);
+    queries_ += queries.size();
+
+    // the maps are only touched here, on the calling thread
+    for (size_t i = 0; i < queries.size(); i++) {
+        Query& query = queries[i];
+        query.next = Direction::IDLE;
+        query.distance = UNREACHABLE;
+
+        RidableObject* ridable = nullptr;
+        Grid* grid = GetGrid(query.ridableID, ridable);
+        if (grid == nullptr || query.fromCell >= grid->cellCount) {
+            continue;
+        }
+
+        bool needsBuild = false;
+        Field* field = GetField(*grid, query.targetCell, needsBuild);
+        if (field == nullptr) {
+            continue;
+        }
+
+        if (needsBuild) {
+            // marked current right away, the next query heading there doesn't queue it again
+            field->version = grid->version;
+            builds_.push_back({ grid, &ridable->GetGrid(), query.targetCell, field });
+        }
+
+        queryGrids_[i] = grid;
+        queryFields_[i] = field;
+    }
+
+    JobSystem* jobSystem = gameState_.GetJobSystem();
+    size_t nThreads = jobSystem != nullptr ? jobSystem->GetThreadCount() : 1;
+    if (queues_.size() < nThreads) {
+        queues_.resize(nThreads);
+    }
+
+    auto buildFields = [this](size_t begin, size_t end, size_t threadIndex) {
+        for (size_t i = begin; i < end; i++) {
+            const Build& build = builds_[i];
+            BuildField(*build.grid, *build.occupancy, build.target, *build.field, queues_[threadIndex]);
+        }
+    };
+
+    auto answerQueries = [this, &queries](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++) {
+            if (queryFields_[i] != nullptr) {
+                Query& query = queries[i];
+                query.next = StepDown(*queryGrids_[i], *queryFields_[i], query.fromCell, query.targetCell, &query.distance);
+            }
+        }
+    };
+
+    // fields are independent, one search per job
+    if (jobSystem != nullptr) {
+        jobSystem->ParallelFor(builds_.size(), 1, buildFields);
+        jobSystem->ParallelFor(queries.size(), PathfindingConfig::QUERY_CHUNK_SIZE, answerQueries);
+    }
+    else {
+        buildFields(0, builds_.size(), 0);
+        answerQueries(0, queries.size(), 0);
+    }
+
+    fieldBuilds_ += builds_.size();
+}
+
+void Pathfinder::Invalidate(uint32_t ridableID) {
+    grids_.erase(ridableID);
+}
+
+size_t Pathfinder::GetFieldCount() const {
+    size_t count = 0;
+    for (const auto& entry : grids_) {
+        count += entry.second.fields.size();
+    }
+    return count;
+}
+
+void Pathfinder::LogStats() {
+    log(LOG_INFO, "grids: " + std::to_string(grids_.size())
+        + ", fields: " + std::to_string(GetFieldCount())
+        + ", queries: " + std::to_string(queries_)
+        + ", field builds: " + std::to_string(fieldBuilds_));
+}
+
+Pathfinder::Grid* Pathfinder::GetGrid(uint32_t ridableID, RidableObject*& ridable) {
+    ridable = dynamic_cast<RidableObject*>(gameState_.GetGameObject(ridableID));
+    if (ridable == nullptr || ridable->GetMovementManager() == nullptr) {
+        return nullptr;
+    }
+
+    const MovementManager* movementManager = ridable->GetMovementManager();
+    if (movementManager->GetCellCount() == 0 || movementManager->GetCellCount() != ridable->GetGrid().GetCellCount()) {
+        return nullptr;
+    }
+
+    Grid& grid = grids_[ridableID];
+    grid.movement = movementManager;
+
+    if (grid.cellCount == 0 || grid.links != movementManager->GetLinks() || grid.cellCount != movementManager->GetCellCount()) {
+        grid.links = movementManager->GetLinks();
+        grid.cellCount = static_cast<uint32_t>(movementManager->GetCellCount());
+        grid.fields.clear();
+        grid.version++;
+
+        // a plain torus works its links out on the fly, so does the search. nothing per cell but the fields
+        if (grid.links != nullptr) {
+            BuildPredecessors(grid);
+        }
+        else {
+            grid.predecessorStart.clear();
+            grid.predecessorStart.shrink_to_fit();
+            grid.predecessors.clear();
+            grid.predecessors.shrink_to_fit();
+        }
+
+        grid.portalCells.clear();
+        for (const Portal& portal : gameState_.GetPortalGraph().From(ridableID)) {
+            grid.portalCells.push_back(portal.fromCell);
+        }
+    }
+
+    return &grid;
+}
+
+Pathfinder::Field* Pathfinder::GetField(Grid& grid, uint32_t target, bool& needsBuild) {
+    if (target >= grid.cellCount) {
+        needsBuild = false;
+        return nullptr;
+    }
+
+    Field& field = grid.fields[target];
+    field.isUsed = true;
+
+    needsBuild = field.version != grid.version;
+    return &field;
+}
+
+void Pathfinder::BuildPredecessors(Grid& grid) {
+    // counting sort of the links by where they lead
+    grid.predecessorStart.assign(grid.cellCount + 1, 0);
+
+    for (uint32_t cell = 0; cell < grid.cellCount; cell++) {
+        for (int d = 0; d < 4; d++) {
+            grid.predecessorStart[grid.links[cell].neighbours[d] + 1]++;
+        }
+    }
+    for (uint32_t cell = 0; cell < grid.cellCount; cell++) {
+        grid.predecessorStart[cell + 1] += grid.predecessorStart[cell];
+    }
+
+    grid.predecessors.resize(static_cast<size_t>(grid.cellCount) * 4);
+
+    std::vector<uint32_t> next(grid.predecessorStart.begin(), grid.predecessorStart.end() - 1);
+    for (uint32_t cell = 0; cell < grid.cellCount; cell++) {
+        for (int d = 0; d < 4; d++) {
+            grid.predecessors[next[grid.links[cell].neighbours[d]]++] = cell;
+        }
+    }
+}
+
+CellLink Pathfinder::GetLink(const Grid& grid, uint32_t cell) {
+    return grid.links != nullptr ? grid.links[cell] : grid.movement->GetLink(cell);
+}
+
+void Pathfinder::BuildField(const Grid& grid, const ChunkedGrid<uint32_t>& occupancy, uint32_t target, Field& field, std::vector<uint32_t>& queue) {
+    field.distance.assign(grid.cellCount, UNREACHABLE);
+
+    // portals look taken while searching, and unreachable afterwards
+    for (uint32_t cell : grid.portalCells) {
+        field.distance[cell] = 0;
+    }
+    field.distance[target] = 0;
+
+    queue.clear();
+    queue.push_back(target);
+
+    // the queue is never popped, head walks along it
+    for (size_t head = 0; head < queue.size(); head++) {
+        uint32_t cell = queue[head];
+        uint32_t nextDistance = field.distance[cell] + 1;
+
+        auto visit = [&](uint32_t predecessor) {
+            // somebody stands there, nobody walks through
+            if (field.distance[predecessor] != UNREACHABLE || occupancy.Get(predecessor) != 0) {
+                return;
+            }
+
+            field.distance[predecessor] = nextDistance;
+            queue.push_back(predecessor);
+        };
+
+        if (grid.links == nullptr) {
+            CellLink link = GetLink(grid, cell);
+            for (int d = 0; d < 4; d++) {
+                visit(link.neighbours[d]);
+            }
+            continue;
+        }
+
+        for (uint32_t i = grid.predecessorStart[cell]; i < grid.predecessorStart[cell + 1]; i++) {
+            visit(grid.predecessors[i]);
+        }
+    }
+
+    for (uint32_t cell : grid.portalCells) {
+        if (cell != target) {
+            field.distance[cell] = UNREACHABLE;
+        }
+    }
+}
+
+Direction Pathfinder::StepDown(const Grid& grid, const Field& field, uint32_t fromCell, uint32_t targetCell, uint32_t* distance) {
+    if (fromCell == targetCell) {
+        if (distance != nullptr) {
+            *distance = 0;
+        }
+        return Direction::IDLE;
+    }
+
+    // ties go to the lowest direction, every peer picks the same step
+    Direction best = Direction::IDLE;
+    uint32_t bestDistance = UNREACHABLE;
+
+    CellLink link = GetLink(grid, fromCell);
+    for (int d = 0; d < 4; d++) {
+        uint32_t neighbourDistance = field.distance[link.neighbours[d]];
+        if (neighbourDistance < bestDistance) {
+            bestDistance = neighbourDistance;
+            best = static_cast<Direction>(d);
+        }
+    }
+
+    if (distance != nullptr) {
+        *distance = bestDistance == UNREACHABLE ? UNREACHABLE : bestDistance + 1;
+    }
+    return best;
+}
+
+void Pathfinder::OnChanges(const ChangeJournal& journal) {
+    for (const ChangeRecord& record : journal.GetRecords()) {
+        switch (record.type) {
+        case ChangeType::GRID_SLOT: {
+            auto it = grids_.find(record.objectID);
+            if (it == grids_.end()) {
+                break;
+            }
+
+            Grid& grid = it->second;
+            // once per grid and tick, however many moved on it
+            if (grid.changedTick == journal.GetTick()) {
+                break;
+            }
+            grid.changedTick = journal.GetTick();
+            grid.version++;
+
+            // nobody asked for these since the last change, they go. the others are rebuilt when asked again
+            for (auto field = grid.fields.begin(); field != grid.fields.end();) {
+                if (!field->second.isUsed) {
+                    field = grid.fields.erase(field);
+                }
+                else {
+                    field->second.isUsed = false;
+                    ++field;
+                }
+            }
+            break;
+        }
+        case ChangeType::REMOVE:
+            grids_.erase(record.objectID);
+            break;
+        default:
+            break;
+        }
+    }
+}
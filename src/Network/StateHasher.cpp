@@ -0,0 +1,144 @@
+#include "Network/StateHasher.h"
+
+#include <algorithm>
+
+#include "Network/GameState.h"
+#include "Network/ChangeJournal.h"
+#include "Core/RidableObject.h"
+#include "Core/SlotMap.h"
+
+namespace {
+    // splitmix64 finalizer. cheap, and one flipped input bit flips about half of the output
+    uint64_t Mix(uint64_t hash, uint64_t value) {
+        uint64_t x = hash ^ (value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2));
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+}
+
+std::string StateHasher::GetName() const { return "StateHasher"; }
+
+void StateHasher::log(LogLevel level, std::string text) {
+    LOG(level, GetName() + "::" + text);
+}
+
+void StateHasher::Attach(GameState& gameState) {
+    gameState_ = &gameState;
+
+    stateHash_ = 0;
+    objectHashes_.clear();
+    objectIDs_.clear();
+    dirtyIDs_.clear();
+
+    // everything there is right now, from then on only what the journal reports
+    const std::vector<uint32_t>& objectIDs = gameState.GetComponentStore().objectIDs;
+    dirtyIDs_.assign(objectIDs.begin(), objectIDs.end());
+    Update();
+
+    gameState.GetChangeJournal().Subscribe("StateHasher::MarkDirty", [this](const ChangeJournal& journal) {
+        this->MarkDirty(journal);
+        });
+
+    log(LOG_INFO, "Attached, " + std::to_string(objectIDs.size()) + " objects hashed");
+}
+
+uint64_t StateHasher::Update() {
+    if (dirtyIDs_.empty()) {
+        return stateHash_;
+    }
+
+    std::sort(dirtyIDs_.begin(), dirtyIDs_.end());
+    dirtyIDs_.erase(std::unique(dirtyIDs_.begin(), dirtyIDs_.end()), dirtyIDs_.end());
+
+    for (uint32_t objectID : dirtyIDs_) {
+        Rehash(objectID);
+    }
+    dirtyIDs_.clear();
+
+    return stateHash_;
+}
+
+std::vector<StateHasher::Entry> StateHasher::GetManifest() const {
+    std::vector<Entry> manifest;
+
+    for (size_t slot = 0; slot < objectIDs_.size(); slot++) {
+        if (objectIDs_[slot] != ObjectHandle::NONE) {
+            manifest.push_back({ objectIDs_[slot], objectHashes_[slot] });
+        }
+    }
+
+    std::sort(manifest.begin(), manifest.end(), [](const Entry& a, const Entry& b) {
+        return a.objectID < b.objectID;
+        });
+
+    return manifest;
+}
+
+uint64_t StateHasher::HashObject(GameState& gameState, uint32_t objectID) {
+    GameObject* gameObject = gameState.GetGameObject(objectID);
+    if (gameObject == nullptr) {
+        return 0;
+    }
+
+    uint64_t hash = Mix(0, objectID);
+    hash = Mix(hash, gameObject->GetTypeID());
+    hash = Mix(hash, gameObject->GetParentID());
+
+    RidableObject* ridable = dynamic_cast<RidableObject*>(gameObject);
+    if (ridable != nullptr) {
+        hash = Mix(hash, (static_cast<uint64_t>(ridable->GetGridHeight()) << 16) | ridable->GetGridWidth());
+
+        // the occupied cells in cell order, where they are counts as much as who
+        ridable->GetGrid().ForEach([&hash](uint32_t cell, uint32_t occupantID) {
+            hash = Mix(hash, (static_cast<uint64_t>(cell) << 32) | occupantID);
+        });
+    }
+
+    return hash;
+}
+
+void StateHasher::MarkDirty(const ChangeJournal& journal) {
+    for (const ChangeRecord& record : journal.GetRecords()) {
+        switch (record.type) {
+        case ChangeType::SPAWN:
+        case ChangeType::REMOVE:
+        case ChangeType::REPARENT:
+        case ChangeType::GRID_SLOT:
+            // a grid slot only changes the hash of the grid's owner, occupants don't hash where they stand
+            dirtyIDs_.push_back(record.objectID);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void StateHasher::Rehash(uint32_t objectID) {
+    uint32_t slot = ObjectHandle::IndexOf(objectID);
+
+    if (slot >= objectHashes_.size()) {
+        objectHashes_.resize(slot + 1, 0);
+        objectIDs_.resize(slot + 1, ObjectHandle::NONE);
+    }
+
+    bool isAlive = gameState_->IsValidGameObject(objectID);
+
+    // removed, and the slot was already taken over by the next generation
+    if (!isAlive && objectIDs_[slot] != objectID) {
+        return;
+    }
+
+    stateHash_ -= objectHashes_[slot];
+
+    if (isAlive) {
+        objectHashes_[slot] = HashObject(*gameState_, objectID);
+        objectIDs_[slot] = objectID;
+    }
+    else {
+        objectHashes_[slot] = 0;
+        objectIDs_[slot] = ObjectHandle::NONE;
+    }
+
+    stateHash_ += objectHashes_[slot];
+}
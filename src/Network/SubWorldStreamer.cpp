@@ -0,0 +1,342 @@
+#include "Network/SubWorldStreamer.h"
+
+#include <algorithm>
+
+#include "Network/GameState.h"
+#include "Network/NetworkMessage.h"
+#include "Network/ChangeJournal.h"
+#include "Core/RidableObject.h"
+#include "Core/ComponentStore.h"
+
+namespace {
+    // a - b, sorted. the order messages go out in doesn't depend on hashing
+    void SortedDifference(const std::unordered_set<uint32_t>& a, const std::unordered_set<uint32_t>& b, std::vector<uint32_t>& out) {
+        out.clear();
+        for (uint32_t id : a) {
+            if (b.count(id) == 0) {
+                out.push_back(id);
+            }
+        }
+        std::sort(out.begin(), out.end());
+    }
+}
+
+std::string SubWorldStreamer::GetName() const { return "SubWorldStreamer"; }
+
+void SubWorldStreamer::log(LogLevel level, std::string text) {
+    LOG(level, GetName() + "::" + text);
+}
+
+SubWorldStreamer::SubWorldStreamer(GameState& gameState, SendFunction send, uint8_t subscribeDistance)
+    : gameState_(gameState), send_(std::move(send)), subscribeDistance_(subscribeDistance)
+{
+    gameState_.GetChangeJournal().Subscribe("SubWorldStreamer::Replicate", [this](const ChangeJournal& journal) {
+        this->Replicate(journal);
+        });
+}
+
+SubWorldStreamer::~SubWorldStreamer() {
+    log(LOG_INFO, "Sent " + std::to_string(sentShells_) + " shells, " + std::to_string(sentSlots_) + " grid slots, "
+        + std::to_string(releases_) + " releases");
+}
+
+void SubWorldStreamer::AddClient(uint32_t clientID, uint32_t focusID) {
+    Client& client = clients_[clientID];
+    client.focusID = focusID;
+    client.isDirty = true;
+
+    log(LOG_INFO, "Client " + std::to_string(clientID) + " streams around " + std::to_string(focusID));
+}
+
+void SubWorldStreamer::RemoveClient(uint32_t clientID) {
+    clients_.erase(clientID);
+}
+
+void SubWorldStreamer::SetFocus(uint32_t clientID, uint32_t focusID) {
+    auto it = clients_.find(clientID);
+    if (it == clients_.end()) {
+        log(LOG_WARNING, "SetFocus, unknown client " + std::to_string(clientID));
+        return;
+    }
+
+    if (it->second.focusID != focusID) {
+        it->second.focusID = focusID;
+        it->second.isDirty = true;
+    }
+}
+
+void SubWorldStreamer::Update() {
+    for (auto& entry : clients_) {
+        if (entry.second.isDirty) {
+            Refresh(entry.first, entry.second);
+        }
+    }
+}
+
+bool SubWorldStreamer::IsSubscribed(uint32_t clientID, uint32_t ridableID) const {
+    auto it = clients_.find(clientID);
+    return it != clients_.end() && it->second.subscribed.count(ridableID) != 0;
+}
+
+size_t SubWorldStreamer::GetKnownCount(uint32_t clientID) const {
+    auto it = clients_.find(clientID);
+    return it != clients_.end() ? it->second.known.size() : 0;
+}
+
+void SubWorldStreamer::Replicate(const ChangeJournal& journal) {
+    for (const ChangeRecord& record : journal.GetRecords()) {
+        switch (record.type) {
+        case ChangeType::GRID_SLOT:
+            for (auto& entry : clients_) {
+                Client& client = entry.second;
+
+                // the focus stepping onto a grid (or off one) moves where the walk starts
+                if (client.reached.count(record.objectID) != 0 || client.reached.count(record.other) != 0 || record.other == client.focusID) {
+                    client.isDirty = true;
+                }
+                if (client.subscribed.count(record.objectID) != 0) {
+                    SendSlot(entry.first, client, record.objectID, record.cell, record.other);
+                }
+            }
+            break;
+        case ChangeType::REMOVE:
+            for (auto& entry : clients_) {
+                Client& client = entry.second;
+
+                if (client.known.erase(record.objectID) != 0) {
+                    RemoveGameObjectMessage message(record.objectID);
+                    send_(entry.first, message);
+                }
+                client.subscribed.erase(record.objectID);
+
+                if (client.reached.count(record.objectID) != 0) {
+                    client.isDirty = true;
+                }
+            }
+            break;
+        default:
+            // spawns show up once they stand on a subscribed grid.
+            // reparenting is the exit cell of the child's grid, a grid slot as well
+            break;
+        }
+    }
+}
+
+void SubWorldStreamer::OnPortalChanged(uint32_t ridableID, uint32_t toRidableID) {
+    for (auto& entry : clients_) {
+        Client& client = entry.second;
+
+        if (client.reached.count(ridableID) != 0 || client.reached.count(toRidableID) != 0) {
+            client.isDirty = true;
+        }
+    }
+}
+
+void SubWorldStreamer::Walk(uint32_t focusID, uint8_t maxDistance) {
+    distance_.clear();
+    frontier_.clear();
+
+    if (!gameState_.IsValidGameObject(focusID)) {
+        return;
+    }
+
+    distance_[focusID] = 0;
+    frontier_.push_back(focusID);
+
+    for (uint8_t distance = 0; distance < maxDistance && !frontier_.empty(); distance++) {
+        nextFrontier_.clear();
+
+        auto visit = [this, distance](uint32_t objectID) {
+            if (objectID == 0 || distance_.count(objectID) != 0 || !gameState_.IsValidGameObject(objectID)) {
+                return;
+            }
+            distance_[objectID] = distance + 1;
+            nextFrontier_.push_back(objectID);
+        };
+
+        for (uint32_t objectID : frontier_) {
+            GameObject* gameObject = gameState_.GetGameObject(objectID);
+
+            visit(gameObject->GetParentID());
+
+            RidableObject* ridable = dynamic_cast<RidableObject*>(gameObject);
+            if (ridable != nullptr) {
+                ridable->GetGrid().ForEach([&visit](uint32_t, uint32_t occupantID) {
+                    visit(occupantID);
+                });
+
+                // whatever is on the other side of a portal is as close as a neighbour
+                for (const Portal& portal : gameState_.GetPortalGraph().From(objectID)) {
+                    visit(portal.toGridID);
+                }
+            }
+        }
+
+        frontier_.swap(nextFrontier_);
+    }
+}
+
+uint32_t SubWorldStreamer::FindWalkStart(const Client& client) const {
+    GameObject* focus = gameState_.GetGameObject(client.focusID);
+    if (focus == nullptr) {
+        return 0;
+    }
+    if (focus->GetParentID() != 0 || dynamic_cast<PlayableObject*>(focus) == nullptr) {
+        return client.focusID;
+    }
+
+    // a player that stands nowhere yet, the world around the root until it steps onto something
+    ComponentStore& store = gameState_.GetComponentStore();
+
+    uint32_t rootID = 0;
+    for (size_t i = 0; i < store.Size(); i++) {
+        RidableObject* ridable = dynamic_cast<RidableObject*>(store.owners[i]);
+
+        if (ridable != nullptr && dynamic_cast<PlayableObject*>(ridable) == nullptr && ridable->GetParentID() == 0
+            && (rootID == 0 || store.objectIDs[i] < rootID)) {
+            rootID = store.objectIDs[i];
+        }
+    }
+    return rootID;
+}
+
+void SubWorldStreamer::Refresh(uint32_t clientID, Client& client) {
+    uint8_t releaseDistance = subscribeDistance_ + StreamingConfig::RELEASE_MARGIN;
+    Walk(FindWalkStart(client), releaseDistance);
+
+    std::unordered_set<uint32_t> subscribed;
+    std::unordered_set<uint32_t> known;
+
+    for (const auto& entry : distance_) {
+        if (dynamic_cast<RidableObject*>(gameState_.GetGameObject(entry.first)) == nullptr) {
+            continue;
+        }
+
+        bool isClose = entry.second <= subscribeDistance_;
+        bool isKept = entry.second <= releaseDistance && client.subscribed.count(entry.first) != 0;
+
+        if (isClose || isKept) {
+            subscribed.insert(entry.first);
+        }
+    }
+
+    if (gameState_.IsValidGameObject(client.focusID)) {
+        known.insert(client.focusID);
+    }
+    for (uint32_t ridableID : subscribed) {
+        known.insert(ridableID);
+
+        RidableObject* ridable = dynamic_cast<RidableObject*>(gameState_.GetGameObject(ridableID));
+        ridable->GetGrid().ForEach([this, &known](uint32_t, uint32_t occupantID) {
+            if (gameState_.IsValidGameObject(occupantID)) {
+                known.insert(occupantID);
+            }
+        });
+    }
+
+    // left behind. the grid first, then whoever the client only knew from there
+    SortedDifference(client.subscribed, subscribed, sorted_);
+    for (uint32_t ridableID : sorted_) {
+        SubWorldReleaseMessage message;
+        message.ownerID = ridableID;
+        send_(clientID, message);
+        releases_++;
+    }
+
+    SortedDifference(client.known, known, sorted_);
+    for (uint32_t objectID : sorted_) {
+        RemoveGameObjectMessage message(objectID);
+        send_(clientID, message);
+    }
+
+    // new. everybody has to exist on the client before a grid can point at them
+    SortedDifference(known, client.known, sorted_);
+    for (uint32_t objectID : sorted_) {
+        SendShell(clientID, objectID);
+    }
+
+    std::vector<uint32_t> newlySubscribed;
+    SortedDifference(subscribed, client.subscribed, newlySubscribed);
+
+    client.subscribed = std::move(subscribed);
+    client.known = std::move(known);
+
+    for (uint32_t ridableID : newlySubscribed) {
+        SendGrid(clientID, client, ridableID);
+    }
+
+    client.reached.clear();
+    for (const auto& entry : distance_) {
+        client.reached.insert(entry.first);
+    }
+    client.isDirty = false;
+}
+
+void SubWorldStreamer::SendShell(uint32_t clientID, uint32_t objectID) {
+    GameObject* gameObject = gameState_.GetGameObject(objectID);
+    if (gameObject == nullptr) {
+        return;
+    }
+
+    RidableObject* ridable = dynamic_cast<RidableObject*>(gameObject);
+    if (ridable != nullptr) {
+        ComponentStore& store = gameState_.GetComponentStore();
+        ComponentStore::Index index = store.IndexOf(objectID);
+
+        AddRidableObjectMessage message;
+        message.objID_ = objectID;
+        message.meshID_ = store.meshIDs[index];
+        message.textureID_ = store.textureIDs[index];
+
+        // width 0 builds a cube net of that edge length, see GameState::AddRidableObject
+        message.gridHeight_ = ridable->GetGridHeight();
+        message.gridWidth = ridable->IsCubeNet() ? 0 : ridable->GetGridWidth();
+
+        // folded like a net, the client compiles it from the description
+        if (ridable->GetNet() != nullptr) {
+            message.net_ = NetCompiler::SerializeDescription(ridable->GetNet()->description);
+        }
+
+        send_(clientID, message);
+    }
+    else {
+        AddGameObjectMessage message(gameObject->GetTypeID(), objectID);
+        send_(clientID, message);
+    }
+
+    sentShells_++;
+}
+
+void SubWorldStreamer::SendGrid(uint32_t clientID, Client& client, uint32_t ridableID) {
+    RidableObject* ridable = dynamic_cast<RidableObject*>(gameState_.GetGameObject(ridableID));
+    if (ridable == nullptr) {
+        return;
+    }
+
+    ridable->GetGrid().ForEach([this, clientID, &client, ridableID](uint32_t cell, uint32_t occupantID) {
+        if (gameState_.IsValidGameObject(occupantID)) {
+            SendSlot(clientID, client, ridableID, cell, occupantID);
+        }
+    });
+}
+
+void SubWorldStreamer::SendSlot(uint32_t clientID, Client& client, uint32_t ridableID, uint32_t cell, uint32_t occupantID) {
+    if (occupantID != 0 && client.known.count(occupantID) == 0) {
+        if (gameState_.IsValidGameObject(occupantID)) {
+            SendShell(clientID, occupantID);
+            client.known.insert(occupantID);
+        }
+        else {
+            // came and went within the tick
+            occupantID = 0;
+        }
+    }
+
+    GridSlotMessage message;
+    message.ownerID = ridableID;
+    message.cell = cell;
+    message.occupantID = occupantID;
+    send_(clientID, message);
+
+    sentSlots_++;
+}
@@ -0,0 +1,539 @@
+#include "Network/WorldSnapshot.h"
+#include "Network/GameState.h"
+
+#include "Core/GameObject.h"
+#include "Core/RidableObject.h"
+#include "Core/Transform.h"
+#include "Utils/MappedFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace SnapshotFormat;
+
+std::string WorldSnapshot::GetName() const { return "WorldSnapshot"; }
+
+void WorldSnapshot::log(LogLevel level, std::string text) {
+    LOG(level, GetName() + "::" + text);
+}
+
+namespace {
+    struct PendingSection {
+        SectionKind kind;
+        uint32_t recordSize;
+        const void* data;
+        uint64_t size;
+        uint64_t count;
+    };
+
+    uint64_t AlignUp(uint64_t value) {
+        return (value + 7) & ~static_cast<uint64_t>(7);
+    }
+
+    // the entry of kind, nullptr if it is missing or doesn't fit into the file
+    const SectionEntry* FindSection(const SectionEntry* entries, uint32_t nSections, SectionKind kind, size_t fileSize) {
+        for (uint32_t i = 0; i < nSections; i++) {
+            const SectionEntry& entry = entries[i];
+
+            if (entry.kind != kind) {
+                continue;
+            }
+            if (entry.offset > fileSize || entry.size > fileSize - entry.offset) {
+                return nullptr;
+            }
+            if (entry.recordSize != 0 && entry.count * entry.recordSize != entry.size) {
+                return nullptr;
+            }
+            return &entry;
+        }
+        return nullptr;
+    }
+}
+
+WorldSnapshot::~WorldSnapshot() {
+    WaitForSave();
+}
+
+std::vector<uint8_t> WorldSnapshot::Capture(GameState& gameState) {
+    // slot map
+    uint32_t nSlots = gameState.gameObjects.SlotCount();
+    std::vector<SlotRecord> slots(nSlots);
+
+    for (uint32_t i = 0; i < nSlots; i++) {
+        auto state = gameState.gameObjects.GetSlotState(i);
+        slots[i] = { state.generation, state.occupied, state.retired, 0 };
+    }
+
+    std::vector<uint32_t> freeList = gameState.gameObjects.GetFreeList();
+
+    // objects and their grids
+    std::vector<ObjectRecord> objects;
+    std::vector<GridCellRecord> gridCells;
+    std::vector<NetRecord> nets;
+    std::vector<uint8_t> netBytes;
+    objects.reserve(gameState.gameObjects.Size());
+
+    gameState.gameObjects.ForEach([&](uint32_t id, std::unique_ptr<GameObject>& gameObject) {
+        if (gameObject == nullptr) {
+            // reserved, nothing there yet
+            return;
+        }
+
+        ObjectRecord record = {};
+        record.objectID = id;
+        record.parentID = gameObject->GetParentID();
+        record.meshID = gameObject->meshID_;
+        record.textureID = gameObject->textureID_;
+        record.typeID = gameObject->GetTypeID();
+
+        const Transform* transform = gameObject->ptrNodeTransform_;
+        glm::vec3 translation = transform->GetTranslation();
+        glm::quat rotation = transform->GetRotationQuat();
+        glm::vec3 scale = transform->GetScale();
+
+        for (int axis = 0; axis < 3; axis++) {
+            record.translation[axis] = translation[axis];
+            record.scale[axis] = scale[axis];
+        }
+        record.rotation[0] = rotation.w;
+        record.rotation[1] = rotation.x;
+        record.rotation[2] = rotation.y;
+        record.rotation[3] = rotation.z;
+
+        if (RidableObject* ridable = dynamic_cast<RidableObject*>(gameObject.get())) {
+            record.flags |= IS_RIDABLE;
+            if (ridable->IsCubeNet()) {
+                record.flags |= IS_CUBE_NET;
+            }
+            if (ridable->GetNet() != nullptr) {
+                record.flags |= IS_NET;
+
+                std::vector<uint8_t> description = NetCompiler::SerializeDescription(ridable->GetNet()->description);
+                nets.push_back({ id, static_cast<uint32_t>(netBytes.size()), static_cast<uint32_t>(description.size()), 0 });
+                netBytes.insert(netBytes.end(), description.begin(), description.end());
+            }
+            record.gridHeight = ridable->GetGridHeight();
+            record.gridWidth = ridable->GetGridWidth();
+            record.gridOffset = static_cast<uint32_t>(gridCells.size());
+
+            ridable->GetGrid().ForEach([&gridCells](uint32_t cell, uint32_t occupantID) {
+                gridCells.push_back({ cell, occupantID });
+                });
+            record.gridCount = static_cast<uint32_t>(gridCells.size()) - record.gridOffset;
+        }
+
+        objects.push_back(record);
+        });
+
+    // world grids. every cell that is not empty in one of them, merged into one record per cell
+    WorldRecord world = { gameState.gridHeight, gameState.gridWidth };
+    const uint32_t GRASS = static_cast<uint32_t>(GroundType::GRASS);
+
+    std::vector<WorldCellRecord> worldCells;
+    gameState.droppedItemGrid.ForEach([&worldCells, GRASS](uint32_t cell, uint32_t id) {
+        worldCells.push_back({ cell, id, 0, GRASS });
+        });
+    gameState.structureGrid.ForEach([&worldCells, GRASS](uint32_t cell, uint32_t id) {
+        worldCells.push_back({ cell, 0, id, GRASS });
+        });
+    gameState.groundTypeGrid.ForEach([&worldCells](uint32_t cell, GroundType groundType) {
+        worldCells.push_back({ cell, 0, 0, static_cast<uint32_t>(groundType) });
+        });
+
+    std::stable_sort(worldCells.begin(), worldCells.end(), [](const WorldCellRecord& a, const WorldCellRecord& b) {
+        return a.cell < b.cell;
+        });
+
+    size_t nWorldCells = 0;
+    for (size_t i = 0; i < worldCells.size(); i++) {
+        if (nWorldCells > 0 && worldCells[nWorldCells - 1].cell == worldCells[i].cell) {
+            WorldCellRecord& merged = worldCells[nWorldCells - 1];
+            merged.droppedItem |= worldCells[i].droppedItem;
+            merged.structure |= worldCells[i].structure;
+            merged.groundType = worldCells[i].groundType != GRASS ? worldCells[i].groundType : merged.groundType;
+            continue;
+        }
+        worldCells[nWorldCells++] = worldCells[i];
+    }
+    worldCells.resize(nWorldCells);
+
+    std::vector<PortalRecord> portals;
+    portals.reserve(gameState.portalGraph_.GetCount());
+    for (const Portal& portal : gameState.portalGraph_.GetPortals()) {
+        portals.push_back({ portal.fromGridID, portal.fromCell, portal.toGridID, portal.toCell, portal.rotation, {} });
+    }
+
+    PendingSection sections[] = {
+        { SectionKind::SLOTS, sizeof(SlotRecord), slots.data(), slots.size() * sizeof(SlotRecord), slots.size() },
+        { SectionKind::FREE_LIST, sizeof(uint32_t), freeList.data(), freeList.size() * sizeof(uint32_t), freeList.size() },
+        { SectionKind::OBJECTS, sizeof(ObjectRecord), objects.data(), objects.size() * sizeof(ObjectRecord), objects.size() },
+        { SectionKind::GRID_CELLS, sizeof(GridCellRecord), gridCells.data(), gridCells.size() * sizeof(GridCellRecord), gridCells.size() },
+        { SectionKind::WORLD, sizeof(WorldRecord), &world, sizeof(WorldRecord), 1 },
+        { SectionKind::WORLD_CELLS, sizeof(WorldCellRecord), worldCells.data(), worldCells.size() * sizeof(WorldCellRecord), worldCells.size() },
+        { SectionKind::PORTALS, sizeof(PortalRecord), portals.data(), portals.size() * sizeof(PortalRecord), portals.size() },
+        { SectionKind::NETS, sizeof(NetRecord), nets.data(), nets.size() * sizeof(NetRecord), nets.size() },
+        { SectionKind::NET_BYTES, 1, netBytes.data(), netBytes.size(), netBytes.size() },
+    };
+    const uint32_t nSections = static_cast<uint32_t>(sizeof(sections) / sizeof(sections[0]));
+
+    // layout
+    std::vector<SectionEntry> entries(nSections);
+    uint64_t cursor = AlignUp(sizeof(Header) + nSections * sizeof(SectionEntry));
+
+    for (uint32_t i = 0; i < nSections; i++) {
+        entries[i] = { sections[i].kind, sections[i].recordSize, cursor, sections[i].size, sections[i].count };
+        cursor = AlignUp(cursor + sections[i].size);
+    }
+
+    std::vector<uint8_t> bytes(cursor, 0);
+
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.nSections = nSections;
+    header.fileSize = cursor;
+
+    std::memcpy(bytes.data(), &header, sizeof(Header));
+    std::memcpy(bytes.data() + sizeof(Header), entries.data(), nSections * sizeof(SectionEntry));
+
+    for (uint32_t i = 0; i < nSections; i++) {
+        if (sections[i].size > 0) {
+            std::memcpy(bytes.data() + entries[i].offset, sections[i].data, sections[i].size);
+        }
+    }
+
+    return bytes;
+}
+
+bool WorldSnapshot::Restore(GameState& gameState, const uint8_t* data, size_t size) {
+    if (size < sizeof(Header)) {
+        LOG(LOG_ERROR, "WorldSnapshot::Restore file too small");
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        LOG(LOG_ERROR, "WorldSnapshot::Restore not a snapshot");
+        return false;
+    }
+    if (header.version != VERSION) {
+        LOG(LOG_ERROR, "WorldSnapshot::Restore version " + std::to_string(header.version) + " is not supported, expected " + std::to_string(VERSION));
+        return false;
+    }
+    if (header.fileSize != size || sizeof(Header) + static_cast<uint64_t>(header.nSections) * sizeof(SectionEntry) > size) {
+        LOG(LOG_ERROR, "WorldSnapshot::Restore file is truncated");
+        return false;
+    }
+
+    // everything below is read in place, the sections are 8 byte aligned in the mapping
+    const SectionEntry* entries = reinterpret_cast<const SectionEntry*>(data + sizeof(Header));
+
+    const SectionEntry* slotSection = FindSection(entries, header.nSections, SectionKind::SLOTS, size);
+    const SectionEntry* freeSection = FindSection(entries, header.nSections, SectionKind::FREE_LIST, size);
+    const SectionEntry* objectSection = FindSection(entries, header.nSections, SectionKind::OBJECTS, size);
+    const SectionEntry* cellSection = FindSection(entries, header.nSections, SectionKind::GRID_CELLS, size);
+    const SectionEntry* worldSection = FindSection(entries, header.nSections, SectionKind::WORLD, size);
+    const SectionEntry* worldCellSection = FindSection(entries, header.nSections, SectionKind::WORLD_CELLS, size);
+    const SectionEntry* portalSection = FindSection(entries, header.nSections, SectionKind::PORTALS, size);
+    const SectionEntry* netSection = FindSection(entries, header.nSections, SectionKind::NETS, size);
+    const SectionEntry* netByteSection = FindSection(entries, header.nSections, SectionKind::NET_BYTES, size);
+
+    if (!slotSection || !freeSection || !objectSection || !cellSection || !worldSection || !worldCellSection || !portalSection
+        || !netSection || !netByteSection
+        || slotSection->recordSize != sizeof(SlotRecord)
+        || objectSection->recordSize != sizeof(ObjectRecord)
+        || freeSection->recordSize != sizeof(uint32_t)
+        || cellSection->recordSize != sizeof(GridCellRecord)
+        || worldSection->recordSize != sizeof(WorldRecord) || worldSection->count != 1
+        || worldCellSection->recordSize != sizeof(WorldCellRecord)
+        || portalSection->recordSize != sizeof(PortalRecord)
+        || netSection->recordSize != sizeof(NetRecord)
+        || netByteSection->recordSize != 1) {
+        LOG(LOG_ERROR, "WorldSnapshot::Restore sections are missing or damaged");
+        return false;
+    }
+
+    const SlotRecord* slots = reinterpret_cast<const SlotRecord*>(data + slotSection->offset);
+    const uint32_t* freeList = reinterpret_cast<const uint32_t*>(data + freeSection->offset);
+    const ObjectRecord* objects = reinterpret_cast<const ObjectRecord*>(data + objectSection->offset);
+    const GridCellRecord* gridCells = reinterpret_cast<const GridCellRecord*>(data + cellSection->offset);
+    const WorldRecord& worldRecord = *reinterpret_cast<const WorldRecord*>(data + worldSection->offset);
+    const WorldCellRecord* worldCells = reinterpret_cast<const WorldCellRecord*>(data + worldCellSection->offset);
+    const PortalRecord* portals = reinterpret_cast<const PortalRecord*>(data + portalSection->offset);
+    const NetRecord* netRecords = reinterpret_cast<const NetRecord*>(data + netSection->offset);
+    const uint8_t* netBytes = data + netByteSection->offset;
+
+    if (worldRecord.gridHeight < 0 || worldRecord.gridWidth < 0) {
+        LOG(LOG_ERROR, "WorldSnapshot::Restore world grids are damaged");
+        return false;
+    }
+
+    // the nets, compiled before anything is torn down. a description that doesn't compile refuses the whole file
+    std::unordered_map<uint32_t, std::shared_ptr<const CompiledNet>> netOfObject;
+    for (uint64_t i = 0; i < netSection->count; i++) {
+        const NetRecord& record = netRecords[i];
+        NetDescription description;
+
+        std::shared_ptr<const CompiledNet> net;
+        if (static_cast<uint64_t>(record.offset) + record.size <= netByteSection->size
+            && NetCompiler::DeserializeDescription(netBytes + record.offset, record.size, description)) {
+            net = gameState.GetNet(description);
+        }
+
+        if (net == nullptr) {
+            LOG(LOG_ERROR, "WorldSnapshot::Restore the net of ObjID: " + std::to_string(record.objectID) + " is damaged");
+            return false;
+        }
+        netOfObject[record.objectID] = std::move(net);
+    }
+
+    for (uint64_t i = 0; i < objectSection->count; i++) {
+        if ((objects[i].flags & IS_NET) && netOfObject.count(objects[i].objectID) == 0) {
+            LOG(LOG_ERROR, "WorldSnapshot::Restore ObjID: " + std::to_string(objects[i].objectID) + " has no net");
+            return false;
+        }
+    }
+
+    // Player objects belong to the connections of whoever ran the server when this was saved.
+    // Those clients are gone, so their players are dropped (with whatever stood on them) and the clients connected right now get new ones
+    std::vector<uint32_t> connectedClientIDs;
+    for (const auto& player : gameState.players) {
+        connectedClientIDs.push_back(player.first);
+    }
+    std::sort(connectedClientIDs.begin(), connectedClientIDs.end());
+
+    std::unordered_set<uint32_t> droppedIDs;
+    for (uint64_t i = 0; i < objectSection->count; i++) {
+        if (objects[i].typeID == PlayableObject::TYPE_ID) {
+            droppedIDs.insert(objects[i].objectID);
+        }
+    }
+
+    // out with the old world
+    gameState.portalGraph_.Clear();
+    gameState.gameObjects.Clear();
+    gameState.objectsByType.clear();
+    gameState.players.clear();
+    gameState.playableObjects.clear();
+
+    // ids come back exactly as they were, including the ones that are free and their generations
+    static_assert(sizeof(SlotRecord) == sizeof(SlotMap<std::unique_ptr<GameObject>>::SlotState), "SlotRecord has to mirror SlotState");
+    gameState.gameObjects.RestoreSlots(
+        reinterpret_cast<const SlotMap<std::unique_ptr<GameObject>>::SlotState*>(slots), static_cast<uint32_t>(slotSection->count),
+        freeList, static_cast<uint32_t>(freeSection->count));
+
+    gameState.componentStore_.Reserve(static_cast<size_t>(objectSection->count));
+
+    // pass 1: objects
+    for (uint64_t i = 0; i < objectSection->count; i++) {
+        const ObjectRecord& record = objects[i];
+        std::unique_ptr<GameObject> gameObject;
+
+        if (droppedIDs.count(record.objectID) != 0) {
+            continue;
+        }
+
+        if (record.flags & IS_RIDABLE) {
+            if (record.flags & IS_NET) {
+                gameObject = std::make_unique<RidableObject>(record.objectID, record.meshID, record.textureID, netOfObject[record.objectID]);
+            }
+            else if (record.flags & IS_CUBE_NET) {
+                gameObject = std::make_unique<RidableObject>(record.objectID, record.meshID, record.textureID, static_cast<uint8_t>(record.gridHeight));
+            }
+            else {
+                gameObject = std::make_unique<RidableObject>(record.objectID, record.meshID, record.textureID, record.gridHeight, record.gridWidth);
+            }
+        }
+        else {
+            auto factory = gameState.factoryRegistry.find(record.typeID);
+
+            if (factory != gameState.factoryRegistry.end() && factory->second != nullptr) {
+                gameObject = factory->second->Create();
+                gameObject->SetID(record.objectID);
+                gameObject->SetMeshID(record.meshID);
+                gameObject->SetTextureID(record.textureID);
+            }
+            else {
+                gameObject = std::make_unique<GameObject>(record.objectID, record.meshID, record.textureID);
+            }
+        }
+
+        // not in the store yet, this only sets the field. Add picks it up
+        gameObject->SetParentID(droppedIDs.count(record.parentID) != 0 ? 0 : record.parentID);
+
+        GameObject* inserted = gameObject.get();
+        gameState.InsertGameObject(record.objectID, std::move(gameObject), true);
+        gameState.objectsByType.insert({ record.typeID, record.objectID });
+
+        // the store built the transform in place, fill it there
+        Transform* transform = inserted->ptrNodeTransform_;
+        transform->SetTranslation(glm::vec3(record.translation[0], record.translation[1], record.translation[2]));
+        transform->SetRotationQuat(glm::quat(record.rotation[0], record.rotation[1], record.rotation[2], record.rotation[3]));
+        transform->SetScale(glm::vec3(record.scale[0], record.scale[1], record.scale[2]));
+    }
+
+    // the slots of the dropped players were restored as taken, free them. their ids are stale from here
+    for (uint32_t droppedID : droppedIDs) {
+        gameState.gameObjects.Remove(droppedID);
+    }
+
+    // pass 2: grids, now that every id standing on them exists
+    for (uint64_t i = 0; i < objectSection->count; i++) {
+        const ObjectRecord& record = objects[i];
+
+        if (!(record.flags & IS_RIDABLE)) {
+            continue;
+        }
+
+        if (static_cast<uint64_t>(record.gridOffset) + record.gridCount > cellSection->count) {
+            LOG(LOG_ERROR, "WorldSnapshot::Restore grid of ObjID: " + std::to_string(record.objectID) + " is out of range");
+            continue;
+        }
+
+        RidableObject* ridable = dynamic_cast<RidableObject*>(gameState.GetGameObject(record.objectID));
+        if (ridable == nullptr) {
+            continue;
+        }
+
+        // out of bounds cells are dropped by SetObjIdAtCell
+        const GridCellRecord* cells = gridCells + record.gridOffset;
+        for (uint32_t k = 0; k < record.gridCount; k++) {
+            if (droppedIDs.count(cells[k].objectID) == 0) {
+                ridable->SetObjIdAtCell(cells[k].cell, cells[k].objectID);
+            }
+        }
+
+        ridable->IsGridIndexConsistent();
+    }
+
+    // portals, into the graph and the MovementManagers of both grids
+    for (uint64_t i = 0; i < portalSection->count; i++) {
+        const PortalRecord& record = portals[i];
+
+        if (droppedIDs.count(record.fromGridID) != 0 || droppedIDs.count(record.toGridID) != 0) {
+            continue;
+        }
+
+        RidableObject* from = dynamic_cast<RidableObject*>(gameState.GetGameObject(record.fromGridID));
+        RidableObject* to = dynamic_cast<RidableObject*>(gameState.GetGameObject(record.toGridID));
+
+        if (from == nullptr || to == nullptr || record.fromCell >= from->GetCellCount() || record.toCell >= to->GetCellCount()) {
+            LOG(LOG_ERROR, "WorldSnapshot::Restore portal " + std::to_string(record.fromGridID) + "::" + std::to_string(record.fromCell) + " is damaged");
+            continue;
+        }
+
+        gameState.LinkPortal(from, record.fromCell, to, record.toCell, record.rotation & 3);
+    }
+
+    // world grids
+    gameState.gridHeight = worldRecord.gridHeight;
+    gameState.gridWidth = worldRecord.gridWidth;
+    gameState.droppedItemGrid.Reset(worldRecord.gridHeight, worldRecord.gridWidth, 0);
+    gameState.structureGrid.Reset(worldRecord.gridHeight, worldRecord.gridWidth, 0);
+    gameState.groundTypeGrid.Reset(worldRecord.gridHeight, worldRecord.gridWidth, GroundType::GRASS);
+
+    for (uint64_t i = 0; i < worldCellSection->count; i++) {
+        const WorldCellRecord& record = worldCells[i];
+
+        gameState.droppedItemGrid.Set(record.cell, record.droppedItem);
+        gameState.structureGrid.Set(record.cell, record.structure);
+        gameState.groundTypeGrid.Set(record.cell, record.groundType < static_cast<uint32_t>(GroundType::LAST) ? static_cast<GroundType>(record.groundType) : GroundType::GRASS);
+    }
+
+    // loading is not news to anybody
+    gameState.changeJournal_.Clear();
+
+    for (uint32_t clientID : connectedClientIDs) {
+        gameState.CreateAndRegisterPlayerObject(clientID);
+    }
+
+    return true;
+}
+
+bool WorldSnapshot::SaveAsync(GameState& gameState, const std::string& path) {
+    if (saving_.load()) {
+        log(LOG_WARNING, "Previous save is still being written, skipping");
+        return false;
+    }
+
+    // the previous writer is done, but still has to be joined
+    WaitForSave();
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint8_t> bytes = Capture(gameState);
+    auto captured = std::chrono::steady_clock::now();
+
+    log(LOG_INFO, "Captured " + std::to_string(bytes.size() / 1024) + "KB in "
+        + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(captured - start).count()) + "us");
+
+    saving_.store(true);
+    writer_ = std::thread([this, path, bytes = std::move(bytes)]() {
+        if (!WriteFileAtomically(path, bytes)) {
+            LOG(LOG_ERROR, "WorldSnapshot::Failed to write " + path);
+        }
+        saving_.store(false);
+        });
+
+    return true;
+}
+
+void WorldSnapshot::WaitForSave() {
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+}
+
+bool WorldSnapshot::Load(GameState& gameState, const std::string& path) {
+    auto start = std::chrono::steady_clock::now();
+
+    MappedFile file;
+    if (!file.Open(path)) {
+        log(LOG_INFO, "No snapshot at " + path);
+        return false;
+    }
+
+    if (!Restore(gameState, file.GetData(), file.GetSize())) {
+        return false;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    log(LOG_INFO, "Loaded " + std::to_string(gameState.componentStore_.Size()) + " objects from " + path + " in "
+        + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()) + "ms");
+
+    return true;
+}
+
+bool WorldSnapshot::WriteFileAtomically(const std::string& path, const std::vector<uint8_t>& bytes) {
+    std::string tempPath = path + ".tmp";
+
+    FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    written = (std::fflush(file) == 0) && written;
+    written = (std::fclose(file) == 0) && written;
+
+    if (!written) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    // replaces the old snapshot in one step, readers see either the old or the new file
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+
+    if (error) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
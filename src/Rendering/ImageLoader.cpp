@@ -1,3 +1,3 @@
-// ImageLoader.cpp
-#define STB_IMAGE_IMPLEMENTATION
+// ImageLoader.cpp
+#define STB_IMAGE_IMPLEMENTATION
 #include "ThirdParty/stb_image.h"
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "Rendering/TransformHierarchy.h"
+
+#include <algorithm>
+#include <sstream>
+
+std::string TransformHierarchy::GetName() const { return "TransformHierarchy"; }
+
+void TransformHierarchy::log(LogLevel level, std::string text) {
+    LOG(level, GetName() + "::" + text);
+}
+
+void TransformHierarchy::Update(const RenderView& view, uint32_t rootRow, uint8_t descendDepth) {
+    uint32_t rootID = view.objectIDs[rootRow];
+    updates_++;
+
+    // nothing new was simulated since the last frame
+    if (hasBuilt_ && view.tick == builtTick_ && rootID == builtRootID_ && descendDepth == builtDepth_) {
+        skippedUpdates_++;
+        return;
+    }
+
+    nodes_.swap(previousNodes_);
+    childCells_.swap(previousChildCells_);
+    childOfCell_.swap(previousChildOfCell_);
+    nodes_.clear();
+    childCells_.clear();
+    childOfCell_.clear();
+
+    uint32_t previousRoot = (hasBuilt_ && !previousNodes_.empty() && previousNodes_[0].objectID == rootID) ? 0 : NO_NODE;
+
+    lineage_.assign(descendDepth + 1, 0);
+    stack_.clear();
+    stack_.push_back({ rootRow, NO_NODE, 0, 0, NO_NODE, 0, previousRoot });
+
+    recomputed_ = 0;
+
+    while (!stack_.empty()) {
+        Pending pending = stack_.back();
+        stack_.pop_back();
+
+        uint32_t index = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+        Node& node = nodes_.back();
+
+        node.objectID = view.objectIDs[pending.row];
+        node.meshID = view.meshIDs[pending.row];
+        node.textureID = view.textureIDs[pending.row];
+        node.parent = pending.parent;
+        node.cell = pending.cell;
+        node.depth = pending.depth;
+        node.childBase = NO_NODE;
+        node.cellCount = 0;
+
+        node.localMatrix = view.localMatrices[pending.row];
+        node.cellMatrix = pending.cellMatrixIndex != NO_NODE ? view.cellMatrices[pending.cellMatrixIndex] : glm::mat4(1);
+
+        bool parentChanged = false;
+        if (pending.parent != NO_NODE) {
+            childOfCell_[nodes_[pending.parent].childBase + pending.entry] = index;
+            parentChanged = nodes_[pending.parent].changed;
+        }
+
+        const Node* previous = pending.previous != NO_NODE ? &previousNodes_[pending.previous] : nullptr;
+
+        if (previous != nullptr && !parentChanged
+            && previous->localMatrix == node.localMatrix && previous->cellMatrix == node.cellMatrix) {
+            node.worldMatrix = previous->worldMatrix;
+            node.changed = false;
+        }
+        else {
+            // parentTransformation * currGridTransform * ptrNodeTransformation -> current Transformation 
+            node.worldMatrix = pending.parent != NO_NODE
+                ? nodes_[pending.parent].worldMatrix * node.cellMatrix * node.localMatrix
+                : node.localMatrix;
+            node.changed = true;
+            recomputed_++;
+        }
+
+        // depth first, so lineage_[0..depth] is always the chain down to this one
+        lineage_[node.depth] = node.objectID;
+
+        uint32_t cellCount = view.cellCount[pending.row];
+        if (node.depth >= descendDepth || cellCount == 0) {
+            continue;
+        }
+
+        node.childBase = static_cast<uint32_t>(childOfCell_.size());
+        node.cellCount = cellCount;
+        childOfCell_.resize(childOfCell_.size() + cellCount, NO_NODE);
+
+        uint32_t cellBegin = view.cellBegin[pending.row];
+        childCells_.insert(childCells_.end(), view.cellIndices.begin() + cellBegin, view.cellIndices.begin() + cellBegin + cellCount);
+
+        auto lineageEnd = lineage_.begin() + node.depth + 1;
+
+        for (uint32_t entry = 0; entry < cellCount; entry++) {
+            uint32_t cell = view.cellIndices[cellBegin + entry];
+            uint32_t childID = view.cellObjectIDs[cellBegin + entry];
+
+            if (childID == 0) {
+                // empty spot
+                continue;
+            }
+
+            if (std::find(lineage_.begin(), lineageEnd, childID) != lineageEnd) {
+                // if we find the child already in the lineage
+                // to do: not implemented yet
+                continue;
+            }
+
+            uint32_t childRow = view.RowOf(childID);
+            if (childRow == RenderView::NO_ROW) {
+                continue;
+            }
+
+            uint32_t previousChild = pending.previous != NO_NODE ? MatchPrevious(pending.previous, cell, childID) : NO_NODE;
+
+            stack_.push_back({ childRow, index, cell, entry, cellBegin + entry, static_cast<uint8_t>(node.depth + 1), previousChild });
+        }
+    }
+
+    hasBuilt_ = true;
+    builtTick_ = view.tick;
+    builtRootID_ = rootID;
+    builtDepth_ = descendDepth;
+
+    totalNodes_ += nodes_.size();
+    totalRecomputed_ += recomputed_;
+}
+
+uint32_t TransformHierarchy::MatchPrevious(uint32_t previousParent, uint32_t cell, uint32_t objectID) const {
+    const Node& parent = previousNodes_[previousParent];
+
+    if (parent.childBase == NO_NODE) {
+        return NO_NODE;
+    }
+
+    // the cells of a range are ascending
+    auto begin = previousChildCells_.begin() + parent.childBase;
+    auto end = begin + parent.cellCount;
+    auto it = std::lower_bound(begin, end, cell);
+
+    if (it == end || *it != cell) {
+        return NO_NODE;
+    }
+
+    uint32_t previous = previousChildOfCell_[it - previousChildCells_.begin()];
+    if (previous == NO_NODE || previousNodes_[previous].objectID != objectID) {
+        return NO_NODE;
+    }
+    return previous;
+}
+
+void TransformHierarchy::LogStats() {
+    std::stringstream ss;
+    ss << updates_ << " updates, " << skippedUpdates_ << " skipped (same tick)";
+
+    uint64_t rebuilt = updates_ - skippedUpdates_;
+    if (rebuilt > 0) {
+        ss << ", " << (totalNodes_ / rebuilt) << " nodes and " << (totalRecomputed_ / rebuilt) << " world matrices recomputed per rebuild";
+    }
+
+    log(LOG_INFO, ss.str());
+}
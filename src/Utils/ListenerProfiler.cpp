@@ -0,0 +1,206 @@
+#include "Utils/ListenerProfiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+// LatencyHistogram -------------------------------------------------------
+
+int LatencyHistogram::BucketOf(uint64_t nanoseconds) {
+    if (nanoseconds < SUB_BUCKETS) {
+        // tiny values get a bucket of their own
+        return static_cast<int>(nanoseconds);
+    }
+
+    // index of the highest set bit
+    int msb = 63;
+    while ((nanoseconds >> msb) == 0) {
+        msb--;
+    }
+
+    // the bits right below the highest one pick the sub bucket
+    int sub = static_cast<int>((nanoseconds >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+
+    return (msb - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t LatencyHistogram::UpperBoundOf(int bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return static_cast<uint64_t>(bucket);
+    }
+
+    int msb = bucket / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    uint64_t sub = static_cast<uint64_t>(bucket % SUB_BUCKETS);
+
+    uint64_t lower = (uint64_t(1) << msb) + (sub << (msb - SUB_BUCKET_BITS));
+    return lower + (uint64_t(1) << (msb - SUB_BUCKET_BITS)) - 1;
+}
+
+void LatencyHistogram::Record(uint64_t nanoseconds) {
+    int bucket = std::min(BucketOf(nanoseconds), N_BUCKETS - 1);
+
+    buckets_[bucket]++;
+    count_++;
+    total_ += nanoseconds;
+    max_ = std::max(max_, nanoseconds);
+}
+
+uint64_t LatencyHistogram::Percentile(double p) const {
+    if (count_ == 0) {
+        return 0;
+    }
+
+    uint64_t rank = static_cast<uint64_t>(p * static_cast<double>(count_ - 1)) + 1;
+    uint64_t seen = 0;
+
+    for (int i = 0; i < N_BUCKETS; i++) {
+        seen += buckets_[i];
+
+        if (seen >= rank) {
+            // never report more than what was actually measured
+            return std::min(UpperBoundOf(i), max_);
+        }
+    }
+
+    return max_;
+}
+
+void LatencyHistogram::Reset() {
+    buckets_.fill(0);
+    count_ = 0;
+    max_ = 0;
+    total_ = 0;
+}
+
+// ListenerProfiler -------------------------------------------------------
+
+std::string ListenerProfiler::GetName() const { return "ListenerProfiler"; }
+
+void ListenerProfiler::log(LogLevel level, std::string text) {
+    LOG(level, GetName() + "::" + text);
+}
+
+ListenerProfiler& ListenerProfiler::GetInstance() {
+    static ListenerProfiler instance;
+    return instance;
+}
+
+ListenerProfiler::ListenerProfiler()
+    : origin_(std::chrono::steady_clock::now()) {}
+
+ListenerStats* ListenerProfiler::Register(const std::string& name) {
+    for (const auto& stats : stats_) {
+        if (stats->name == name) {
+            return stats.get();
+        }
+    }
+
+    stats_.push_back(std::make_unique<ListenerStats>());
+    stats_.back()->name = name;
+
+    return stats_.back().get();
+}
+
+uint64_t ListenerProfiler::NowNs() const {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin_).count());
+}
+
+void ListenerProfiler::Record(ListenerStats* stats, uint64_t startNs, uint64_t endNs) {
+    uint64_t duration = endNs - startNs;
+
+    stats->histogram.Record(duration);
+
+    ListenerStats::Sample& sample = stats->recentSamples[stats->nextSample];
+    sample.startNs = startNs;
+    sample.durationNs = duration;
+
+    stats->nextSample = (stats->nextSample + 1) % ListenerStats::N_RECENT_SAMPLES;
+}
+
+void ListenerProfiler::Dump() {
+    // slowest first, that is what we are looking for
+    std::vector<ListenerStats*> sorted;
+    for (const auto& stats : stats_) {
+        sorted.push_back(stats.get());
+    }
+
+    std::sort(sorted.begin(), sorted.end(), [](const ListenerStats* a, const ListenerStats* b) {
+        return a->histogram.GetMax() > b->histogram.GetMax();
+        });
+
+    std::stringstream ss;
+    ss << "Listener latencies (us)\n";
+    ss << std::left << std::setw(56) << "  name"
+        << std::right << std::setw(10) << "calls"
+        << std::setw(10) << "p50"
+        << std::setw(10) << "p99"
+        << std::setw(10) << "max"
+        << std::setw(12) << "total" << "\n";
+
+    ss << std::fixed << std::setprecision(1);
+    for (const ListenerStats* stats : sorted) {
+        const LatencyHistogram& histogram = stats->histogram;
+
+        ss << std::left << std::setw(56) << ("  " + stats->name)
+            << std::right << std::setw(10) << histogram.GetCount()
+            << std::setw(10) << histogram.Percentile(0.50) / 1000.0
+            << std::setw(10) << histogram.Percentile(0.99) / 1000.0
+            << std::setw(10) << histogram.GetMax() / 1000.0
+            << std::setw(12) << histogram.GetTotal() / 1000.0 << "\n";
+    }
+
+    log(LOG_INFO, ss.str());
+}
+
+bool ListenerProfiler::ExportTrace(const std::string& path) {
+    std::ofstream file(path);
+
+    if (!file.is_open()) {
+        log(LOG_ERROR, "Could not open trace file: " + path);
+        return false;
+    }
+
+    // Chrome trace event format
+    // one 'X' (complete) event per recent call, one track per listener
+    file << "{\"traceEvents\":[\n";
+
+    bool first = true;
+    for (size_t track = 0; track < stats_.size(); track++) {
+        const ListenerStats* stats = stats_[track].get();
+        const LatencyHistogram& histogram = stats->histogram;
+
+        file << (first ? "" : ",\n");
+        first = false;
+
+        // name the track and attach the summary to it
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << track
+            << ",\"args\":{\"name\":\"" << stats->name << "\""
+            << ",\"calls\":" << histogram.GetCount()
+            << ",\"p50_ns\":" << histogram.Percentile(0.50)
+            << ",\"p99_ns\":" << histogram.Percentile(0.99)
+            << ",\"max_ns\":" << histogram.GetMax() << "}}";
+
+        size_t nSamples = std::min<uint64_t>(histogram.GetCount(), ListenerStats::N_RECENT_SAMPLES);
+        for (size_t i = 0; i < nSamples; i++) {
+            const ListenerStats::Sample& sample = stats->recentSamples[i];
+
+            file << ",\n{\"name\":\"" << stats->name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << track
+                << ",\"ts\":" << sample.startNs / 1000.0
+                << ",\"dur\":" << sample.durationNs / 1000.0 << "}";
+        }
+    }
+
+    file << "\n]}\n";
+
+    log(LOG_INFO, "Exported listener trace to: " + path);
+    return true;
+}
+
+void ListenerProfiler::Reset() {
+    for (const auto& stats : stats_) {
+        stats->histogram.Reset();
+        stats->nextSample = 0;
+    }
+}